@@ -14,8 +14,18 @@
  */
 
 #include "common/Threading.h"
+#include "common/PersistentThread.h"
 #include "common/TraceLog.h"
 #include "common/RedtapeWindows.h"    // OutputDebugString
+#include "common/boost_spsc_queue.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace Threading;
 
@@ -252,6 +262,621 @@ const IConsoleWriter ConsoleWriter_Assert = {
     0,    // instance-level indentation (should always be 0)
 };
 
+// --------------------------------------------------------------------------------------
+//  Deferred log
+// --------------------------------------------------------------------------------------
+// Formatting a log line costs far more than the emulation work around most log calls, and the
+// output itself can block.  While deferred logging is enabled, char* writes only copy the format
+// pointer and their raw arguments into a ring owned by the calling thread.  A background thread
+// collects the rings in order, formats, folds repeated lines and rate limits the output.  Format
+// strings are expected to be literals (which they are everywhere in the codebase); anything the
+// background thread couldn't reproduce (wide formats, %n, unknown conversions, argument overflow)
+// is formatted by the caller and queued as text so per-thread ordering is kept.
+
+static const uint DeferredLogArgSpace       = 200;
+static const uint DeferredLogRingSize       = 512;
+static const uint DeferredLogMaxLinesPerSec = 1000;
+
+struct DeferredLogRecord
+{
+    u64 seq;
+    void(__concall *DoWriteLn)(const wxString &fmt);
+    void(__concall *DoSetColor)(ConsoleColors color);
+    const char   *fmt;     // nullptr if the message was formatted by the caller
+    wxString     *text;    // owned by the record, released by the log thread
+    ConsoleColors color;
+    s16           indent;
+    u16           argsize;
+    u8            args[DeferredLogArgSpace];
+};
+
+struct DeferredLogRing
+{
+    ringbuffer_base<DeferredLogRecord, DeferredLogRingSize> queue;
+    std::atomic<bool>                                       orphaned{false};
+    std::atomic<u32>                                        dropped{0};
+    std::atomic<u64>                                        publishing{~0ULL};    // lower bound of a seq not pushed yet
+};
+
+// The ring outlives its thread until the log thread has drained it
+struct DeferredLogRingOwner
+{
+    DeferredLogRing *ring = nullptr;
+    ~DeferredLogRingOwner()
+    {
+        if (ring)
+            ring->orphaned.store(true, std::memory_order_release);
+    }
+};
+
+static thread_local DeferredLogRingOwner s_logThreadRing;
+static std::vector<DeferredLogRing *>    s_logRings;
+static std::mutex                        s_logRingsMutex;
+static std::atomic<u64>                  s_logSeq{0};
+static std::atomic<bool>                 s_logDeferred{false};
+static std::thread                       s_logThread;
+static std::mutex                        s_logWakeMutex;
+static std::condition_variable           s_logWake;
+static bool                              s_logQuit = false;
+static std::condition_variable           s_logWritten;
+static u64                               s_logWrittenSeq = 0;     // every record below this one is written
+static bool                              s_logThreadDone = false; // guarded by s_logWakeMutex
+static bool                              s_logFlush      = false; // an error is waiting, guarded by s_logWakeMutex
+
+template <typename T>
+static __fi bool PutLogArg(u8 *&pos, const u8 *end, T value)
+{
+    if (pos + sizeof(T) > end)
+        return false;
+    memcpy(pos, &value, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+template <typename T>
+static __fi T GetLogArg(const u8 *&pos)
+{
+    T value;
+    memcpy(&value, pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+}
+
+static __fi const char *SkipLogDigits(const char *p)
+{
+    while (*p >= '0' && *p <= '9')
+        ++p;
+    return p;
+}
+
+enum DeferredLogLength
+{
+    LogLen_None,
+    LogLen_hh,
+    LogLen_h,
+    LogLen_l,
+    LogLen_ll,
+    LogLen_z,
+    LogLen_j,
+    LogLen_t,
+    LogLen_L,
+};
+
+static const char *ParseLogLength(const char *p, DeferredLogLength &len)
+{
+    switch (*p) {
+        case 'h':
+            len = (p[1] == 'h') ? LogLen_hh : LogLen_h;
+            return p + ((len == LogLen_hh) ? 2 : 1);
+        case 'l':
+            len = (p[1] == 'l') ? LogLen_ll : LogLen_l;
+            return p + ((len == LogLen_ll) ? 2 : 1);
+        case 'q':
+            len = LogLen_ll;
+            return p + 1;
+        case 'z':
+            len = LogLen_z;
+            return p + 1;
+        case 'j':
+            len = LogLen_j;
+            return p + 1;
+        case 't':
+            len = LogLen_t;
+            return p + 1;
+        case 'L':
+            len = LogLen_L;
+            return p + 1;
+        default:
+            len = LogLen_None;
+            return p;
+    }
+}
+
+// Integers are narrowed to their declared type here, so the log thread can print all of them as long long
+static bool CaptureLogInt(u8 *&pos, const u8 *end, char conv, DeferredLogLength len, va_list &args)
+{
+    const bool isSigned = (conv == 'd' || conv == 'i');
+    switch (len) {
+        case LogLen_hh:
+            return isSigned ? PutLogArg<s64>(pos, end, (signed char)va_arg(args, int))
+                            : PutLogArg<u64>(pos, end, (unsigned char)va_arg(args, int));
+        case LogLen_h:
+            return isSigned ? PutLogArg<s64>(pos, end, (short)va_arg(args, int))
+                            : PutLogArg<u64>(pos, end, (unsigned short)va_arg(args, int));
+        case LogLen_l:
+            return isSigned ? PutLogArg<s64>(pos, end, va_arg(args, long))
+                            : PutLogArg<u64>(pos, end, va_arg(args, unsigned long));
+        case LogLen_ll:
+            return isSigned ? PutLogArg<s64>(pos, end, va_arg(args, long long))
+                            : PutLogArg<u64>(pos, end, va_arg(args, unsigned long long));
+        case LogLen_z:
+            return PutLogArg<u64>(pos, end, va_arg(args, size_t));
+        case LogLen_j:
+            return isSigned ? PutLogArg<s64>(pos, end, va_arg(args, intmax_t))
+                            : PutLogArg<u64>(pos, end, va_arg(args, uintmax_t));
+        case LogLen_t:
+            return PutLogArg<s64>(pos, end, va_arg(args, ptrdiff_t));
+        case LogLen_None:
+            return isSigned ? PutLogArg<s64>(pos, end, va_arg(args, int))
+                            : PutLogArg<u64>(pos, end, va_arg(args, unsigned int));
+        default:
+            return false;
+    }
+}
+
+static bool CaptureLogArgs(DeferredLogRecord &rec, const char *fmt, va_list &args)
+{
+    u8       *pos = rec.args;
+    const u8 *end = rec.args + sizeof(rec.args);
+
+    for (const char *p = fmt; *p; ++p) {
+        if (*p != '%')
+            continue;
+        ++p;
+        if (*p == '%')
+            continue;
+
+        while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0')
+            ++p;
+        if (*p == '*') {
+            if (!PutLogArg<int>(pos, end, va_arg(args, int)))
+                return false;
+            ++p;
+        } else
+            p = SkipLogDigits(p);
+        if (*p == '.') {
+            ++p;
+            if (*p == '*') {
+                if (!PutLogArg<int>(pos, end, va_arg(args, int)))
+                    return false;
+                ++p;
+            } else
+                p = SkipLogDigits(p);
+        }
+
+        DeferredLogLength len;
+        p = ParseLogLength(p, len);
+
+        bool ok;
+        switch (*p) {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+                ok = CaptureLogInt(pos, end, *p, len, args);
+                break;
+            case 'c':
+                ok = (len == LogLen_None) && PutLogArg<int>(pos, end, va_arg(args, int));
+                break;
+            case 'e':
+            case 'E':
+            case 'f':
+            case 'F':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                ok = PutLogArg<double>(pos, end, (len == LogLen_L) ? (double)va_arg(args, long double)
+                                                                   : va_arg(args, double));
+                break;
+            case 'p':
+                ok = PutLogArg<void *>(pos, end, va_arg(args, void *));
+                break;
+            case 's': {
+                // strings are copied, they rarely outlive the call
+                if (len != LogLen_None)
+                    return false;
+                const char  *str    = va_arg(args, const char *);
+                const char  *src    = str ? str : "(null)";
+                const size_t length = strnlen(src, DeferredLogArgSpace);
+                ok                  = PutLogArg<u16>(pos, end, (u16)length) && (pos + length <= end);
+                if (ok) {
+                    memcpy(pos, src, length);
+                    pos += length;
+                }
+                break;
+            }
+            default:
+                // %n, wide strings, platform specific modifiers or a stray % at the end
+                return false;
+        }
+        if (!ok)
+            return false;
+    }
+
+    rec.argsize = (u16)(pos - rec.args);
+    return true;
+}
+
+// Runs on the log thread, fmt went through CaptureLogArgs() so it is known to be well formed
+static std::string FormatLogRecord(const DeferredLogRecord &rec)
+{
+    std::string out;
+    const u8   *pos = rec.args;
+    char        spec[64];
+    char        buf[512];
+
+    for (const char *p = rec.fmt; *p; ++p) {
+        if (*p != '%') {
+            out += *p;
+            continue;
+        }
+        ++p;
+        if (*p == '%') {
+            out += '%';
+            continue;
+        }
+
+        uint specLen    = 0;
+        spec[specLen++] = '%';
+        while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0')
+            spec[specLen++] = *p++;
+        if (*p == '*') {
+            specLen += snprintf(&spec[specLen], sizeof(spec) - specLen - 8, "%d", GetLogArg<int>(pos));
+            ++p;
+        } else {
+            const char *digits = p;
+            p                  = SkipLogDigits(p);
+            for (; digits < p && specLen < sizeof(spec) - 24; ++digits)
+                spec[specLen++] = *digits;
+        }
+        if (*p == '.') {
+            spec[specLen++] = *p++;
+            if (*p == '*') {
+                specLen += snprintf(&spec[specLen], sizeof(spec) - specLen - 8, "%d", GetLogArg<int>(pos));
+                ++p;
+            } else {
+                const char *digits = p;
+                p                  = SkipLogDigits(p);
+                for (; digits < p && specLen < sizeof(spec) - 8; ++digits)
+                    spec[specLen++] = *digits;
+            }
+        }
+
+        DeferredLogLength len;
+        p = ParseLogLength(p, len);
+
+        int written = 0;
+        switch (*p) {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+                spec[specLen++] = 'l';
+                spec[specLen++] = 'l';
+                spec[specLen++] = *p;
+                spec[specLen]   = 0;
+                if (*p == 'd' || *p == 'i' || len == LogLen_t)
+                    written = snprintf(buf, sizeof(buf), spec, (long long)GetLogArg<s64>(pos));
+                else
+                    written = snprintf(buf, sizeof(buf), spec, (unsigned long long)GetLogArg<u64>(pos));
+                break;
+            case 'c':
+                spec[specLen++] = 'c';
+                spec[specLen]   = 0;
+                written         = snprintf(buf, sizeof(buf), spec, GetLogArg<int>(pos));
+                break;
+            case 'p':
+                spec[specLen++] = 'p';
+                spec[specLen]   = 0;
+                written         = snprintf(buf, sizeof(buf), spec, GetLogArg<void *>(pos));
+                break;
+            case 's': {
+                const u16         length = GetLogArg<u16>(pos);
+                const std::string str((const char *)pos, length);
+                pos += length;
+                spec[specLen++] = 's';
+                spec[specLen]   = 0;
+                written         = snprintf(buf, sizeof(buf), spec, str.c_str());
+                break;
+            }
+            default:
+                spec[specLen++] = *p;
+                spec[specLen]   = 0;
+                written         = snprintf(buf, sizeof(buf), spec, GetLogArg<double>(pos));
+                break;
+        }
+        if (written > 0)
+            out.append(buf, std::min<size_t>(written, sizeof(buf) - 1));
+    }
+
+    return out;
+}
+
+static wxString IndentLogText(const wxString &src, int indent)
+{
+    if (indent <= 0)
+        return src;
+
+    wxString       result(src);
+    const wxString indentStr(L'\t', indent);
+    result.Replace(L"\n", L"\n" + indentStr);
+    return indentStr + result;
+}
+
+static DeferredLogRing *GetThreadLogRing()
+{
+    if (!s_logThreadRing.ring) {
+        s_logThreadRing.ring = new DeferredLogRing();
+        std::lock_guard lock(s_logRingsMutex);
+        s_logRings.push_back(s_logThreadRing.ring);
+    }
+    return s_logThreadRing.ring;
+}
+
+static void PushLogRecord(DeferredLogRecord &rec)
+{
+    DeferredLogRing *ring = GetThreadLogRing();
+    // The log thread writes nothing from this seq on until the record is in the ring, see DeferredLogThread
+    ring->publishing.store(s_logSeq.load());
+    rec.seq           = s_logSeq.fetch_add(1);
+    const bool queued = ring->queue.push(rec);
+    ring->publishing.store(~0ULL);
+    if (queued) {
+        // An error is often the last thing written before an abort or a crash, so it doesn't return
+        // before the log thread has written it, along with everything queued ahead of it.
+        if (rec.color == Color_StrongRed) {
+            std::unique_lock lock(s_logWakeMutex);
+            s_logFlush = true;
+            s_logWake.notify_one();
+            const u64 seq = rec.seq;
+            s_logWritten.wait(lock, [seq] { return s_logWrittenSeq > seq || s_logThreadDone; });
+        }
+        return;
+    }
+
+    // Full ring, emulation never waits on the log.  Errors are the exception, they are written right away.
+    if (rec.color == Color_StrongRed) {
+        const wxString text = rec.text ? *rec.text : fromUTF8(FormatLogRecord(rec).c_str());
+        rec.DoSetColor(rec.color);
+        rec.DoWriteLn(IndentLogText(text, rec.indent));
+        rec.DoSetColor(DefaultConsoleColor);
+    } else
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+    delete rec.text;
+}
+
+static bool DeferLogWrite(const IConsoleWriter &writer, ConsoleColors color, int indent, const char *fmt,
+                          va_list args)
+{
+    if (!s_logDeferred.load(std::memory_order_relaxed))
+        return false;
+
+    DeferredLogRecord rec;
+    rec.DoWriteLn  = writer.DoWriteLn;
+    rec.DoSetColor = writer.DoSetColor;
+    rec.fmt        = fmt;
+    rec.text       = nullptr;
+    rec.color      = color;
+    rec.indent     = (s16)indent;
+
+    va_list capture;
+    va_copy(capture, args);
+    const bool captured = CaptureLogArgs(rec, fmt, capture);
+    va_end(capture);
+    if (!captured) {
+        rec.fmt  = nullptr;
+        rec.text = new wxString(pxsFmtV(fmt, args));
+    }
+
+    PushLogRecord(rec);
+    return true;
+}
+
+static bool DeferLogWrite(const IConsoleWriter &writer, ConsoleColors color, int indent, const wxChar *fmt,
+                          va_list args)
+{
+    if (!s_logDeferred.load(std::memory_order_relaxed))
+        return false;
+
+    DeferredLogRecord rec;
+    rec.DoWriteLn  = writer.DoWriteLn;
+    rec.DoSetColor = writer.DoSetColor;
+    rec.fmt        = nullptr;
+    rec.text       = new wxString(pxsFmtV(fmt, args));
+    rec.color      = color;
+    rec.indent     = (s16)indent;
+    PushLogRecord(rec);
+    return true;
+}
+
+// State of the log thread for folding repeats and rate limiting
+struct DeferredLogOutput
+{
+    wxString      lastText;
+    ConsoleColors lastColor = Color_Default;
+    void(__concall *lastDoWriteLn)(const wxString &fmt)  = nullptr;
+    void(__concall *lastDoSetColor)(ConsoleColors color) = nullptr;
+
+    u32                                   repeats       = 0;
+    u32                                   suppressed    = 0;
+    u32                                   linesInWindow = 0;
+    std::chrono::steady_clock::time_point windowStart   = std::chrono::steady_clock::now();
+
+    void Emit(void(__concall *doWriteLn)(const wxString &), void(__concall *doSetColor)(ConsoleColors),
+              ConsoleColors color, const wxString &text)
+    {
+        if (color != DefaultConsoleColor)
+            doSetColor(color);
+        doWriteLn(text);
+        if (color != DefaultConsoleColor)
+            doSetColor(DefaultConsoleColor);
+    }
+
+    void FlushRepeats()
+    {
+        if (repeats > 0 && lastDoWriteLn) {
+            Emit(lastDoWriteLn, lastDoSetColor, Color_Gray,
+                 wxString::Format(L"(last message repeated %u times)", repeats));
+            repeats = 0;
+        }
+    }
+
+    void FlushSuppressed()
+    {
+        if (suppressed > 0 && lastDoWriteLn) {
+            Emit(lastDoWriteLn, lastDoSetColor, Color_Orange,
+                 wxString::Format(L"(%u log messages suppressed)", suppressed));
+            suppressed = 0;
+        }
+    }
+
+    void Write(const DeferredLogRecord &rec)
+    {
+        const wxString text =
+            IndentLogText(rec.text ? *rec.text : fromUTF8(FormatLogRecord(rec).c_str()), rec.indent);
+        if (rec.DoWriteLn == lastDoWriteLn && rec.color == lastColor && text == lastText) {
+            ++repeats;
+            return;
+        }
+        FlushRepeats();
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - windowStart >= std::chrono::seconds(1)) {
+            windowStart   = now;
+            linesInWindow = 0;
+            FlushSuppressed();
+        }
+        // errors always get through
+        if (++linesInWindow > DeferredLogMaxLinesPerSec && rec.color != Color_StrongRed) {
+            ++suppressed;
+            return;
+        }
+
+        Emit(rec.DoWriteLn, rec.DoSetColor, rec.color, text);
+        lastText       = text;
+        lastColor      = rec.color;
+        lastDoWriteLn  = rec.DoWriteLn;
+        lastDoSetColor = rec.DoSetColor;
+    }
+};
+
+static void DeferredLogThread()
+{
+    Threading::SetNameOfCurrentThread("Console Log");
+
+    DeferredLogOutput              output;
+    std::vector<DeferredLogRecord> batch;
+    bool                           quit = false;
+    while (true) {
+        {
+            std::unique_lock lock(s_logWakeMutex);
+            s_logWake.wait_for(lock, std::chrono::milliseconds(10), [] { return s_logQuit || s_logFlush; });
+            s_logFlush = false;
+            quit       = s_logQuit;
+        }
+
+        // A seq is taken before its record is pushed.  Every record below the lowest seq that may
+        // still be on its way is in the rings by now, the ones above it wait for the next pass so
+        // the order between threads holds.
+        u64 complete = s_logSeq.load();
+        u32 dropped  = 0;
+        {
+            std::lock_guard lock(s_logRingsMutex);
+            for (DeferredLogRing *ring : s_logRings)
+                complete = std::min(complete, ring->publishing.load());
+            for (auto it = s_logRings.begin(); it != s_logRings.end();) {
+                DeferredLogRing *ring     = *it;
+                const bool       orphaned = ring->orphaned.load(std::memory_order_acquire);
+                DeferredLogRecord rec;
+                while (ring->queue.pop(rec))
+                    batch.push_back(rec);
+                dropped += ring->dropped.exchange(0, std::memory_order_relaxed);
+                if (orphaned) {
+                    delete ring;
+                    it = s_logRings.erase(it);
+                } else
+                    ++it;
+            }
+        }
+
+        // the rings are per thread, the sequence number restores the order between threads
+        std::sort(batch.begin(), batch.end(),
+                  [](const DeferredLogRecord &a, const DeferredLogRecord &b) { return a.seq < b.seq; });
+        size_t written = 0;
+        for (; written < batch.size() && batch[written].seq < complete; written++) {
+            output.Write(batch[written]);
+            delete batch[written].text;
+        }
+        batch.erase(batch.begin(), batch.begin() + written);
+        output.suppressed += dropped;
+
+        {
+            std::lock_guard lock(s_logWakeMutex);
+            s_logWrittenSeq = std::max(s_logWrittenSeq, complete);
+            s_logWritten.notify_all();
+        }
+
+        if (!written && batch.empty()) {
+            output.FlushRepeats();
+            output.FlushSuppressed();
+            if (quit)
+                break;
+        }
+    }
+
+    std::lock_guard lock(s_logWakeMutex);
+    s_logThreadDone = true;
+    s_logWritten.notify_all();
+}
+
+void Console_SetDeferredLog(bool enabled)
+{
+    if (enabled == s_logDeferred.load())
+        return;
+
+    if (enabled) {
+        s_logQuit       = false;
+        s_logThreadDone = false;
+        s_logDeferred.store(true);
+        s_logThread = std::thread(DeferredLogThread);
+    } else {
+        // anything queued until now is still written, on the log thread
+        s_logDeferred.store(false);
+        {
+            std::lock_guard lock(s_logWakeMutex);
+            s_logQuit = true;
+        }
+        s_logWake.notify_one();
+        s_logThread.join();
+    }
+}
+
+bool Console_IsDeferredLog()
+{
+    return s_logDeferred.load(std::memory_order_relaxed);
+}
+
+// A joinable std::thread must not reach its destructor, so stop the log thread on exit
+static struct DeferredLogShutdown
+{
+    ~DeferredLogShutdown() { Console_SetDeferredLog(false); }
+} s_logShutdown;
+
 // =====================================================================================================
 //  IConsoleWriter  (implementations)
 // =====================================================================================================
@@ -302,8 +927,12 @@ const IConsoleWriter &IConsoleWriter::SetColor(ConsoleColors color) const
 
     pxAssertMsg((color > Color_Current) && (color < ConsoleColors_Count), "Invalid ConsoleColor specified.");
 
-    if (conlog_Color != color)
-        DoSetColor(conlog_Color = color);
+    // while deferred, the color travels with each record instead
+    if (conlog_Color != color) {
+        conlog_Color = color;
+        if (!Console_IsDeferredLog())
+            DoSetColor(color);
+    }
 
     return *this;
 }
@@ -316,8 +945,11 @@ ConsoleColors IConsoleWriter::GetColor() const
 // Restores the console color to default (usually black, or low-intensity white if the console uses a black background)
 const IConsoleWriter &IConsoleWriter::ClearColor() const
 {
-    if (conlog_Color != DefaultConsoleColor)
-        DoSetColor(conlog_Color = DefaultConsoleColor);
+    if (conlog_Color != DefaultConsoleColor) {
+        conlog_Color = DefaultConsoleColor;
+        if (!Console_IsDeferredLog())
+            DoSetColor(DefaultConsoleColor);
+    }
 
     return *this;
 }
@@ -328,6 +960,8 @@ const IConsoleWriter &IConsoleWriter::ClearColor() const
 
 bool IConsoleWriter::FormatV(const char *fmt, va_list args) const
 {
+    if (DeferLogWrite(*this, conlog_Color, conlog_Indent + _imm_indentation, fmt, args))
+        return false;
     DoWriteLn(_addIndentation(pxsFmtV(fmt, args), conlog_Indent));
     return false;
 }
@@ -381,6 +1015,8 @@ bool IConsoleWriter::Warning(const char *fmt, ...) const
 
 bool IConsoleWriter::FormatV(const wxChar *fmt, va_list args) const
 {
+    if (DeferLogWrite(*this, conlog_Color, conlog_Indent + _imm_indentation, fmt, args))
+        return false;
     DoWriteLn(_addIndentation(pxsFmtV(fmt, args), conlog_Indent));
     return false;
 }
@@ -577,6 +1213,9 @@ NullConsoleWriter NullCon = {};
 // for this log.
 bool ConsoleLogSource::WriteV(ConsoleColors color, const char *fmt, va_list list) const
 {
+    // DoWrite goes straight to Console.DoWriteLn, without indentation
+    if (DeferLogWrite(Console, color, 0, fmt, list))
+        return false;
     ConsoleColorScope cs(color);
     DoWrite(pxsFmtV(fmt, list).c_str());
     return false;
@@ -584,6 +1223,8 @@ bool ConsoleLogSource::WriteV(ConsoleColors color, const char *fmt, va_list list
 
 bool ConsoleLogSource::WriteV(ConsoleColors color, const wxChar *fmt, va_list list) const
 {
+    if (DeferLogWrite(Console, color, 0, fmt, list))
+        return false;
     ConsoleColorScope cs(color);
     DoWrite(pxsFmtV(fmt, list).c_str());
     return false;
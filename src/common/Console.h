@@ -238,6 +238,10 @@ extern IConsoleWriter Console;
 extern void Console_SetStdout(FILE* fp);
 #endif
 extern void Console_SetActiveHandler(const IConsoleWriter& writer, FILE* flushfp = NULL);
+// Moves formatting and output of logs to a background thread, so logging doesn't slow down the
+// calling thread.  Disabling it writes out everything queued so far.
+extern void Console_SetDeferredLog(bool enabled);
+extern bool Console_IsDeferredLog();
 
 extern const IConsoleWriter ConsoleWriter_Null;
 extern const IConsoleWriter ConsoleWriter_Stdout;
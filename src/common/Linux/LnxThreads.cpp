@@ -22,6 +22,7 @@
 #endif
 
 #include "common/PersistentThread.h"
+#include "common/Tracing.h"
 
 // We wont need this until we actually have this more then just stubbed out, so I'm commenting this out
 // to remove an unneeded dependency.
@@ -130,6 +131,7 @@ void Threading::SetNameOfCurrentThread(const char* name)
 #elif defined(__unix__)
 	pthread_set_name_np(pthread_self(), name);
 #endif
+	Tracing::SetThreadName(name);
 }
 
 #endif
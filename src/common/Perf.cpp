@@ -19,6 +19,12 @@
 #ifdef __unix__
 #include <unistd.h>
 #endif
+#ifdef __linux__
+#include <mutex>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
 #ifdef ENABLE_VTUNE
 #include "jitprofiling.h"
 #endif
@@ -40,6 +46,153 @@ namespace Perf
 	InfoVector iop("IOP");
 	InfoVector vu("VU");
 	InfoVector vif("VIF");
+	InfoVector gs("GS");
+
+#ifdef __linux__
+
+	////////////////////////////////////////////////////////////////////////////////
+	// jitdump, see tools/perf/Documentation/jitdump-specification.txt in the kernel
+	////////////////////////////////////////////////////////////////////////////////
+
+	struct JitDumpHeader
+	{
+		u32 magic;
+		u32 version;
+		u32 total_size;
+		u32 elf_mach;
+		u32 pad1;
+		u32 pid;
+		u64 timestamp;
+		u64 flags;
+	};
+
+	struct JitDumpCodeLoad
+	{
+		u32 id;
+		u32 total_size;
+		u64 timestamp;
+		u32 pid;
+		u32 tid;
+		u64 vma;
+		u64 code_addr;
+		u64 code_size;
+		u64 code_index;
+	};
+
+	static const u32 JitDumpMagic = 0x4A695444;
+	static const u32 JitDumpCodeLoadId = 0;
+	static const u32 JitDumpElfMachX86_64 = 62;
+
+	// The code reserves register themselves as a whole so the perf map has a fallback symbol, there
+	// is nothing in them yet. Real code, dispatchers included, is far smaller.
+	static const u32 JitDumpMaxCodeSize = _1mb;
+
+	// Blocks are compiled on the EE, MTVU and GS threads
+	static std::mutex s_jitdump_lock;
+	static FILE* s_jitdump = nullptr;
+	static void* s_jitdump_marker = nullptr;
+	static u64 s_jitdump_index = 0;
+
+	// perf record -k 1 stamps its samples with CLOCK_MONOTONIC, the records have to match
+	static u64 jitdump_timestamp()
+	{
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (u64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+	}
+
+	bool OpenJitDump()
+	{
+		std::lock_guard<std::mutex> lock(s_jitdump_lock);
+		if (s_jitdump)
+			return true;
+
+		char file[256];
+		snprintf(file, sizeof(file), "/tmp/jit-%d.dump", getpid());
+		FILE* fp = fopen(file, "w+");
+		if (!fp)
+			return false;
+
+		// perf inject finds the dump through this mapping in the recorded mmap events
+		void* marker = mmap(nullptr, sysconf(_SC_PAGESIZE), PROT_READ | PROT_EXEC, MAP_PRIVATE, fileno(fp), 0);
+		if (marker == MAP_FAILED)
+		{
+			fclose(fp);
+			return false;
+		}
+
+		JitDumpHeader header = {};
+		header.magic = JitDumpMagic;
+		header.version = 1;
+		header.total_size = sizeof(header);
+		header.elf_mach = JitDumpElfMachX86_64;
+		header.pid = getpid();
+		header.timestamp = jitdump_timestamp();
+		fwrite(&header, sizeof(header), 1, fp);
+
+		s_jitdump = fp;
+		s_jitdump_marker = marker;
+		return true;
+	}
+
+	void CloseJitDump()
+	{
+		std::lock_guard<std::mutex> lock(s_jitdump_lock);
+		if (!s_jitdump)
+			return;
+
+		munmap(s_jitdump_marker, sysconf(_SC_PAGESIZE));
+		fclose(s_jitdump);
+		s_jitdump = nullptr;
+		s_jitdump_marker = nullptr;
+	}
+
+	// Code reused after a recompiler reset or an invalidation gets a new record, perf inject keeps
+	// the one that was loaded at the time of each sample.
+	static void jitdump_load(uptr x86, u32 size, const char* symbol)
+	{
+		if (!s_jitdump || !size || size > JitDumpMaxCodeSize)
+			return;
+
+		const size_t name_size = strlen(symbol) + 1;
+
+		JitDumpCodeLoad rec;
+		rec.id = JitDumpCodeLoadId;
+		rec.total_size = (u32)(sizeof(rec) + name_size + size);
+		rec.timestamp = jitdump_timestamp();
+		rec.pid = getpid();
+		rec.tid = (u32)syscall(SYS_gettid);
+		rec.vma = x86;
+		rec.code_addr = x86;
+		rec.code_size = size;
+
+		std::lock_guard<std::mutex> lock(s_jitdump_lock);
+		if (!s_jitdump)
+			return;
+		rec.code_index = s_jitdump_index++;
+		fwrite(&rec, sizeof(rec), 1, s_jitdump);
+		fwrite(symbol, name_size, 1, s_jitdump);
+		fwrite((void*)x86, size, 1, s_jitdump);
+	}
+
+	static void jitdump_load(const InfoVector& v, uptr x86, u32 size, u32 pc)
+	{
+		if (!s_jitdump)
+			return;
+
+		char symbol[32];
+		v.symbol(symbol, sizeof(symbol), pc);
+		jitdump_load(x86, size, symbol);
+	}
+
+#else
+
+	bool OpenJitDump() { return false; }
+	void CloseJitDump() {}
+	static void jitdump_load(uptr x86, u32 size, const char* symbol) {}
+	static void jitdump_load(const InfoVector& v, uptr x86, u32 size, u32 pc) {}
+
+#endif
 
 // Perf is only supported on linux
 #if defined(__linux__) && (defined(ProfileWithPerf) || defined(ENABLE_VTUNE))
@@ -91,6 +244,8 @@ namespace Perf
 
 	void InfoVector::map(uptr x86, u32 size, const char* symbol)
 	{
+		jitdump_load(x86, size, symbol);
+
 // This function is typically used for dispatcher and recompiler.
 // Dispatchers are on a page and must always be kept.
 // Recompilers are much bigger (TODO check VIF) and are only
@@ -126,6 +281,8 @@ namespace Perf
 
 	void InfoVector::map(uptr x86, u32 size, u32 pc)
 	{
+		jitdump_load(*this, x86, size, pc);
+
 #ifndef MERGE_BLOCK_RESULT
 		m_v.emplace_back(x86, size, m_prefix, pc);
 #endif
@@ -172,6 +329,8 @@ namespace Perf
 		ee.print(fp);
 		iop.print(fp);
 		vu.print(fp);
+		vif.print(fp);
+		gs.print(fp);
 
 		if (fp)
 			fclose(fp);
@@ -185,6 +344,8 @@ namespace Perf
 		ee.reset();
 		iop.reset();
 		vu.reset();
+		vif.reset();
+		gs.reset();
 	}
 
 #else
@@ -196,13 +357,19 @@ namespace Perf
 	InfoVector::InfoVector(const char* prefix)
 		: m_vtune_id(0)
 	{
+		strncpy(m_prefix, prefix, sizeof(m_prefix));
 	}
-	void InfoVector::map(uptr x86, u32 size, const char* symbol) {}
-	void InfoVector::map(uptr x86, u32 size, u32 pc) {}
+	void InfoVector::map(uptr x86, u32 size, const char* symbol) { jitdump_load(x86, size, symbol); }
+	void InfoVector::map(uptr x86, u32 size, u32 pc) { jitdump_load(*this, x86, size, pc); }
 	void InfoVector::reset() {}
 
 	void dump() {}
 	void dump_and_reset() {}
 
 #endif
+
+	void InfoVector::symbol(char* dst, size_t size, u32 pc) const
+	{
+		snprintf(dst, size, "%s_0x%08x", m_prefix, pc);
+	}
 } // namespace Perf
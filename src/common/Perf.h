@@ -49,14 +49,23 @@ namespace Perf
 		void map(uptr x86, u32 size, const char* symbol);
 		void map(uptr x86, u32 size, u32 pc);
 		void reset();
+
+		// Name of the block at pc, as it appears in the perf map and VTune
+		void symbol(char* dst, size_t size, u32 pc) const;
 	};
 
 	void dump();
 	void dump_and_reset();
 
+	// Writes every block mapped from now on to /tmp/jit-<pid>.dump for perf inject --jit,
+	// record with perf record -k 1. Linux only.
+	bool OpenJitDump();
+	void CloseJitDump();
+
 	extern InfoVector any;
 	extern InfoVector ee;
 	extern InfoVector iop;
 	extern InfoVector vu;
 	extern InfoVector vif;
+	extern InfoVector gs;
 } // namespace Perf
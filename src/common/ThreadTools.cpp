@@ -736,6 +736,80 @@ void Threading::WaitEvent::Wait()
 }
 #endif
 
+// --------------------------------------------------------------------------------------
+//  WaitSite
+// --------------------------------------------------------------------------------------
+
+// Sites are static objects, a plain pointer is set up before any of their constructors runs
+static Threading::WaitSite *s_firstWaitSite = nullptr;
+
+static const char *const WaitPhaseNames[Threading::WaitSite::Phase_Count] = {"spin", "yield", "sleep"};
+
+Threading::WaitSite::WaitSite(const char *name)
+    : m_name(name), m_next(s_firstWaitSite), m_shift(0), m_spun(0), m_start(0)
+{
+    m_stats         = Stats();
+    s_firstWaitSite = this;
+}
+
+const Threading::WaitSite *Threading::WaitSite::GetFirst()
+{
+    return s_firstWaitSite;
+}
+
+const char *Threading::WaitSite::GetPhaseName(int phase)
+{
+    return WaitPhaseNames[phase];
+}
+
+void Threading::WaitSite::ResetAll()
+{
+    for (WaitSite *site = s_firstWaitSite; site; site = site->m_next)
+        site->m_stats = Stats();
+}
+
+void Threading::WaitSite::Finish(Phase phase, u32 spun)
+{
+    u64 ns = spun;
+    if (m_start) {
+        ns += (GetCPUTicks() - m_start) * 1000000000 / GetTickFrequency();
+        m_start = 0;
+    }
+
+    int bucket = 0;
+    for (u64 us = ns / 1000; us && bucket < Buckets - 1; us >>= 1)
+        bucket++;
+    m_stats.waits[phase][bucket]++;
+}
+
+void Threading::WaitSite::Report(FILE *fp)
+{
+    char label[16];
+    fprintf(fp, "%-20s %10s %10s %-6s", "site", "elided", "immediate", "phase");
+    for (int i = 0; i < Buckets; i++) {
+        if (i == Buckets - 1)
+            snprintf(label, sizeof(label), ">=%uus", 1u << (i - 1));
+        else
+            snprintf(label, sizeof(label), "<%uus", 1u << i);
+        fprintf(fp, " %8s", label);
+    }
+    fprintf(fp, "\n");
+
+    for (const WaitSite *site = s_firstWaitSite; site; site = site->m_next) {
+        const Stats &stats = site->m_stats;
+        for (int phase = 0; phase < Phase_Count; phase++) {
+            if (phase == 0)
+                fprintf(fp, "%-20s %10llu %10llu %-6s", site->m_name, (unsigned long long)stats.elided,
+                        (unsigned long long)stats.immediate, WaitPhaseNames[phase]);
+            else
+                fprintf(fp, "%-20s %10s %10s %-6s", "", "", "", WaitPhaseNames[phase]);
+            for (int i = 0; i < Buckets; i++)
+                fprintf(fp, " %8llu", (unsigned long long)stats.waits[phase][i]);
+            fprintf(fp, "\n");
+        }
+    }
+}
+
 // --------------------------------------------------------------------------------------
 //  BaseThreadError
 // --------------------------------------------------------------------------------------
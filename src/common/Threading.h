@@ -20,6 +20,8 @@
 #include <wx/filefn.h>
 #define HAVE_MODE_T
 #endif
+#include <cstdio>
+#include <thread>
 #include <semaphore.h>
 #include <errno.h>    // EBUSY
 #include <pthread.h>
@@ -268,6 +270,122 @@ class Semaphore {
     bool Wait(const wxTimeSpan &timeout);
 };
 
+// --------------------------------------------------------------------------------------
+//  WaitSite
+// --------------------------------------------------------------------------------------
+// One place where a thread waits for another one. A wait first spins on its condition with
+// ShortSpin(), then yields a few timeslices, and only then blocks on the mutex or semaphore
+// of the site. The spin budget starts at SPIN_TIME_NS and adapts: it's halved every time the
+// spin ran out and doubled back every time it caught the other thread, so a site that always
+// ends up blocking stops burning a core.
+//
+// Every wait lands in a log2 histogram of its duration, split by the phase that ended it.
+// A site is only waited on by one thread at a time, the counters aren't atomic.
+//
+class WaitSite {
+  public:
+    enum Phase {
+        Phase_Spin,
+        Phase_Yield,
+        Phase_Sleep,
+        Phase_Count
+    };
+
+    static const int Buckets    = 16;    // < 1us, < 2us, < 4us, ..., >= 16ms
+    static const int YieldCount = 4;
+    static const int MaxShift   = 6;     // the budget never goes below SPIN_TIME_NS / 64
+
+    struct Stats {
+        u64 elided;       // no new work since the previous wait, the condition wasn't checked
+        u64 immediate;    // the condition already held
+        u64 waits[Phase_Count][Buckets];
+    };
+
+    explicit WaitSite(const char *name);
+
+    const char *GetName() const { return m_name; }
+    const Stats &GetStats() const { return m_stats; }
+    const WaitSite *GetNext() const { return m_next; }
+    static const WaitSite *GetFirst();
+    static const char *GetPhaseName(int phase);
+
+    static void ResetAll();
+    static void Report(FILE *fp);
+
+    __fi void Elided() { m_stats.elided++; }
+
+    // Waits until done() holds, sleep() is the blocking wait and may return early.
+    template <typename Done, typename Sleep>
+    void Wait(Done done, Sleep sleep)
+    {
+        if (done()) {
+            m_stats.immediate++;
+            return;
+        }
+        if (Spin(done))
+            return;
+        do {
+            sleep();
+        } while (!done());
+        Slept();
+    }
+
+    // Spins then yields until done() holds. False means the budget ran out, the caller blocks
+    // on its own and calls Slept() once it woke up.
+    template <typename Done>
+    bool Spin(Done done)
+    {
+        const u32 budget = SPIN_TIME_NS >> m_shift;
+        u32       waited = 0;
+        m_start          = 0;
+        while (waited < budget) {
+            waited += ShortSpin();
+            if (done()) {
+                if (m_shift > 0)
+                    m_shift--;
+                Finish(Phase_Spin, waited);
+                return true;
+            }
+        }
+        if (m_shift < MaxShift)
+            m_shift++;
+
+        m_start = GetCPUTicks();
+        m_spun  = waited;
+        for (int i = 0; i < YieldCount; i++) {
+            std::this_thread::yield();
+            if (done()) {
+                Finish(Phase_Yield, m_spun);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Slept()
+    {
+        if (m_start)
+            Finish(Phase_Sleep, m_spun);
+    }
+
+    // For waits that have to block at least once, Slept() records them.
+    void Block()
+    {
+        m_start = GetCPUTicks();
+        m_spun  = 0;
+    }
+
+  private:
+    void Finish(Phase phase, u32 spun);
+
+    const char *m_name;
+    WaitSite   *m_next;
+    Stats       m_stats;
+    int         m_shift;
+    u32         m_spun;
+    u64         m_start;    // GetCPUTicks() when the spin ran out, 0 once the wait was recorded
+};
+
 class Mutex {
   protected:
     pthread_mutex_t m_mutex;
@@ -0,0 +1,195 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/Tracing.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> Tracing::s_enabled(false);
+
+enum TraceEventType : u32
+{
+    TraceEvent_Zone,
+    TraceEvent_Counter,
+};
+
+struct TraceEvent
+{
+    const char    *name;
+    u64            start;
+    u64            value;    // end of a zone, value of a counter
+    TraceEventType type;
+};
+
+// 32MB a thread, allocated the first time the thread records something. That's about a minute of the busiest thread.
+// A full buffer drops new events rather than wrapping, so the exporter can read everything below the count while the
+// thread keeps going.
+static const u32 TraceBufferEvents = 1 << 20;
+
+struct TraceThreadBuffer
+{
+    char                          name[32];
+    u32                           tid;
+    std::unique_ptr<TraceEvent[]> events;
+    std::atomic<u32>              count;
+    u32                           dropped;
+};
+
+// Buffers outlive their threads, the export has to see the ones that already exited.
+static std::mutex                                      s_buffersLock;
+static std::vector<std::unique_ptr<TraceThreadBuffer>> s_buffers;
+
+static u64                                   s_startTsc = 0;
+static std::chrono::steady_clock::time_point s_startTime;
+
+static thread_local TraceThreadBuffer *t_buffer = nullptr;
+static thread_local char               t_name[32];
+
+static TraceThreadBuffer *GetThreadBuffer()
+{
+    if (t_buffer)
+        return t_buffer;
+
+    std::unique_ptr<TraceThreadBuffer> buffer(new TraceThreadBuffer());
+    buffer->events.reset(new TraceEvent[TraceBufferEvents]);
+    buffer->count   = 0;
+    buffer->dropped = 0;
+
+    std::lock_guard<std::mutex> lock(s_buffersLock);
+    buffer->tid = (u32)s_buffers.size() + 1;
+    if (t_name[0])
+        snprintf(buffer->name, sizeof(buffer->name), "%s", t_name);
+    else
+        snprintf(buffer->name, sizeof(buffer->name), "Thread %u", buffer->tid);
+    t_buffer = buffer.get();
+    s_buffers.push_back(std::move(buffer));
+    return t_buffer;
+}
+
+static void AppendEvent(TraceEventType type, const char *name, u64 start, u64 value)
+{
+    TraceThreadBuffer *buffer = GetThreadBuffer();
+    const u32          count  = buffer->count.load(std::memory_order_relaxed);
+    if (count >= TraceBufferEvents) {
+        buffer->dropped++;
+        return;
+    }
+
+    TraceEvent &event = buffer->events[count];
+    event.name        = name;
+    event.start       = start;
+    event.value       = value;
+    event.type        = type;
+    buffer->count.store(count + 1, std::memory_order_release);
+}
+
+void Tracing::AddZone(const char *name, u64 start, u64 end)
+{
+    AppendEvent(TraceEvent_Zone, name, start, end);
+}
+
+void Tracing::AddCounter(const char *name, s64 value)
+{
+    AppendEvent(TraceEvent_Counter, name, Timestamp(), (u64)value);
+}
+
+void Tracing::SetThreadName(const char *name)
+{
+    snprintf(t_name, sizeof(t_name), "%s", name);
+    if (t_buffer) {
+        std::lock_guard<std::mutex> lock(s_buffersLock);
+        snprintf(t_buffer->name, sizeof(t_buffer->name), "%s", name);
+    }
+}
+
+void Tracing::Start()
+{
+    if (IsEnabled())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(s_buffersLock);
+        for (auto &buffer : s_buffers) {
+            buffer->count.store(0, std::memory_order_relaxed);
+            buffer->dropped = 0;
+        }
+    }
+
+    s_startTime = std::chrono::steady_clock::now();
+    s_startTsc  = Timestamp();
+    s_enabled.store(true, std::memory_order_release);
+}
+
+void Tracing::Stop()
+{
+    s_enabled.store(false, std::memory_order_release);
+}
+
+bool Tracing::Export(const char *filename)
+{
+    if (!s_startTsc)
+        return false;
+
+    // rdtsc runs at a fixed rate on anything recent, calibrate it against the whole recording
+    using Microseconds   = std::chrono::duration<double, std::micro>;
+    const u64    tsc     = Timestamp();
+    const double elapsed = Microseconds(std::chrono::steady_clock::now() - s_startTime).count();
+    if (elapsed <= 0 || tsc <= s_startTsc)
+        return false;
+    const double ticksPerUs = (tsc - s_startTsc) / elapsed;
+
+    FILE *fp = fopen(filename, "w");
+    if (!fp)
+        return false;
+
+    fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    fprintf(fp, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"PCSX2\"}}");
+
+    std::lock_guard<std::mutex> lock(s_buffersLock);
+    for (auto &buffer : s_buffers) {
+        fprintf(fp, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                buffer->tid, buffer->name);
+
+        const u32 count = buffer->count.load(std::memory_order_acquire);
+        for (u32 i = 0; i < count; i++) {
+            const TraceEvent &event = buffer->events[i];
+            if (event.start < s_startTsc)
+                continue;
+
+            const double ts = (event.start - s_startTsc) / ticksPerUs;
+            if (event.type == TraceEvent_Zone)
+                fprintf(fp, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                        event.name, buffer->tid, ts, (event.value - event.start) / ticksPerUs);
+            else
+                fprintf(fp,
+                        ",\n{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,"
+                        "\"args\":{\"value\":%lld}}",
+                        event.name, buffer->tid, ts, (long long)(s64)event.value);
+        }
+
+        if (buffer->dropped)
+            fprintf(fp, ",\n{\"name\":\"Dropped events\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,"
+                        "\"args\":{\"count\":%u}}",
+                    buffer->tid, elapsed, buffer->dropped);
+    }
+
+    fprintf(fp, "\n]}\n");
+    fclose(fp);
+    return true;
+}
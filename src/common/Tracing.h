@@ -0,0 +1,102 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include "common/Pcsx2Defs.h"
+
+// --------------------------------------------------------------------------------------
+//  Tracing
+// --------------------------------------------------------------------------------------
+// Timeline of what every thread is doing, exported as Chrome trace JSON (chrome://tracing,
+// ui.perfetto.dev). Zones and counters are stamped with rdtsc and appended to a buffer owned
+// by the calling thread, so recording never takes a lock. Names must be string literals, only
+// the pointer is stored.
+//
+// Nothing is recorded until Start(), a disabled zone costs a load and a branch.
+//
+namespace Tracing
+{
+	extern std::atomic<bool> s_enabled;
+
+	static __fi bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+	static __fi u64 Timestamp() { return __rdtsc(); }
+
+	void Start();
+	void Stop();
+	bool Export(const char* filename);
+
+	// Names the calling thread in the exported timeline, see Threading::SetNameOfCurrentThread.
+	void SetThreadName(const char* name);
+
+	void AddZone(const char* name, u64 start, u64 end);
+	void AddCounter(const char* name, s64 value);
+
+	class ScopedZone
+	{
+		const char* m_name;
+		u64 m_start;
+
+	public:
+		__fi ScopedZone(const char* name)
+			: m_name(name)
+			, m_start(IsEnabled() ? Timestamp() : 0)
+		{
+		}
+
+		__fi ~ScopedZone()
+		{
+			if (m_start)
+				AddZone(m_name, m_start, Timestamp());
+		}
+	};
+
+	// Zone for waits that usually don't happen, nothing is recorded unless Begin() was called.
+	class ScopedStall
+	{
+		const char* m_name;
+		u64 m_start;
+
+	public:
+		__fi ScopedStall(const char* name)
+			: m_name(name)
+			, m_start(0)
+		{
+		}
+
+		__fi void Begin()
+		{
+			if (!m_start && IsEnabled())
+				m_start = Timestamp();
+		}
+
+		__fi ~ScopedStall()
+		{
+			if (m_start)
+				AddZone(m_name, m_start, Timestamp());
+		}
+	};
+} // namespace Tracing
+
+#define TRACE_ZONE_CONCAT2(a, b) a##b
+#define TRACE_ZONE_CONCAT(a, b) TRACE_ZONE_CONCAT2(a, b)
+#define TRACE_ZONE(name) Tracing::ScopedZone TRACE_ZONE_CONCAT(trace_zone_, __LINE__)(name)
+#define TRACE_COUNTER(name, value) \
+	do \
+	{ \
+		if (Tracing::IsEnabled()) \
+			Tracing::AddCounter(name, value); \
+	} while (0)
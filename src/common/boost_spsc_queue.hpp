@@ -174,10 +174,12 @@ public:
      *
      * \return true, if the ringbuffer is empty, false otherwise
      * \note Due to the concurrent nature of the ringbuffer the result may be inaccurate.
+     * \note Acquires both indices, a producer that finds the ringbuffer empty also sees what the consumer did with
+     *       the elements, and the other way around.
      * */
     bool empty(void)
     {
-        return empty(write_index_.load(std::memory_order_relaxed), read_index_.load(std::memory_order_relaxed));
+        return empty(write_index_.load(std::memory_order_acquire), read_index_.load(std::memory_order_acquire));
     }
 
     /**
@@ -0,0 +1,70 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/emitter/internal.h"
+
+namespace x86Emitter
+{
+
+	void xImplAVX_ThreeArg::operator()(const xRegisterSSE& to, const xRegisterSSE& from1, const xRegisterSSE& from2) const
+	{
+		EmitVex(Prefix, to, from1.GetId(), from2);
+		xWrite8(Opcode);
+		EmitSibMagic(to, from2);
+	}
+
+	void xImplAVX_ThreeArg::operator()(const xRegisterSSE& to, const xRegisterSSE& from1, const xIndirectVoid& from2) const
+	{
+		EmitVex(Prefix, to, from1.GetId(), from2);
+		xWrite8(Opcode);
+		EmitSibMagic(to, from2);
+	}
+
+	void xImplAVX_ShiftImm::operator()(const xRegisterSSE& to, const xRegisterSSE& from, u8 imm) const
+	{
+		EmitVex(0x66, Modrm, to.GetId(), from);
+		xWrite8(Opcode);
+		EmitSibMagic(Modrm, from);
+		xWrite8(imm);
+	}
+
+	const xImplAVX_ArithFloat xVADD = {{0x00, 0x58}, {0xf3, 0x58}};
+	const xImplAVX_ArithFloat xVSUB = {{0x00, 0x5c}, {0xf3, 0x5c}};
+	const xImplAVX_ArithFloat xVMUL = {{0x00, 0x59}, {0xf3, 0x59}};
+	const xImplAVX_ArithFloat xVMIN = {{0x00, 0x5d}, {0xf3, 0x5d}};
+	const xImplAVX_ArithFloat xVMAX = {{0x00, 0x5f}, {0xf3, 0x5f}};
+
+	const xImplAVX_LogicFloat xVAND = {{0x00, 0x54}};
+	const xImplAVX_LogicFloat xVANDN = {{0x00, 0x55}};
+	const xImplAVX_LogicFloat xVOR = {{0x00, 0x56}};
+	const xImplAVX_LogicFloat xVXOR = {{0x00, 0x57}};
+
+	const xImplAVX_ThreeArg xVPAND = {0x66, 0xdb};
+	const xImplAVX_ThreeArg xVPANDN = {0x66, 0xdf};
+	const xImplAVX_ThreeArg xVPOR = {0x66, 0xeb};
+	const xImplAVX_ThreeArg xVPXOR = {0x66, 0xef};
+
+	const xImplAVX_AddSub xVPADD = {{0x66, 0xfc}, {0x66, 0xfd}, {0x66, 0xfe}};
+	const xImplAVX_AddSub xVPSUB = {{0x66, 0xf8}, {0x66, 0xf9}, {0x66, 0xfa}};
+
+	const xImplAVX_Compare xVPCMP = {
+		{0x66, 0x74}, {0x66, 0x75}, {0x66, 0x76},
+		{0x66, 0x64}, {0x66, 0x65}, {0x66, 0x66},
+	};
+
+	const xImplAVX_ShiftImm xVPSRAD = {0x72, 4};
+	const xImplAVX_ShiftImm xVPSRLD = {0x72, 2};
+	const xImplAVX_ShiftImm xVPSLLD = {0x72, 6};
+} // namespace x86Emitter
@@ -0,0 +1,76 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Implement the VEX.128 three operand forms of the SSE instructions, requires AVX.
+// They give the same results as their SSE counterparts, but the destination doesn't
+// have to be one of the sources, which saves the copy the two operand form needs.
+
+namespace x86Emitter
+{
+
+	// ------------------------------------------------------------------------
+	// to = from1 op from2
+	struct xImplAVX_ThreeArg
+	{
+		u8 Prefix;
+		u8 Opcode;
+
+		void operator()(const xRegisterSSE& to, const xRegisterSSE& from1, const xRegisterSSE& from2) const;
+		void operator()(const xRegisterSSE& to, const xRegisterSSE& from1, const xIndirectVoid& from2) const;
+	};
+
+	// ------------------------------------------------------------------------
+	// to = from shifted by imm (the destination is encoded in VEX.vvvv)
+	struct xImplAVX_ShiftImm
+	{
+		u8 Opcode;
+		u8 Modrm;
+
+		void operator()(const xRegisterSSE& to, const xRegisterSSE& from, u8 imm) const;
+	};
+
+	// ------------------------------------------------------------------------
+	struct xImplAVX_ArithFloat
+	{
+		const xImplAVX_ThreeArg PS;
+		const xImplAVX_ThreeArg SS;
+	};
+
+	struct xImplAVX_LogicFloat
+	{
+		const xImplAVX_ThreeArg PS;
+	};
+
+	struct xImplAVX_AddSub
+	{
+		const xImplAVX_ThreeArg B;
+		const xImplAVX_ThreeArg W;
+		const xImplAVX_ThreeArg D;
+	};
+
+	struct xImplAVX_Compare
+	{
+		const xImplAVX_ThreeArg EQB;
+		const xImplAVX_ThreeArg EQW;
+		const xImplAVX_ThreeArg EQD;
+
+		const xImplAVX_ThreeArg GTB;
+		const xImplAVX_ThreeArg GTW;
+		const xImplAVX_ThreeArg GTD;
+	};
+
+} // namespace x86Emitter
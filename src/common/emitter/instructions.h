@@ -124,6 +124,15 @@ namespace x86Emitter
 	// BMI extra instruction requires BMI1/BMI2
 	extern const xImplBMI_RVM xMULX, xPDEP, xPEXT, xANDN_S; // Warning xANDN is already used by SSE
 
+	// ------------------------------------------------------------------------
+	// AVX three operand forms of the SSE instructions, requires AVX
+	extern const xImplAVX_ArithFloat xVADD, xVSUB, xVMUL, xVMIN, xVMAX;
+	extern const xImplAVX_LogicFloat xVAND, xVANDN, xVOR, xVXOR;
+	extern const xImplAVX_ThreeArg xVPAND, xVPANDN, xVPOR, xVPXOR;
+	extern const xImplAVX_AddSub xVPADD, xVPSUB;
+	extern const xImplAVX_Compare xVPCMP;
+	extern const xImplAVX_ShiftImm xVPSRAD, xVPSRLD, xVPSLLD;
+
 	//////////////////////////////////////////////////////////////////////////////////////////
 	// Miscellaneous Instructions
 	// These are all defined inline or in ix86.cpp.
@@ -38,6 +38,10 @@ namespace x86Emitter
 	extern void EmitRex(const xRegisterBase& reg1, const void* src);
 	extern void EmitRex(const xRegisterBase& reg1, const xIndirectVoid& sib);
 
+	extern void EmitVex(u8 prefix, uint regfield, uint vvvv, const xRegisterBase& reg2);
+	extern void EmitVex(u8 prefix, const xRegisterBase& reg1, uint vvvv, const xRegisterBase& reg2);
+	extern void EmitVex(u8 prefix, const xRegisterBase& reg1, uint vvvv, const xIndirectVoid& sib);
+
 	extern void _xMovRtoR(const xRegisterInt& to, const xRegisterInt& from);
 
 	template <typename T>
@@ -537,6 +537,55 @@ const xRegister32
 		EmitRex(w, r, x, b);
 	}
 
+	// VEX.128.0F.WIG prefix, the 2 bytes form unless X or B are needed. R, X and B are
+	// the REX bits, VEX stores them inverted like vvvv.
+	__emitinline static void EmitVex(u8 prefix, bool r, bool x, bool b, uint vvvv)
+	{
+		const u8 p =
+			prefix == 0xF2 ? 3 :
+			prefix == 0xF3 ? 2 :
+			prefix == 0x66 ? 1 :
+                             0;
+		const u8 nv = (~vvvv & 0xF) << 3;
+
+#ifndef __M_X86_64
+		r = x = b = false;
+#endif
+		if (!x && !b)
+		{
+			xWrite8(0xC5);
+			xWrite8((r ? 0 : 0x80) | nv | p);
+		}
+		else
+		{
+			xWrite8(0xC4);
+			xWrite8((r ? 0 : 0x80) | (x ? 0 : 0x40) | (b ? 0 : 0x20) | 0x01);
+			xWrite8(nv | p);
+		}
+	}
+
+	void EmitVex(u8 prefix, uint regfield, uint vvvv, const xRegisterBase& reg2)
+	{
+		EmitVex(prefix, false, false, reg2.IsExtended(), vvvv);
+	}
+
+	void EmitVex(u8 prefix, const xRegisterBase& reg1, uint vvvv, const xRegisterBase& reg2)
+	{
+		EmitVex(prefix, reg1.IsExtended(), false, reg2.IsExtended(), vvvv);
+	}
+
+	void EmitVex(u8 prefix, const xRegisterBase& reg1, uint vvvv, const xIndirectVoid& sib)
+	{
+		bool x = sib.Index.IsExtended();
+		bool b = sib.Base.IsExtended();
+		if (!NeedsSibMagic(sib))
+		{
+			b = x;
+			x = false;
+		}
+		EmitVex(prefix, reg1.IsExtended(), x, b, vvvv);
+	}
+
 
 	// --------------------------------------------------------------------------------------
 	//  xSetPtr / xAlignPtr / xGetPtr / xAdvancePtr
@@ -738,6 +738,19 @@ static uint cdvdBlockReadTime(CDVD_MODE_TYPE mode)
     return (PSXCLK / (((mode == MODE_CDROM) ? CD_SECTORS_PERSECOND : DVD_SECTORS_PERSECOND) * cdvd.Speed));
 }
 
+static void cdvdSetRTCToHostTime()
+{
+    // CDVD internally uses GMT+9.  If you think the time's wrong, you're wrong.
+    // Set up your time zone and winter/summer in the BIOS.  No PS2 BIOS I know of features automatic DST.
+    wxDateTime curtime(wxDateTime::GetTimeNow());
+    cdvd.RTC.second = (u8)curtime.GetSecond();
+    cdvd.RTC.minute = (u8)curtime.GetMinute();
+    cdvd.RTC.hour   = (u8)curtime.GetHour(wxDateTime::GMT9);
+    cdvd.RTC.day    = (u8)curtime.GetDay(wxDateTime::GMT9);
+    cdvd.RTC.month  = (u8)curtime.GetMonth(wxDateTime::GMT9) + 1;    // WX returns Jan as "0"
+    cdvd.RTC.year   = (u8)(curtime.GetYear(wxDateTime::GMT9) - 2000);
+}
+
 void cdvdReset()
 {
     memzero(cdvd);
@@ -753,15 +766,7 @@ void cdvdReset()
     cdvd.Action    = cdvdAction_None;
     cdvd.ReadTime  = cdvdBlockReadTime(MODE_DVDROM);
 
-    // CDVD internally uses GMT+9.  If you think the time's wrong, you're wrong.
-    // Set up your time zone and winter/summer in the BIOS.  No PS2 BIOS I know of features automatic DST.
-    wxDateTime curtime(wxDateTime::GetTimeNow());
-    cdvd.RTC.second = (u8)curtime.GetSecond();
-    cdvd.RTC.minute = (u8)curtime.GetMinute();
-    cdvd.RTC.hour   = (u8)curtime.GetHour(wxDateTime::GMT9);
-    cdvd.RTC.day    = (u8)curtime.GetDay(wxDateTime::GMT9);
-    cdvd.RTC.month  = (u8)curtime.GetMonth(wxDateTime::GMT9) + 1;    // WX returns Jan as "0"
-    cdvd.RTC.year   = (u8)(curtime.GetYear(wxDateTime::GMT9) - 2000);
+    cdvdSetRTCToHostTime();
 
     g_GameStarted  = false;
     g_GameLoading  = false;
@@ -793,6 +798,15 @@ void SaveStateBase::cdvdFreeze()
     }
 }
 
+// A boot snapshot carries the clock and the media state from the run that saved it, the rest of the drive state
+// is what the BIOS left behind and doesn't depend on the disc.
+void cdvdReloadHostState()
+{
+    cdvdSetRTCToHostTime();
+    DoCDVDresetDiskTypeCache();
+    cdvdCtrlTrayClose();
+}
+
 void cdvdNewDiskCB()
 {
     ScopedTryLock lock(Mutex_NewDiskCB);
@@ -161,6 +161,7 @@ extern cdvdStruct cdvd;
 extern void cdvdReadLanguageParams(u8* config);
 
 extern void cdvdReset();
+extern void cdvdReloadHostState();
 extern void cdvdVsync();
 extern void cdvdActionInterrupt();
 extern void cdvdSectorReady();
@@ -35,6 +35,7 @@
 #include "CDVDisoReader.h"
 
 #include "common/StringUtil.h"
+#include "common/Tracing.h"
 // #include "DebugTools/SymbolMap.h"
 #include "Config.h"
 
@@ -419,6 +420,7 @@ s32 DoCDVDreadSector(u8 *buffer, u32 lsn, int mode)
 
 s32 DoCDVDreadTrack(u32 lsn, int mode)
 {
+    TRACE_ZONE("CDVD Read");
     CheckNullCDVD();
 
     // TODO: The CDVD api only uses the new getBuffer style. Why is this temp?
@@ -445,6 +447,7 @@ s32 DoCDVDreadTrack(u32 lsn, int mode)
 
 s32 DoCDVDgetBuffer(u8 *buffer)
 {
+    TRACE_ZONE("CDVD Get Buffer");
     CheckNullCDVD();
     const int ret = CDVD->getBuffer(buffer);
 
@@ -198,6 +198,8 @@ struct Pcsx2Config
 
         bool StackFrameChecks : 1, PreBlockCheckEE : 1, PreBlockCheckIOP : 1;
         bool EnableEECache : 1;
+        bool DeferEECompile : 1;
+        bool PersistIOPBlocks : 1, PrecompileIOPModules : 1;
         BITFIELD_END
 
         RecompilerOptions();
@@ -327,21 +329,28 @@ struct Pcsx2Config
     struct SpeedhackOptions
     {
         BITFIELD32()
-        bool fastCDVD : 1, IntcStat : 1, WaitLoop : 1, vuFlagHack : 1, vuThread : 1, vu1Instant : 1;
+        bool fastCDVD : 1, IntcStat : 1, WaitLoop : 1, vuFlagHack : 1, vuThread : 1, vu1Instant : 1, vu0Thread : 1,
+             vifTraceCache : 1;
         BITFIELD_END
 
         s8 EECycleRate;
         u8 EECycleSkip;
 
+        // Discs that may run VU0 micro programs on their own thread, comma separated serials
+        // or "*" for everything. vu0Thread does nothing for a disc that isn't listed.
+        std::string vu0ThreadSerials;
+
         SpeedhackOptions();
         void              LoadSave(SettingsWrapper &conf);
         SpeedhackOptions &DisableAll();
 
         void Set(SpeedhackId id, bool enabled = true);
 
+        bool IsVU0ThreadAllowed(const wxString &serial) const;
+
         bool operator==(const SpeedhackOptions &right) const
         {
-            return OpEqu(bitset) && OpEqu(EECycleRate) && OpEqu(EECycleSkip);
+            return OpEqu(bitset) && OpEqu(EECycleRate) && OpEqu(EECycleSkip) && OpEqu(vu0ThreadSerials);
         }
 
         bool operator!=(const SpeedhackOptions &right) const
@@ -429,8 +438,8 @@ struct Pcsx2Config
 
     BITFIELD32()
     bool CdvdVerboseReads : 1, CdvdDumpBlocks : 1, CdvdShareWrite : 1, EnablePatches : 1, EnableCheats : 1,
-        EnableIPC : 1, EnableWideScreenPatches : 1, UseBOOT2Injection : 1, BackupSavestate : 1, McdEnableEjection : 1,
-        McdFolderAutoManage : 1,
+        EnableIPC : 1, EnableWideScreenPatches : 1, UseBOOT2Injection : 1, UseBootSnapshot : 1, BackupSavestate : 1,
+        McdEnableEjection : 1, McdFolderAutoManage : 1,
 
         MultitapPort0_Enabled : 1, MultitapPort1_Enabled : 1,
 
@@ -461,6 +470,7 @@ struct Pcsx2Config
     std::string     CurrentGameArgs;
     AspectRatioType CurrentAspectRatio = AspectRatioType::R4_3;
     LimiterModeType LimiterMode        = LimiterModeType::Nominal;
+    bool            CurrentVU0Thread   = false;    // vu0Thread for the running disc, see SysCoreThread
 
     Pcsx2Config();
     void LoadSave(SettingsWrapper &wrap);
@@ -496,7 +506,9 @@ extern wxDirName CheatsWS;
 
 
 #define THREAD_VU1   (EmuConfig.Cpu.Recompiler.EnableVU1 && EmuConfig.Speedhacks.vuThread)
+#define THREAD_VU0   (CHECK_EEREC && EmuConfig.Cpu.Recompiler.EnableVU0 && EmuConfig.CurrentVU0Thread)
 #define INSTANT_VU1  (EmuConfig.Speedhacks.vu1Instant)
+#define VIF_TRACE    (EmuConfig.Speedhacks.vifTraceCache)
 #define CHECK_EEREC  (EmuConfig.Cpu.Recompiler.EnableEE)
 #define CHECK_CACHE  (EmuConfig.Cpu.Recompiler.EnableEECache)
 #define CHECK_IOPREC (EmuConfig.Cpu.Recompiler.EnableIOP)
@@ -16,6 +16,7 @@
 
 #include "ps2/HwInternal.h"
 #include "Sio.h"
+#include "common/Tracing.h"
 
 
 using namespace Threading;
@@ -378,10 +379,27 @@ static __fi void frameLimit()
     frameLimitUpdateCore();
 }
 
+// EE frames are traced vsync to vsync rather than zoning the event test, which runs far too often to record
+static u64 s_traceFrameStart = 0;
+
 static __fi void VSyncStart(u32 sCycle)
 {
+    if (Tracing::IsEnabled()) {
+        const u64 now = Tracing::Timestamp();
+        if (s_traceFrameStart)
+            Tracing::AddZone("EE Frame", s_traceFrameStart, now);
+        s_traceFrameStart = now;
+        Tracing::AddCounter("EE Blocks Compiled", g_eeRecStats.BlocksCompiled);
+        Tracing::AddCounter("IOP Blocks Compiled", g_iopRecStats.BlocksCompiled);
+        Tracing::AddCounter("EE Code Cache KB", g_eeRecStats.CacheUsed / _1kb);
+        Tracing::AddCounter("IOP Code Cache KB", g_iopRecStats.CacheUsed / _1kb);
+        Tracing::AddCounter("VU1 Code Cache KB", g_vuRecStats[1].CacheUsed / _1kb);
+    }
 
-    frameLimit();
+    {
+        TRACE_ZONE("Frame Limiter");
+        frameLimit();
+    }
     gsPostVsyncStart();
 
 
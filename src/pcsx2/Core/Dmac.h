@@ -567,5 +567,33 @@ extern void hwDmacSrcTadrInc(DMACh& dma);
 extern bool hwDmacSrcChainWithStack(DMACh& dma, int id);
 extern bool hwDmacSrcChain(DMACh& dma, int id);
 
+// --------------------------------------------------------------------------------------
+//  DMAChainWalk
+// --------------------------------------------------------------------------------------
+// The run of source chain tags starting at a channel's TADR that the channel can follow
+// back to back, without anything needing the DMAC to stop in between: CNT, NEXT and REF
+// tags without IRQ+TIE, plus a final END or REFE. CALL/RET (the stack lives in ASR0/1),
+// REFS (stall control), tags or data outside of main RAM and anything over maxqwc end the
+// walk. The channel isn't touched, it still reads each tag itself when it gets to it.
+//
+struct DMAChainSegment
+{
+	u32 tadr; // where the tag is
+	u32 madr; // where its data is
+	u32 qwc;
+};
+
+static const uint DMAChainMaxSegments = 32;
+
+struct DMAChainWalk
+{
+	DMAChainSegment seg[DMAChainMaxSegments];
+	uint count;
+	u32 qwc;   // data over all the segments
+	bool done; // the last segment ends the chain
+};
+
+extern void hwDmacWalkSrcChain(const DMACh& dma, DMAChainWalk& walk, u32 maxqwc);
+
 template< uint page > u32 dmacRead32( u32 mem );
 template< uint page > extern bool dmacWrite32( u32 mem, mem32_t& value );
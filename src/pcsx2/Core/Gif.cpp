@@ -21,6 +21,7 @@
 #include "Vif_Dma.h"
 
 #include "iR5900.h"
+#include "common/Tracing.h"
 
 // A three-way toggle used to determine if the GIF is stalling (transferring) or done (finished).
 // Should be a gifstate_t rather then int, but I don't feel like possibly interfering with savestates right now.
@@ -209,6 +210,7 @@ __fi void gifCheckPathStatus(bool calledFromGIF)
 
 __fi void gifInterrupt()
 {
+    TRACE_ZONE("GIF DMA");
     // GIF_LOG("gifInterrupt caught qwc=%d fifo=%d(%d) apath=%d oph=%d state=%d!", gifch.qwc, gifRegs.stat.FQC,
     //         gif_fifo.fifoSize, gifRegs.stat.APATH, gifRegs.stat.OPH, gifUnit.gifPath[GIF_PATH_3].state);
     gifCheckPathStatus(false);
@@ -374,6 +376,43 @@ static __fi tDMA_TAG *ReadTag2()
     return ptag;
 }
 
+// Data a chain can stream in one event, what the SPR moves in a single step, so the other
+// channels and paths still get in regularly.
+static const u32 GIFChainStreamQWC = 0x400;
+
+// Once a tag's data went through, follows the rest of the chain without an event for every tag,
+// see DMAChainWalk. Stops when PATH3 can't take everything, or another path or the VIF is waiting
+// for it, and leaves the rest to GIFdma.
+static void GIFchainStream()
+{
+    if (gifch.chcr.MOD != CHAIN_MODE || gifch.qwc || gif.gspath3done || gifRegs.stat.IMT || gifRegs.ctrl.PSE ||
+        dmacRegs.ctrl.STD == STD_GIF || !dmacRegs.ctrl.DMAE)
+        return;
+
+    DMAChainWalk walk;
+    hwDmacWalkSrcChain(gifch, walk, GIFChainStreamQWC);
+
+    const u32 cycles = gif.gscycles;
+    for (uint i = 0; i < walk.count; i++) {
+        if (!gifUnit.CanDoPath3() || gif_fifo.fifoSize || vif1Regs.stat.VGW || gifUnit.checkPaths(1, 1, 0) ||
+            gifch.tadr != walk.seg[i].tadr)
+            break;
+
+        if (!ReadTag())
+            return;
+        gifRegs.stat.FQC = std::min((u32)0x10, gifch.qwc);
+        CalculateFIFOCSR();
+
+        if (gifch.qwc)
+            gif.gscycles += WRITERING_DMA((u32 *)dmaGetAddr(gifch.madr, false), gifch.qwc) * BIAS;
+        if (gifch.qwc || gif.gspath3done)
+            break;
+    }
+
+    if (gif.gscycles != cycles && (!gifUnit.Path3Masked() || (gif_fifo.fifoSize < 16)))
+        GifDMAInt(gif.gscycles);
+}
+
 void GIFdma()
 {
     while (gifch.qwc > 0 || !gif.gspath3done) {
@@ -437,6 +476,7 @@ void GIFdma()
         if (gifch.qwc > 0)    // Normal Mode
         {
             GIFchain();    // Transfers the data set by the switch
+            GIFchainStream();
             return;
         }
     }
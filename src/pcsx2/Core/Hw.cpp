@@ -395,3 +395,67 @@ bool hwDmacSrcChain(DMACh &dma, int id)
 
     return false;
 }
+
+static __fi bool hwDmacInMainRam(u32 addr, u32 qwc)
+{
+    if (DMA_TAG(addr).SPR)
+        return false;
+
+    addr &= 0x1ffffff0;
+    return addr < Ps2MemSize::MainRam && qwc <= (Ps2MemSize::MainRam - addr) / 16;
+}
+
+// Follows the chain the way hwDmacSrcChain and hwDmacSrcTadrInc move TADR, see DMAChainWalk.
+void hwDmacWalkSrcChain(const DMACh &dma, DMAChainWalk &walk, u32 maxqwc)
+{
+    u32 tadr   = dma.tadr;
+    walk.count = 0;
+    walk.qwc   = 0;
+    walk.done  = false;
+
+    while (walk.count < DMAChainMaxSegments && hwDmacInMainRam(tadr, 1)) {
+        const tDMA_TAG *ptag = (tDMA_TAG *)&eeMem->Main[tadr & 0x1ffffff0];
+        const u32       qwc  = ptag[0].QWC;
+        if ((dma.chcr.TIE && ptag[0].IRQ) || walk.qwc + qwc > maxqwc)
+            return;
+
+        u32  madr = ptag[1]._u32;
+        u32  next = 0;
+        bool end  = false;
+        switch (ptag[0].ID) {
+            case TAG_CNT:
+                madr = tadr + 16;
+                next = madr + qwc * 16;
+                break;
+            case TAG_NEXT:
+                madr = tadr + 16;
+                next = ptag[1]._u32;
+                break;
+            case TAG_REF:
+                next = tadr + 16;
+                break;
+            case TAG_END:
+                madr = tadr + 16;
+                end  = true;
+                break;
+            case TAG_REFE:
+                end = true;
+                break;
+            default:    // CALL, RET, REFS and the undefined ones
+                return;
+        }
+        if (!hwDmacInMainRam(madr, qwc))
+            return;
+
+        DMAChainSegment &seg = walk.seg[walk.count++];
+        seg.tadr             = tadr;
+        seg.madr             = madr;
+        seg.qwc              = qwc;
+        walk.qwc += qwc;
+        if (end) {
+            walk.done = true;
+            return;
+        }
+        tadr = next;
+    }
+}
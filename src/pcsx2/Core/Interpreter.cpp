@@ -22,10 +22,13 @@
 #include "System/SysThreads.h"
 
 #include "Elfheader.h"
+#include "common/ScopedGuard.h"
 
 // #include "DebugTools/Breakpoints.h"
 
 #include <float.h>
+#include <algorithm>
+#include <memory>
 
 using namespace R5900;    // for OPCODE and OpcodeImpl
 
@@ -37,6 +40,86 @@ static std::string disOut;
 
 static void intEventTest();
 
+// --------------------------------------------------------------------------------------
+//  Predecoded pages
+// --------------------------------------------------------------------------------------
+// Each RAM page the interpreter runs code from keeps the OPCODE of every word it decoded, and
+// execI() dispatches straight through it while the pc stays in the page. Decoded words are
+// write protected the same way as recompiled code: a write faults into mmap_ClearCpuBlock(),
+// which calls intClear(), and the page decodes again the next time it runs. Pages that keep
+// mixing code and data writes, or that the TLB maps elsewhere, go through memRead32() and
+// the opcode tables every time.
+//
+// Only intExecute() uses them, the EE rec runs execI() too and clears its own blocks.
+//
+static std::unique_ptr<const OPCODE *[]> s_intPages[Ps2MemSize::MainRam >> 12];
+
+static bool           s_intUsePages    = false;
+static u32            s_intPageVaddr   = ~0u;    // pc >> 12 of the page below, ~0 if none
+static u32            s_intNoPageVaddr = ~0u;    // pc >> 12 of the last page that can't be predecoded
+static const OPCODE **s_intPage        = nullptr;
+static const u32     *s_intPageCode    = nullptr;
+static u32            s_intPagePaddr   = 0;
+
+static void intResetPages()
+{
+    s_intPageVaddr   = ~0u;
+    s_intNoPageVaddr = ~0u;
+    for (auto &page : s_intPages)
+        page.reset();
+}
+
+// Makes the page of pc the current one, false if it can't be predecoded
+static bool intEnterPage(u32 pc)
+{
+    s_intPageVaddr = ~0u;
+    if ((pc >> 12) == s_intNoPageVaddr)
+        return false;
+    s_intNoPageVaddr = pc >> 12;
+
+    // The kernel keeps thread stacks and contexts in these, the rec doesn't protect them either
+    if ((pc >> 12) == 0x81 || (pc >> 12) == 0x80001)
+        return false;
+
+    const u32 paddr = pc & 0x1ffff000;
+
+    const vtlb_private::VTLBVirtual vmv = vtlb_private::vtlbdata.vmap[pc >> 12];
+    if (vmv.isHandler(pc & ~0xfff))
+        return false;
+    u8 *host = (u8 *)vmv.assumePtr(pc & ~0xfff);
+    if (host != PSM(paddr))
+        return false;
+    const uptr offset = host - eeMem->Main;
+    if (offset >= Ps2MemSize::MainRam)
+        return false;
+    if (mmap_GetRamPageInfo(paddr) == ProtMode_Manual && mmap_IsMixedRamPage(paddr))
+        return false;
+
+    std::unique_ptr<const OPCODE *[]> &page = s_intPages[offset >> 12];
+    if (!page)
+        page.reset(new const OPCODE *[0x400]());
+
+    s_intNoPageVaddr = ~0u;
+    s_intPageVaddr   = pc >> 12;
+    s_intPage        = page.get();
+    s_intPageCode    = (const u32 *)host;
+    s_intPagePaddr   = paddr;
+    return true;
+}
+
+static __ri const OPCODE &intDecode(u32 pc)
+{
+    cpuRegs.code         = memRead32(pc);
+    const OPCODE &opcode = GetCurrentInstruction();
+
+    if (s_intUsePages && ((pc >> 12) == s_intPageVaddr || intEnterPage(pc))) {
+        // Protects the page, or re-protects it after a write that missed its code
+        mmap_MarkCountedRamPage(s_intPagePaddr | (pc & 0xffc), 4);
+        s_intPage[(pc >> 2) & 0x3ff] = &opcode;
+    }
+    return opcode;
+}
+
 // These macros are used to assemble the repassembler functions
 
 static void debugI()
@@ -147,14 +230,15 @@ static void execI()
     cpuRegs.pc += 4;
 
     // interprete instruction
-    cpuRegs.code = memRead32(pc);
+    const OPCODE *predecoded = (pc >> 12) == s_intPageVaddr ? s_intPage[(pc >> 2) & 0x3ff] : nullptr;
+    if (predecoded)
+        cpuRegs.code = s_intPageCode[(pc >> 2) & 0x3ff];
+    const OPCODE &opcode = predecoded ? *predecoded : intDecode(pc);
     // Honestly I think this code is useless nowadays.
 #ifdef EXTRA_DEBUG
     if (IsDebugBuild)
         debugI();
 #endif
-
-    const OPCODE &opcode = GetCurrentInstruction();
 #if 0
 	static long int runs = 0;
 	//use this to find out what opcodes your game uses. very slow! (rama)
@@ -227,6 +311,21 @@ void intSetBranch()
     branch2 = /*cpuRegs.branch =*/1;
 }
 
+// Runs the instructions from cpuRegs.pc up to the end of the next taken branch (delay slot included)
+// or until an exception moves the pc. Used by the EE rec for blocks that aren't worth compiling yet.
+void intExecuteBlock()
+{
+    u32 next;
+    branch2 = 0;
+    do {
+        next = cpuRegs.pc + 4;
+        execI();
+    } while (!branch2 && cpuRegs.pc == next);
+
+    cpuRegs.cycle += cpuBlockCycles >> 3;
+    cpuBlockCycles &= (1 << 3) - 1;
+}
+
 ////////////////////////////////////////////////////////////////////
 // R5900 Branching Instructions!
 // These are the interpreter versions of the branch instructions.  Unlike other
@@ -468,6 +567,8 @@ static void intReset()
 {
     cpuRegs.branch = 0;
     branch2        = 0;
+
+    intResetPages();
 }
 
 static void intEventTest()
@@ -486,6 +587,14 @@ static void intExecute()
         GAME_RUNNING
     };
     ExecuteState state = RESET;
+
+    // Memory may have changed under the rec or a savestate since the pages were decoded
+    intResetPages();
+    s_intUsePages = true;
+    ScopedGuard usePages([] {
+        s_intUsePages = false;
+        intResetPages();
+    });
     do {
         instruction_was_cancelled = false;
         try {
@@ -497,6 +606,8 @@ static void intExecute()
                         execI();
                     while (cpuRegs.pc != (g_eeloadMain ? g_eeloadMain : EELOAD_START));
                     if (cpuRegs.pc == EELOAD_START) {
+                        eeloadStartHook();
+
                         // The EELOAD _start function is the same across all BIOS versions afaik
                         u32 mainjump = memRead32(EELOAD_START + 0x9c);
                         if (mainjump >> 26 == 3)    // JAL
@@ -561,12 +672,21 @@ static void intStep()
     execI();
 }
 
+// Addr is physical and Size in words, like for the recs
 static void intClear(u32 Addr, u32 Size)
 {
+    s_intPageVaddr   = ~0u;
+    s_intNoPageVaddr = ~0u;
+    for (u32 paddr = Addr & ~0xfff; paddr < Addr + Size * 4; paddr += 0x1000) {
+        const uptr offset = (uptr)PSM(paddr) - (uptr)eeMem->Main;
+        if (offset < Ps2MemSize::MainRam && s_intPages[offset >> 12])
+            std::fill_n(s_intPages[offset >> 12].get(), 0x400, nullptr);
+    }
 }
 
 static void intShutdown()
 {
+    intResetPages();
 }
 
 static void intThrowException(const BaseR5900Exception &ex)
@@ -0,0 +1,501 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Core/PrecompiledHeader.h"
+#include "Common.h"
+#include "Lockstep.h"
+#include "IopCommon.h"
+#include "MTVU.h"
+#include "R5900OpcodeTables.h"
+#include "SaveState.h"
+#include "VUmicro.h"
+
+#include <atomic>
+
+// Lines of differences in the report, the first few are the interesting ones
+static const int MaxReportedDiffs = 64;
+
+// The state both sides are compared on. Memory is hashed per page, so the report can say where it differs.
+struct LockstepDigest
+{
+    u32     cycle;
+    u32     pc;
+    u32     code;    // instruction word at pc
+    GPRregs gpr;
+    GPR_reg hi;
+    GPR_reg lo;
+    CP0regs cp0;
+    u32     sa;
+    FPRreg  fpr[32];
+    u32     fprc[32];
+    FPRreg  fpuAcc;
+
+    u32     psxPc;
+    u32     psxCycle;
+    GPRRegs psxGpr;
+    CP0Regs psxCp0;
+    CP2Data psxCp2d;
+    CP2Ctrl psxCp2c;
+
+    VECTOR vf[2][32];
+    REG_VI vi[2][32];
+    VECTOR vuAcc[2];
+
+    u64 eeRam[Ps2MemSize::MainRam >> 12];
+    u64 iopRam[Ps2MemSize::IopRam >> 12];
+    u64 scratch;
+    u64 eeHardware;
+    u64 iopHardware;
+    u64 vuMem[2];
+    u64 vuMicro[2];
+};
+
+static LockstepOptions   s_options;
+static std::atomic<bool> s_active(false);
+static std::atomic<bool> s_finished(false);
+
+// everything below is only touched by the core thread
+static bool                           s_haveRecompilers = false;
+static Pcsx2Config::RecompilerOptions s_recompilers;    // what the rec side runs with
+static VmStateBuffer                  s_snapshot(L"Lockstep Snapshot");
+static u32                            s_skipped      = 0;
+static u32                            s_frames       = 0;
+static bool                           s_vsync        = false;    // break at the end of the next event test
+static bool                           s_breakAtCycle = false;    // break at the first event test past s_breakCycle
+static u32                            s_breakCycle   = 0;
+static bool                           s_breakNow     = false;
+static LockstepDigest                 s_startDigest;    // the snapshot
+static LockstepDigest                 s_recDigest;
+static LockstepDigest                 s_interpDigest;
+
+static u64 HashMemory(const void *data, size_t size)
+{
+    const u64 *words = (const u64 *)data;
+    u64        hash  = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size / 8; i++)
+        hash = (hash ^ words[i]) * 0x100000001b3ull;
+    return hash;
+}
+
+// The word the EE fetches at pc, 0 if it isn't backed by memory
+static u32 ReadCode(u32 pc)
+{
+    const vtlb_private::VTLBVirtual vmv = vtlb_private::vtlbdata.vmap[pc >> 12];
+    return vmv.isHandler(pc) ? 0 : *(const u32 *)vmv.assumePtr(pc);
+}
+
+static void TakeDigest(LockstepDigest &digest)
+{
+    vu0Thread.WaitVU();
+    vu0Thread.Get_MTVUChanges();
+    vu1Thread.WaitVU();
+
+    digest.cycle = cpuRegs.cycle;
+    digest.pc    = cpuRegs.pc;
+    digest.code  = ReadCode(cpuRegs.pc);
+    digest.gpr   = cpuRegs.GPR;
+    digest.hi    = cpuRegs.HI;
+    digest.lo    = cpuRegs.LO;
+    digest.cp0   = cpuRegs.CP0;
+    digest.sa    = cpuRegs.sa;
+    memcpy(digest.fpr, fpuRegs.fpr, sizeof(digest.fpr));
+    memcpy(digest.fprc, fpuRegs.fprc, sizeof(digest.fprc));
+    digest.fpuAcc = fpuRegs.ACC;
+
+    digest.psxPc    = psxRegs.pc;
+    digest.psxCycle = psxRegs.cycle;
+    digest.psxGpr   = psxRegs.GPR;
+    digest.psxCp0   = psxRegs.CP0;
+    digest.psxCp2d  = psxRegs.CP2D;
+    digest.psxCp2c  = psxRegs.CP2C;
+
+    for (int vu = 0; vu < 2; vu++) {
+        memcpy(digest.vf[vu], vuRegs[vu].VF, sizeof(digest.vf[vu]));
+        memcpy(digest.vi[vu], vuRegs[vu].VI, sizeof(digest.vi[vu]));
+        digest.vuAcc[vu] = vuRegs[vu].ACC;
+    }
+
+    for (u32 page = 0; page < Ps2MemSize::MainRam >> 12; page++)
+        digest.eeRam[page] = HashMemory(&eeMem->Main[page << 12], 0x1000);
+    for (u32 page = 0; page < Ps2MemSize::IopRam >> 12; page++)
+        digest.iopRam[page] = HashMemory(&iopMem->Main[page << 12], 0x1000);
+    digest.scratch     = HashMemory(eeMem->Scratch, Ps2MemSize::Scratch);
+    digest.eeHardware  = HashMemory(eeHw, Ps2MemSize::Hardware);
+    digest.iopHardware = HashMemory(iopHw, Ps2MemSize::IopHardware);
+    digest.vuMem[0]    = HashMemory(vuRegs[0].Mem, VU0_MEMSIZE);
+    digest.vuMem[1]    = HashMemory(vuRegs[1].Mem, VU1_MEMSIZE);
+    digest.vuMicro[0]  = HashMemory(vuRegs[0].Micro, VU0_PROGSIZE);
+    digest.vuMicro[1]  = HashMemory(vuRegs[1].Micro, VU1_PROGSIZE);
+}
+
+// --------------------------------------------------------------------------------------
+//  Comparison
+// --------------------------------------------------------------------------------------
+// Counts the differences between both sides, and describes them when fp isn't null.
+
+class DigestDiff
+{
+public:
+    DigestDiff(FILE *fp) : m_fp(fp)
+    {
+    }
+
+    int Count() const
+    {
+        return m_diffs;
+    }
+
+    // name[index]: rec <words> interp <words>, for registers
+    void Words(const char *name, int index, const void *rec, const void *interp, size_t size)
+    {
+        if (!memcmp(rec, interp, size) || !Add())
+            return;
+        fprintf(m_fp, "  %s", name);
+        if (index >= 0)
+            fprintf(m_fp, "[%d]", index);
+        fprintf(m_fp, ":%*s rec", index >= 0 ? 1 : 5, "");
+        for (size_t i = size / 4; i--;)
+            fprintf(m_fp, " %08x", ((const u32 *)rec)[i]);
+        fprintf(m_fp, "  interp");
+        for (size_t i = size / 4; i--;)
+            fprintf(m_fp, " %08x", ((const u32 *)interp)[i]);
+        fprintf(m_fp, "\n");
+    }
+
+    template <typename T>
+    void Value(const char *name, int index, const T &rec, const T &interp)
+    {
+        Words(name, index, &rec, &interp, sizeof(T));
+    }
+
+    // Hashes of memory blocks, page is the address of the first one
+    void Pages(const char *name, const u64 *rec, const u64 *interp, u32 count, u32 pageSize = 0x1000)
+    {
+        for (u32 i = 0; i < count; i++) {
+            if (rec[i] != interp[i] && Add())
+                fprintf(m_fp, "  %s 0x%08x-0x%08x differs\n", name, i * pageSize, (i + 1) * pageSize - 1);
+        }
+    }
+
+private:
+    bool Add()
+    {
+        if (++m_diffs == MaxReportedDiffs + 1 && m_fp)
+            fprintf(m_fp, "  ...\n");
+        return m_fp && m_diffs <= MaxReportedDiffs;
+    }
+
+    FILE *m_fp;
+    int   m_diffs = 0;
+};
+
+static int CompareDigests(FILE *fp, const LockstepDigest &rec, const LockstepDigest &interp)
+{
+    DigestDiff diff(fp);
+
+    diff.Value("EE cycle", -1, rec.cycle, interp.cycle);
+    diff.Value("EE pc", -1, rec.pc, interp.pc);
+    for (int i = 0; i < 32; i++)
+        diff.Value("EE GPR", i, rec.gpr.r[i], interp.gpr.r[i]);
+    diff.Value("EE HI", -1, rec.hi, interp.hi);
+    diff.Value("EE LO", -1, rec.lo, interp.lo);
+    diff.Value("EE SA", -1, rec.sa, interp.sa);
+    for (int i = 0; i < 32; i++)
+        diff.Value("EE COP0", i, rec.cp0.r[i], interp.cp0.r[i]);
+    for (int i = 0; i < 32; i++)
+        diff.Value("FPU FPR", i, rec.fpr[i], interp.fpr[i]);
+    for (int i = 0; i < 32; i++)
+        diff.Value("FPU FCR", i, rec.fprc[i], interp.fprc[i]);
+    diff.Value("FPU ACC", -1, rec.fpuAcc, interp.fpuAcc);
+
+    diff.Value("IOP cycle", -1, rec.psxCycle, interp.psxCycle);
+    diff.Value("IOP pc", -1, rec.psxPc, interp.psxPc);
+    for (int i = 0; i < 34; i++)
+        diff.Value("IOP GPR", i, rec.psxGpr.r[i], interp.psxGpr.r[i]);
+    for (int i = 0; i < 32; i++)
+        diff.Value("IOP COP0", i, rec.psxCp0.r[i], interp.psxCp0.r[i]);
+    for (int i = 0; i < 32; i++)
+        diff.Value("IOP GTE data", i, rec.psxCp2d.r[i], interp.psxCp2d.r[i]);
+    for (int i = 0; i < 32; i++)
+        diff.Value("IOP GTE ctrl", i, rec.psxCp2c.r[i], interp.psxCp2c.r[i]);
+
+    static const char *const vfNames[2] = {"VU0 VF", "VU1 VF"};
+    static const char *const viNames[2] = {"VU0 VI", "VU1 VI"};
+    static const char *const accNames[2] = {"VU0 ACC", "VU1 ACC"};
+    for (int vu = 0; vu < 2; vu++) {
+        for (int i = 0; i < 32; i++)
+            diff.Value(vfNames[vu], i, rec.vf[vu][i], interp.vf[vu][i]);
+        for (int i = 0; i < 32; i++)
+            diff.Value(viNames[vu], i, rec.vi[vu][i].UL, interp.vi[vu][i].UL);
+        diff.Value(accNames[vu], -1, rec.vuAcc[vu], interp.vuAcc[vu]);
+    }
+
+    diff.Pages("EE RAM", rec.eeRam, interp.eeRam, Ps2MemSize::MainRam >> 12);
+    diff.Pages("IOP RAM", rec.iopRam, interp.iopRam, Ps2MemSize::IopRam >> 12);
+    diff.Pages("Scratchpad", &rec.scratch, &interp.scratch, 1, Ps2MemSize::Scratch);
+    diff.Pages("EE hardware registers", &rec.eeHardware, &interp.eeHardware, 1, Ps2MemSize::Hardware);
+    diff.Pages("IOP hardware registers", &rec.iopHardware, &interp.iopHardware, 1, Ps2MemSize::IopHardware);
+    diff.Pages("VU0 data", &rec.vuMem[0], &interp.vuMem[0], 1, VU0_MEMSIZE);
+    diff.Pages("VU1 data", &rec.vuMem[1], &interp.vuMem[1], 1, VU1_MEMSIZE);
+    diff.Pages("VU0 micro", &rec.vuMicro[0], &interp.vuMicro[0], 1, VU0_PROGSIZE);
+    diff.Pages("VU1 micro", &rec.vuMicro[1], &interp.vuMicro[1], 1, VU1_PROGSIZE);
+    return diff.Count();
+}
+
+static bool DigestsMatch(const LockstepDigest &rec, const LockstepDigest &interp)
+{
+    return !CompareDigests(nullptr, rec, interp);
+}
+
+// --------------------------------------------------------------------------------------
+//  Runs
+// --------------------------------------------------------------------------------------
+
+static void UseRecompilers(bool rec)
+{
+    EmuConfig.Cpu.Recompiler = s_recompilers;
+    if (!rec) {
+        EmuConfig.Cpu.Recompiler.EnableEE  = false;
+        EmuConfig.Cpu.Recompiler.EnableIOP = false;
+        EmuConfig.Cpu.Recompiler.EnableVU0 = false;
+        EmuConfig.Cpu.Recompiler.EnableVU1 = false;
+    }
+}
+
+static void TakeSnapshot()
+{
+    SaveState_SaveToMemory(s_snapshot);
+    TakeDigest(s_startDigest);
+}
+
+// Restores the snapshot on one side and runs it to the next break, false if the cpu stopped for something else
+static bool RunFromSnapshot(bool rec, LockstepDigest &digest)
+{
+    // Loading applies the cpu config and clears the recompilers
+    UseRecompilers(rec);
+    SaveState_LoadFromMemory(s_snapshot);
+
+    Cpu->Execute();
+    if (!s_breakNow)
+        return false;
+    s_breakNow = false;
+    TakeDigest(digest);
+    return true;
+}
+
+// Both sides to the first event test past the target. The interpreters only test events after branches, when a
+// recompiled block ends elsewhere the sides stop at different cycles and run again to the later of the two.
+// recDone skips the first rec run, s_recDigest already holds the rec side stopped at the target.
+static bool RunPair(u32 target, bool &stopped, bool recDone = false)
+{
+    s_breakAtCycle = true;
+    for (int tries = 0; tries < 4; tries++) {
+        s_breakCycle = target;
+        if ((!recDone && !RunFromSnapshot(true, s_recDigest)) || !RunFromSnapshot(false, s_interpDigest)) {
+            stopped = true;
+            break;
+        }
+        recDone = false;
+        if (s_recDigest.cycle == s_interpDigest.cycle)
+            break;
+        target = (s32)(s_recDigest.cycle - s_interpDigest.cycle) > 0 ? s_recDigest.cycle : s_interpDigest.cycle;
+    }
+    s_breakAtCycle = false;
+    return !stopped && DigestsMatch(s_recDigest, s_interpDigest);
+}
+
+// The frame from the snapshot differs at its end, narrow it down to the last event test both sides agree at.
+// Returns false if execution stopped for something else.
+static bool Bisect()
+{
+    u32  lo      = s_startDigest.cycle;
+    u32  hi      = s_recDigest.cycle;
+    bool stopped = false;
+
+    while ((s32)(hi - lo) > 1) {
+        const u32 mid = lo + (hi - lo) / 2;
+        if (RunPair(mid, stopped)) {
+            // Can't get closer at event test granularity
+            if ((s32)(s_recDigest.cycle - hi) >= 0)
+                break;
+            // The interpreters ran last, their state is the one both agree on
+            lo = s_recDigest.cycle;
+            TakeSnapshot();
+        } else if (stopped)
+            return false;
+        else
+            hi = mid;
+    }
+
+    // The first event test past the last matching one, for the differences in the report
+    RunPair(lo + 1, stopped);
+    return !stopped;
+}
+
+// --------------------------------------------------------------------------------------
+//  Report
+// --------------------------------------------------------------------------------------
+
+static void WriteReport(bool diverged)
+{
+    FILE *fp = fopen(s_options.Report.ToUTF8(), "w");
+    if (!fp) {
+        Console.Error(L"Lockstep: cannot write the report to '%s'", WX_STR(s_options.Report));
+        return;
+    }
+
+    fprintf(fp, "Lockstep: %u frames matched\n", s_frames);
+    if (diverged) {
+        const LockstepDigest &start = s_startDigest;
+        fprintf(fp, "Frame %u differs\n\n", s_frames + 1);
+        fprintf(fp, "Last matching event test: EE cycle %u, pc 0x%08x: %08x %s, IOP pc 0x%08x\n", start.cycle,
+                start.pc, start.code, R5900::GetInstruction(start.code).Name, start.psxPc);
+        fprintf(fp, "Next event test:          rec EE cycle %u pc 0x%08x, interp EE cycle %u pc 0x%08x\n\n",
+                s_recDigest.cycle, s_recDigest.pc, s_interpDigest.cycle, s_interpDigest.pc);
+        fprintf(fp, "Differences (%d):\n", CompareDigests(nullptr, s_recDigest, s_interpDigest));
+        CompareDigests(fp, s_recDigest, s_interpDigest);
+    }
+    fclose(fp);
+
+    if (diverged)
+        Console.Error(L"Lockstep: frame %u differs at EE pc 0x%08x, report written to '%s'", s_frames + 1,
+                      s_startDigest.pc, WX_STR(s_options.Report));
+    else
+        Console.WriteLn(Color_StrongGreen, L"Lockstep: %u frames matched, report written to '%s'", s_frames,
+                        WX_STR(s_options.Report));
+}
+
+// Back to the recompilers, from whatever state the last run left
+static void Stop()
+{
+    s_active       = false;
+    s_breakAtCycle = false;
+    s_vsync        = false;
+    UseRecompilers(true);
+    SysClearExecutionCache();
+}
+
+static void Finish(bool diverged)
+{
+    WriteReport(diverged);
+    Stop();
+    s_finished.store(true, std::memory_order_release);
+}
+
+// --------------------------------------------------------------------------------------
+//  Interface
+// --------------------------------------------------------------------------------------
+
+void Lockstep_Start(const LockstepOptions &options)
+{
+    s_options = options;
+    s_active  = true;
+    s_finished.store(false);
+    s_skipped = 0;
+    s_frames  = 0;
+}
+
+bool Lockstep_IsActive()
+{
+    return s_active;
+}
+
+bool Lockstep_IsFinished()
+{
+    return s_finished.load(std::memory_order_acquire);
+}
+
+void Lockstep_Vsync()
+{
+    if (!s_active || s_breakAtCycle || s_finished.load(std::memory_order_relaxed))
+        return;
+    if (s_skipped < s_options.Skip) {
+        s_skipped++;
+        return;
+    }
+    s_vsync = true;
+}
+
+// The vsync itself is too early, the frame limiter checks the execution state in the middle of the event test.
+void Lockstep_EventTest()
+{
+    if (!s_active)
+        return;
+
+    if (s_breakAtCycle) {
+        const s32 left = (s32)(s_breakCycle - cpuRegs.cycle);
+        if (left > 0) {
+            cpuSetNextEventDelta(left);
+            return;
+        }
+    } else if (!s_vsync)
+        return;
+
+    s_vsync    = false;
+    s_breakNow = true;
+    Cpu->CheckExecutionState();
+}
+
+bool Lockstep_BreakPending()
+{
+    return s_breakNow;
+}
+
+void Lockstep_Boundary()
+{
+    if (!s_breakNow)
+        return;
+    s_breakNow = false;
+
+    if (!s_haveRecompilers) {
+        s_recompilers     = EmuConfig.Cpu.Recompiler;
+        s_haveRecompilers = true;
+    }
+
+    try {
+        TakeSnapshot();
+        while (true) {
+            // The rec side runs to the vsync, then the interpreters are pinned to the cycle it stopped at, a frame
+            // is only bisected when the state differs at the same event test
+            bool stopped = false;
+            if (!RunFromSnapshot(true, s_recDigest))
+                break;
+            const bool match = RunPair(s_recDigest.cycle, stopped, true);
+            if (stopped)
+                break;
+
+            if (!match) {
+                if (!Bisect())
+                    break;
+                Finish(true);
+                return;
+            }
+
+            if (++s_frames == s_options.Frames) {
+                Finish(false);
+                return;
+            }
+            // The interpreters ran last, their state is the one both agree on
+            TakeSnapshot();
+        }
+    } catch (...) {
+        Stop();
+        throw;
+    }
+
+    // Something else stopped the cpu in the middle of a run, the frames can't be compared anymore
+    Console.Warning("Lockstep: execution was interrupted after %u matching frames, stopping", s_frames);
+    Stop();
+}
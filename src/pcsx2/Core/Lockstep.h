@@ -0,0 +1,41 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// --------------------------------------------------------------------------------------
+//  Lockstep
+// --------------------------------------------------------------------------------------
+// Runs every frame twice from the same in-memory snapshot, once with the recompilers the
+// config asks for and once on the interpreters, and compares the registers of all the cpus
+// and hashes of their memory at the vsync. The first frame that differs is narrowed down
+// to the last EE event test both sides agree at, and the report names the pc there.
+//
+struct LockstepOptions
+{
+    u32      Skip   = 0;    // frames run normally before the comparison starts
+    u32      Frames = 0;    // stop after this many matching frames, 0 for no limit
+    wxString Report = L"lockstep.txt";
+};
+
+extern void Lockstep_Start(const LockstepOptions &options);
+extern bool Lockstep_IsActive();
+extern bool Lockstep_IsFinished();
+
+// Core thread only
+extern void Lockstep_Vsync();           // once per frame
+extern void Lockstep_EventTest();       // at the end of every EE event test
+extern bool Lockstep_BreakPending();    // Cpu->Execute() has to return at its next state check
+extern void Lockstep_Boundary();        // after Cpu->Execute() returned
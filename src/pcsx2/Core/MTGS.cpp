@@ -11,6 +11,7 @@
 #include "Elfheader.h"
 #include "gui/main.h"
 // #include "gui/AppCoreThread.h"
+#include "common/Tracing.h"
 #include "common/WindowInfo.h"
 extern WindowInfo g_gs_window_info;
 
@@ -28,6 +29,9 @@ using namespace Threading;
 
 __aligned(32) MTGS_BufferedData RingBuffer;
 
+static WaitSite s_waitGS("MTGS Wait");
+static WaitSite s_weakWaitGS("MTGS Weak Wait");
+
 #ifdef RINGBUF_DEBUG_STACK
 #include <list>
 std::list<uint> ringposStack;
@@ -266,6 +270,7 @@ void SysMtgsThread::ExecuteTaskInThread()
         m_sem_event.WaitWithoutYield();
         StateCheckInThread();
         busy.Acquire();
+        TRACE_ZONE("MTGS Ring");
 
         while (m_ReadPos.load(std::memory_order_relaxed) != m_WritePos.load(std::memory_order_acquire)) {
             const unsigned int local_ReadPos = m_ReadPos.load(std::memory_order_relaxed);
@@ -531,19 +536,32 @@ void SysMtgsThread::WaitGS(bool syncRegs, bool weakWait, bool isMTVU)
 
 
     if (isMTVU || m_ReadPos.load(std::memory_order_relaxed) != m_WritePos.load(std::memory_order_relaxed)) {
+        TRACE_ZONE("MTGS Wait");
         SetEvent();
         RethrowException();
-        for (;;) {
-            if (weakWait)
+        if (!weakWait) {
+            // The ring is often drained within microseconds, spin before sleeping on the busy lock
+            s_waitGS.Wait(
+                [&] {
+                    return m_ReadPos.load(std::memory_order_acquire) == m_WritePos.load(std::memory_order_relaxed);
+                },
+                [&] {
+                    m_mtx_RingBufferBusy.Wait();
+                    RethrowException();
+                });
+        } else {
+            // Waits for the MTGS to let go of the ring at least once
+            s_weakWaitGS.Block();
+            for (;;) {
                 m_mtx_RingBufferBusy2.Wait();
-            else
-                m_mtx_RingBufferBusy.Wait();
-            RethrowException();
-            if (!isMTVU && m_ReadPos.load(std::memory_order_relaxed) == m_WritePos.load(std::memory_order_relaxed))
-                break;
-            u32 curP1Packs = weakWait ? path.GetPendingGSPackets() : 0;
-            if (weakWait && ((startP1Packs - curP1Packs) || !curP1Packs))
-                break;
+                RethrowException();
+                if (!isMTVU && m_ReadPos.load(std::memory_order_relaxed) == m_WritePos.load(std::memory_order_relaxed))
+                    break;
+                u32 curP1Packs = path.GetPendingGSPackets();
+                if ((startP1Packs - curP1Packs) || !curP1Packs)
+                    break;
+            }
+            s_weakWaitGS.Slept();
         }
     }
 
@@ -607,7 +625,7 @@ void SysMtgsThread::GenericStall(uint size)
         freeroom = RingBufferSize - (writepos - readpos);
 
     if (freeroom <= size) {
-
+        TRACE_ZONE("MTGS Ring Full");
 
         uint somedone = (RingBufferSize - freeroom) / 4;
         if (somedone < size + 1)
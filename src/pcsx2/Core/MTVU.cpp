@@ -18,8 +18,10 @@
 #include "MTVU.h"
 #include "newVif.h"
 #include "Gif_Unit.h"
+#include "common/Tracing.h"
 
-__aligned16 VU_Thread vu1Thread(CpuVU1, VU1);
+__aligned16 VU_Thread vu0Thread(CpuVU0, VU0, 0);
+__aligned16 VU_Thread vu1Thread(CpuVU1, VU1, 1);
 
 #define MTVU_ALWAYS_KICK 0
 #define MTVU_SYNC_MODE   0
@@ -87,9 +89,11 @@ void SaveStateBase::mtvuFreeze()
     Freeze(vu1Thread.vuCycleIdx);
 }
 
-VU_Thread::VU_Thread(BaseVUmicroCPU *&_vuCPU, VURegs &_vuRegs) : vuCPU(_vuCPU), vuRegs(_vuRegs)
+VU_Thread::VU_Thread(BaseVUmicroCPU *&_vuCPU, VURegs &_vuRegs, int idx)
+    : vuCPU(_vuCPU), vuRegs(_vuRegs), m_idx(idx), m_waitSite(idx ? "MTVU Wait" : "MTVU0 Wait"),
+      m_idleSite(idx ? "MTVU Idle" : "MTVU0 Idle")
 {
-    m_name = L"MTVU";
+    m_name = idx ? L"MTVU" : L"MTVU0";
     Reset();
 }
 
@@ -109,13 +113,16 @@ void VU_Thread::Reset()
     isBusy          = false;
     m_ato_write_pos = 0;
     m_write_pos     = 0;
+    m_commits       = 0;
+    m_syncedCommits = ~0u;
+    m_quietCommits  = ~0u;
     m_ato_read_pos  = 0;
     m_read_pos      = 0;
     memzero(vif);
     memzero(vifRegs);
     for (size_t i = 0; i < 4; ++i)
-        vu1Thread.vuCycles[i] = 0;
-    vu1Thread.mtvuInterrupts = 0;
+        vuCycles[i] = 0;
+    mtvuInterrupts = 0;
 }
 
 void VU_Thread::ExecuteTaskInThread()
@@ -129,13 +136,30 @@ void VU_Thread::ExecuteTaskInThread()
 
 void VU_Thread::ExecuteRingBuffer()
 {
+    // Spins for new work without the busy lock, so a WaitVU() sleeping on it isn't held up
+    auto hasWork = [&] { return m_ato_read_pos.load(std::memory_order_relaxed) != GetWritePos(); };
     for (;;) {
-        semaEvent.WaitWithoutYield();
+        if (!hasWork()) {
+            if (m_idleSite.Spin(hasWork)) {
+                // KickStart() posted for the work found while spinning, the loop below handles it
+                while (semaEvent.TryWait()) {}
+            } else {
+                semaEvent.WaitWithoutYield();
+                m_idleSite.Slept();
+            }
+        }
         ScopedLockBool lock(mtxBusy, isBusy);
-        while (m_ato_read_pos.load(std::memory_order_relaxed) != GetWritePos()) {
+        TRACE_ZONE("MTVU Ring");
+        while (hasWork()) {
             u32 tag = Read();
             switch (tag) {
                 case MTVU_VU_EXECUTE: {
+                    if (!m_idx) {
+                        // VU0's start address and cycle count were set up by the EE, see vu0ExecMicro()
+                        m_read_pos += 3;
+                        vuCPU->Execute(vu0RunCycles);
+                        break;
+                    }
                     vuRegs.cycle = 0;
                     s32 addr     = Read();
                     vifRegs.top  = Read();
@@ -200,6 +224,7 @@ void VU_Thread::ExecuteRingBuffer()
 // Should only be called by ReserveSpace()
 __ri void VU_Thread::WaitOnSize(s32 size)
 {
+    Tracing::ScopedStall stall("MTVU Ring Full");
     for (;;) {
         s32 readPos = GetReadPos();
         if (readPos <= m_write_pos)
@@ -212,6 +237,7 @@ __ri void VU_Thread::WaitOnSize(s32 size)
         if (readPos > m_write_pos + size + _4kb)
             break;    // Enough free front space
         {             // Let MTVU run to free up buffer space
+            stall.Begin();
             KickStart();
             // Locking might trigger a full flush of the ring buffer. Yield
             // will be more aggressive, and only flush the minimal size.
@@ -263,6 +289,7 @@ __fi u32 *VU_Thread::GetWritePtr()
 __fi void VU_Thread::CommitWritePos()
 {
     m_ato_write_pos.store(m_write_pos, std::memory_order_release);
+    m_commits++;
 
     if (MTVU_ALWAYS_KICK)
         KickStart();
@@ -335,10 +362,19 @@ u32 VU_Thread::Get_vuCycles()
 
 void VU_Thread::Get_MTVUChanges()
 {
+    // Interrupts are only raised while the thread works through the ring, nothing new can be
+    // pending if nothing was sent since the ring was last seen empty with no interrupt left
+    if (m_quietCommits == m_commits)
+        return;
+
     // Note: Atomic communication is with Gif_Unit.cpp Gif_HandlerAD_MTVU
     u32 interrupts = mtvuInterrupts.load(std::memory_order_relaxed);
-    if (!interrupts)
+    if (!interrupts) {
+        // Reload after IsDone(), which acquires everything the thread did before emptying the ring
+        if (IsDone() && !mtvuInterrupts.load(std::memory_order_relaxed))
+            m_quietCommits = m_commits;
         return;
+    }
 
     if (interrupts & InterruptFlagSignal) {
         std::atomic_thread_fence(std::memory_order_acquire);
@@ -384,18 +420,20 @@ void VU_Thread::Get_MTVUChanges()
         const u32 labelData = (u32)label;
         GSSIGLBLID.LBLID    = (GSSIGLBLID.LBLID & ~labelMsk) | (labelData & labelMsk);
     }
+    // VBS0/VIS0 and INT_VU0 for VU0, VBS1/VIS1 and INT_VU1 for VU1
+    const u32 busyBit = m_idx ? 0x0100 : 0x0001;
     if (interrupts & InterruptFlagVUEBit) {
         mtvuInterrupts.fetch_and(~InterruptFlagVUEBit, std::memory_order_relaxed);
 
-        VU0.VI[REG_VPU_STAT].UL &= ~0x0100;
+        VU0.VI[REG_VPU_STAT].UL &= ~busyBit;
         // DevCon.Warning("E-Bit registered %x", VU0.VI[REG_VPU_STAT].UL);
     }
     if (interrupts & InterruptFlagVUTBit) {
         mtvuInterrupts.fetch_and(~InterruptFlagVUTBit, std::memory_order_relaxed);
-        VU0.VI[REG_VPU_STAT].UL &= ~0x0100;
-        VU0.VI[REG_VPU_STAT].UL |= 0x0400;
+        VU0.VI[REG_VPU_STAT].UL &= ~busyBit;
+        VU0.VI[REG_VPU_STAT].UL |= busyBit << 2;
         // DevCon.Warning("T-Bit registered %x", VU0.VI[REG_VPU_STAT].UL);
-        hwIntcIrq(7);
+        hwIntcIrq(m_idx ? 7 : 6);
     }
 }
 
@@ -414,15 +452,23 @@ bool VU_Thread::IsDone()
 void VU_Thread::WaitVU()
 {
     MTVU_LOG("MTVU - WaitVU!");
-    for (;;) {
-        if (IsDone())
-            break;
-        // DevCon.WriteLn("WaitVU()");
-        // pxAssert(THREAD_VU1);
-        KickStart();
-        std::this_thread::yield();    // Give a chance to the MTVU thread to actually start
-        ScopedLock lock(mtxBusy);
+    if (m_syncedCommits == m_commits) {
+        m_waitSite.Elided();
+        return;
+    }
+
+    Tracing::ScopedStall stall("MTVU Wait");
+    if (!IsDone()) {
+        stall.Begin();
+        KickStart();    // Spinning is pointless if the thread is asleep
     }
+    m_waitSite.Wait([&] { return IsDone(); },
+                    [&] {
+                        // pxAssert(THREAD_VU1);
+                        KickStart();
+                        ScopedLock lock(mtxBusy);
+                    });
+    m_syncedCommits = m_commits;
 }
 
 void VU_Thread::ExecuteVU(u32 vu_addr, u32 vif_top, u32 vif_itop)
@@ -435,11 +481,16 @@ void VU_Thread::ExecuteVU(u32 vu_addr, u32 vif_top, u32 vif_itop)
     Write(vif_top);
     Write(vif_itop);
     CommitWritePos();
+    if (!m_idx) {    // VU0 has no path to the GIF and doesn't steal cycles, the EE waits for it instead
+        KickStart();
+        return;
+    }
     gifUnit.TransferGSPacketData(GIF_TRANS_MTVU, NULL, 0);
     KickStart();
     u32 cycles = std::min(Get_vuCycles(), 3000u);
     cpuRegs.cycle += cycles * EmuConfig.Speedhacks.EECycleSkip;
-    VU0.cycle += cycles * EmuConfig.Speedhacks.EECycleSkip;
+    if (!THREAD_VU0)    // otherwise the VU0 thread is the one counting its cycles
+        VU0.cycle += cycles * EmuConfig.Speedhacks.EECycleSkip;
     Get_MTVUChanges();
 }
 
@@ -28,6 +28,7 @@
 // - This class should only be accessed from the EE thread...
 // - buffer_size must be power of 2
 // - ring-buffer has no complete pending packets when read_pos==write_pos
+// - vu0Thread only ever gets MTVU_VU_EXECUTE, the EE waits for it before touching VU0 at all
 class VU_Thread : public pxThread {
     static const s32 buffer_size = (_1mb * 16) / sizeof(s32);
 
@@ -38,10 +39,16 @@ class VU_Thread : public pxThread {
     __aligned(64) std::atomic<int> m_ato_write_pos;    // Only modified by EE thread
     __aligned(64) int m_read_pos;                      // temporary read pos (local to the VU thread)
     int              m_write_pos;                      // temporary write pos (local to the EE thread)
+    u32              m_commits;                        // CommitWritePos() calls (local to the EE thread)
+    u32              m_syncedCommits;                  // m_commits when WaitVU() last saw the ring empty
+    u32              m_quietCommits;                   // m_commits when the ring was empty with no interrupt left
     Mutex            mtxBusy;
     Semaphore        semaEvent;
     BaseVUmicroCPU *&vuCPU;
     VURegs          &vuRegs;
+    const int        m_idx;
+    WaitSite         m_waitSite;                       // EE waiting for the ring to drain
+    WaitSite         m_idleSite;                       // VU thread waiting for new work
 
   public:
     __aligned16 vifStruct     vif;
@@ -63,7 +70,7 @@ class VU_Thread : public pxThread {
     std::atomic<u64> gsLabel;           // Used for GS Label command
     std::atomic<u64> gsSignal;          // Used for GS Signal command
 
-    VU_Thread(BaseVUmicroCPU *&_vuCPU, VURegs &_vuRegs);
+    VU_Thread(BaseVUmicroCPU *&_vuCPU, VURegs &_vuRegs, int idx);
     virtual ~VU_Thread();
 
     void Reset();
@@ -74,7 +81,7 @@ class VU_Thread : public pxThread {
     // Used for assertions...
     bool IsDone();
 
-    // Waits till MTVU is done processing
+    // Waits till MTVU is done processing, returns at once if nothing was sent since the last wait
     void WaitVU();
 
     void Get_MTVUChanges();
@@ -125,4 +132,5 @@ class VU_Thread : public pxThread {
     u32 Get_vuCycles();
 };
 
+extern __aligned16 VU_Thread vu0Thread;
 extern __aligned16 VU_Thread vu1Thread;
@@ -41,6 +41,7 @@ BIOS
 #include "GS.h"
 #include "VUmicro.h"
 #include "MTVU.h"
+#include "COP0.h"
 #include "DEV9/DEV9.h"
 
 #include "ps2/HwInternal.h"
@@ -99,7 +100,7 @@ static vtlbHandler null_handler,
     tlb_fallback_0, tlb_fallback_2, tlb_fallback_3, tlb_fallback_4, tlb_fallback_5, tlb_fallback_6, tlb_fallback_7,
     tlb_fallback_8,
 
-    vu0_micro_mem, vu1_micro_mem, vu1_data_mem,
+    vu0_micro_mem, vu1_micro_mem, vu0_data_mem, vu1_data_mem,
 
     hw_by_page[0x10] = {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
                         0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF},
@@ -109,6 +110,19 @@ static vtlbHandler null_handler,
     iopHw_by_page_01, iopHw_by_page_03, iopHw_by_page_08;
 
 
+static bool vu0DataHandlers = false;
+
+// VU0 data is 4k, mirrored 4 times across a 16k area.  It only goes through the handlers
+// (which pause the VU0 thread, see vu0Sync) while VU0 has its own thread.
+static void memMapVU0Data()
+{
+    vu0DataHandlers = THREAD_VU0;
+    if (vu0DataHandlers)
+        vtlb_MapHandler(vu0_data_mem, 0x11004000, 0x00004000);
+    else
+        vtlb_MapBlock(VU0.Mem, 0x11004000, 0x00004000, 0x1000);
+}
+
 void memMapVUmicro()
 {
     // VU0/VU1 micro mem (instructions)
@@ -125,8 +139,7 @@ void memMapVUmicro()
     vtlb_MapHandler(vu1_micro_mem, 0x11008000, 0x00004000);
 
     // VU0/VU1 memory (data)
-    // VU0 is 4k, mirrored 4 times across a 16k area.
-    vtlb_MapBlock(VU0.Mem, 0x11004000, 0x00004000, 0x1000);
+    memMapVU0Data();
     // Note: In order for the below conditional to work correctly
     // support needs to be coded to reset the memMappings when MTVU is
     // turned off/on. For now we just always use the vu data handlers...
@@ -463,6 +476,8 @@ template <int vunum> static mem8_t __fc vuMicroRead8(u32 addr)
 
     if (vunum && THREAD_VU1)
         vu1Thread.WaitVU();
+    if (!vunum)
+        vu0Sync();
     return vu->Micro[addr];
 }
 template <int vunum> static mem16_t __fc vuMicroRead16(u32 addr)
@@ -472,6 +487,8 @@ template <int vunum> static mem16_t __fc vuMicroRead16(u32 addr)
 
     if (vunum && THREAD_VU1)
         vu1Thread.WaitVU();
+    if (!vunum)
+        vu0Sync();
     return *(u16 *)&vu->Micro[addr];
 }
 template <int vunum> static mem32_t __fc vuMicroRead32(u32 addr)
@@ -481,6 +498,8 @@ template <int vunum> static mem32_t __fc vuMicroRead32(u32 addr)
 
     if (vunum && THREAD_VU1)
         vu1Thread.WaitVU();
+    if (!vunum)
+        vu0Sync();
     return *(u32 *)&vu->Micro[addr];
 }
 template <int vunum> static RETURNS_R64 vuMicroRead64(u32 addr)
@@ -490,6 +509,8 @@ template <int vunum> static RETURNS_R64 vuMicroRead64(u32 addr)
 
     if (vunum && THREAD_VU1)
         vu1Thread.WaitVU();
+    if (!vunum)
+        vu0Sync();
     return r64_load(&vu->Micro[addr]);
 }
 template <int vunum> static RETURNS_R128 vuMicroRead128(u32 addr)
@@ -498,6 +519,8 @@ template <int vunum> static RETURNS_R128 vuMicroRead128(u32 addr)
     addr &= vunum ? 0x3fff : 0xfff;
     if (vunum && THREAD_VU1)
         vu1Thread.WaitVU();
+    if (!vunum)
+        vu0Sync();
 
     return r128_load(&vu->Micro[addr]);
 }
@@ -509,6 +532,8 @@ template <int vunum> static void __fc vuMicroWrite8(u32 addr, mem8_t data)
     VURegs *vu = vunum ? &VU1 : &VU0;
     addr &= vunum ? 0x3fff : 0xfff;
 
+    if (!vunum)
+        vu0Sync();
     if (vunum && THREAD_VU1) {
         vu1Thread.WriteMicroMem(addr, &data, sizeof(u8));
         return;
@@ -523,6 +548,8 @@ template <int vunum> static void __fc vuMicroWrite16(u32 addr, mem16_t data)
     VURegs *vu = vunum ? &VU1 : &VU0;
     addr &= vunum ? 0x3fff : 0xfff;
 
+    if (!vunum)
+        vu0Sync();
     if (vunum && THREAD_VU1) {
         vu1Thread.WriteMicroMem(addr, &data, sizeof(u16));
         return;
@@ -537,6 +564,8 @@ template <int vunum> static void __fc vuMicroWrite32(u32 addr, mem32_t data)
     VURegs *vu = vunum ? &VU1 : &VU0;
     addr &= vunum ? 0x3fff : 0xfff;
 
+    if (!vunum)
+        vu0Sync();
     if (vunum && THREAD_VU1) {
         vu1Thread.WriteMicroMem(addr, &data, sizeof(u32));
         return;
@@ -551,6 +580,8 @@ template <int vunum> static void __fc vuMicroWrite64(u32 addr, const mem64_t *da
     VURegs *vu = vunum ? &VU1 : &VU0;
     addr &= vunum ? 0x3fff : 0xfff;
 
+    if (!vunum)
+        vu0Sync();
     if (vunum && THREAD_VU1) {
         vu1Thread.WriteMicroMem(addr, (void *)data, sizeof(u64));
         return;
@@ -566,6 +597,8 @@ template <int vunum> static void __fc vuMicroWrite128(u32 addr, const mem128_t *
     VURegs *vu = vunum ? &VU1 : &VU0;
     addr &= vunum ? 0x3fff : 0xfff;
 
+    if (!vunum)
+        vu0Sync();
     if (vunum && THREAD_VU1) {
         vu1Thread.WriteMicroMem(addr, (void *)data, sizeof(u128));
         return;
@@ -583,6 +616,8 @@ template <int vunum> static mem8_t __fc vuDataRead8(u32 addr)
     addr &= vunum ? 0x3fff : 0xfff;
     if (vunum && THREAD_VU1)
         vu1Thread.WaitVU();
+    if (!vunum)
+        vu0Sync();
     return vu->Mem[addr];
 }
 template <int vunum> static mem16_t __fc vuDataRead16(u32 addr)
@@ -591,6 +626,8 @@ template <int vunum> static mem16_t __fc vuDataRead16(u32 addr)
     addr &= vunum ? 0x3fff : 0xfff;
     if (vunum && THREAD_VU1)
         vu1Thread.WaitVU();
+    if (!vunum)
+        vu0Sync();
     return *(u16 *)&vu->Mem[addr];
 }
 template <int vunum> static mem32_t __fc vuDataRead32(u32 addr)
@@ -599,6 +636,8 @@ template <int vunum> static mem32_t __fc vuDataRead32(u32 addr)
     addr &= vunum ? 0x3fff : 0xfff;
     if (vunum && THREAD_VU1)
         vu1Thread.WaitVU();
+    if (!vunum)
+        vu0Sync();
     return *(u32 *)&vu->Mem[addr];
 }
 template <int vunum> static RETURNS_R64 vuDataRead64(u32 addr)
@@ -607,6 +646,8 @@ template <int vunum> static RETURNS_R64 vuDataRead64(u32 addr)
     addr &= vunum ? 0x3fff : 0xfff;
     if (vunum && THREAD_VU1)
         vu1Thread.WaitVU();
+    if (!vunum)
+        vu0Sync();
     return r64_load(&vu->Mem[addr]);
 }
 template <int vunum> static RETURNS_R128 vuDataRead128(u32 addr)
@@ -615,6 +656,8 @@ template <int vunum> static RETURNS_R128 vuDataRead128(u32 addr)
     addr &= vunum ? 0x3fff : 0xfff;
     if (vunum && THREAD_VU1)
         vu1Thread.WaitVU();
+    if (!vunum)
+        vu0Sync();
     return r128_load(&vu->Mem[addr]);
 }
 
@@ -623,6 +666,8 @@ template <int vunum> static void __fc vuDataWrite8(u32 addr, mem8_t data)
 {
     VURegs *vu = vunum ? &VU1 : &VU0;
     addr &= vunum ? 0x3fff : 0xfff;
+    if (!vunum)
+        vu0Sync();
     if (vunum && THREAD_VU1) {
         vu1Thread.WriteDataMem(addr, &data, sizeof(u8));
         return;
@@ -633,6 +678,8 @@ template <int vunum> static void __fc vuDataWrite16(u32 addr, mem16_t data)
 {
     VURegs *vu = vunum ? &VU1 : &VU0;
     addr &= vunum ? 0x3fff : 0xfff;
+    if (!vunum)
+        vu0Sync();
     if (vunum && THREAD_VU1) {
         vu1Thread.WriteDataMem(addr, &data, sizeof(u16));
         return;
@@ -643,6 +690,8 @@ template <int vunum> static void __fc vuDataWrite32(u32 addr, mem32_t data)
 {
     VURegs *vu = vunum ? &VU1 : &VU0;
     addr &= vunum ? 0x3fff : 0xfff;
+    if (!vunum)
+        vu0Sync();
     if (vunum && THREAD_VU1) {
         vu1Thread.WriteDataMem(addr, &data, sizeof(u32));
         return;
@@ -653,6 +702,8 @@ template <int vunum> static void __fc vuDataWrite64(u32 addr, const mem64_t *dat
 {
     VURegs *vu = vunum ? &VU1 : &VU0;
     addr &= vunum ? 0x3fff : 0xfff;
+    if (!vunum)
+        vu0Sync();
     if (vunum && THREAD_VU1) {
         vu1Thread.WriteDataMem(addr, (void *)data, sizeof(u64));
         return;
@@ -663,6 +714,8 @@ template <int vunum> static void __fc vuDataWrite128(u32 addr, const mem128_t *d
 {
     VURegs *vu = vunum ? &VU1 : &VU0;
     addr &= vunum ? 0x3fff : 0xfff;
+    if (!vunum)
+        vu0Sync();
     if (vunum && THREAD_VU1) {
         vu1Thread.WriteDataMem(addr, (void *)data, sizeof(u128));
         return;
@@ -724,6 +777,17 @@ void memBindConditionalHandlers()
         vtlb_ReassignHandler(hw_by_page[0xf], hwRead8<0x0f>, page0F16, page0F32, hwRead64<0x0f>, hwRead128<0x0f>,
                              hwWrite8<0x0f>, hwWrite16<0x0f>, hwWrite32<0x0f>, hwWrite64<0x0f>, hwWrite128<0x0f>);
     }
+
+    // The VU0 thread is switched with a recompiler reset, which ends up here.  The physical
+    // mapping changes, so the virtual pages pointing at it (direct, mirrors, TLB) are redone.
+    if (vu0DataHandlers != THREAD_VU0) {
+        memMapVU0Data();
+        vtlb_VMap(0x11004000, 0x11004000, 0x00004000);
+        vtlb_VMap(0x91004000, 0x11004000, 0x00004000);
+        vtlb_VMap(0xB1004000, 0x11004000, 0x00004000);
+        for (int i = 0; i < 48; i++)
+            MapTLB(i);
+    }
 }
 
 
@@ -782,6 +846,7 @@ void eeMemoryReserve::Reset()
     // Dynarec versions of VUs
     vu0_micro_mem = vtlb_RegisterHandlerTempl1(vuMicro, 0);
     vu1_micro_mem = vtlb_RegisterHandlerTempl1(vuMicro, 1);
+    vu0_data_mem  = vtlb_RegisterHandlerTempl1(vuData, 0);
     vu1_data_mem  = (1 || THREAD_VU1) ? vtlb_RegisterHandlerTempl1(vuData, 1) : 0;
 
     //////////////////////////////////////////////////////////////////////////////////////////
@@ -832,6 +897,7 @@ void eeMemoryReserve::Reset()
     hw_by_page[0xd] = vtlb_RegisterHandler(hwHandlerTmpl(0x0d));
     hw_by_page[0xe] = vtlb_RegisterHandler(hwHandlerTmpl(0x0e));
     hw_by_page[0xf] = vtlb_NewHandler();    // redefined later based on speedhacking prefs
+    vu0DataHandlers = THREAD_VU0;           // mapped below with the rest of the VU memory
     memBindConditionalHandlers();
 
     //////////////////////////////////////////////////////////////////////
@@ -906,6 +972,10 @@ eeMemoryReserve::~eeMemoryReserve()
 // is 4096 (4k), which is why you'll see a lot of 0xfff's, >><< 12's, and 0x1000's in the
 // code below.
 //
+// Within a page we also remember which 256 byte regions hold recompiled code.  A write fault
+// that misses all of them is a data write next to code, and pages that keep getting those
+// stay under manual protection instead of being reset and re-protected over and over.
+//
 
 struct vtlb_PageProtectionInfo
 {
@@ -917,6 +987,12 @@ struct vtlb_PageProtectionInfo
     u32 ReverseRamMap;
 
     vtlb_ProtectionMode Mode;
+
+    // 256 byte regions of the page holding code recompiled under write protection
+    u16 CodeRegions;
+
+    // number of write faults that didn't touch any of the CodeRegions
+    u8 DataFaults;
 };
 
 static __aligned16 vtlb_PageProtectionInfo m_PageProtectInfo[Ps2MemSize::MainRam >> 12];
@@ -944,10 +1020,14 @@ vtlb_ProtectionMode mmap_GetRamPageInfo(u32 paddr)
 }
 
 // paddr - physically mapped PS2 address
-void mmap_MarkCountedRamPage(u32 paddr)
+// size - size in bytes of the code being protected, must not cross the page
+void mmap_MarkCountedRamPage(u32 paddr, u32 size)
 {
     pxAssert(eeMem);
 
+    const u32 first = (paddr & 0xfff) >> 8;
+    const u32 last  = ((paddr & 0xfff) + std::max<u32>(size, 1) - 1) >> 8;
+
     paddr &= ~0xfff;
 
     uptr ptr     = (uptr)PSM(paddr);
@@ -957,6 +1037,8 @@ void mmap_MarkCountedRamPage(u32 paddr)
     // mapping into eeMem->Main.
 
     m_PageProtectInfo[rampage].ReverseRamMap = paddr;
+    for (u32 region = first; region <= last && region < 16; region++)
+        m_PageProtectInfo[rampage].CodeRegions |= 1 << region;
 
     if (m_PageProtectInfo[rampage].Mode == ProtMode_Write)
         return;    // skip town if we're already protected.
@@ -969,6 +1051,21 @@ void mmap_MarkCountedRamPage(u32 paddr)
     HostSys::MemProtect(&eeMem->Main[rampage << 12], __pagesize, PageAccess_ReadOnly());
 }
 
+// Returns true once the page was unprotected twice by writes that missed all of its code,
+// re-protecting it would only fault again on the next data write.
+bool mmap_IsMixedRamPage(u32 paddr)
+{
+    pxAssert(eeMem);
+
+    uptr ptr     = (uptr)PSM(paddr & ~0xfff);
+    uptr rampage = ptr - (uptr)eeMem->Main;
+
+    if (rampage >= Ps2MemSize::MainRam)
+        return false;
+
+    return m_PageProtectInfo[rampage >> 12].DataFaults >= 2;
+}
+
 // offset - offset of address relative to psM.
 // All recompiled blocks belonging to the page are cleared, and any new blocks recompiled
 // from code residing in this page will use manual protection.
@@ -983,8 +1080,13 @@ static __fi void mmap_ClearCpuBlock(uint offset)
     pxAssertMsg(m_PageProtectInfo[rampage].Mode != ProtMode_Manual,
                 "Attempted to clear a block that is already under manual protection.");
 
+    if (!(m_PageProtectInfo[rampage].CodeRegions & (1 << ((offset & 0xfff) >> 8))) &&
+        m_PageProtectInfo[rampage].DataFaults < 0xff)
+        m_PageProtectInfo[rampage].DataFaults++;
+
     HostSys::MemProtect(&eeMem->Main[rampage << 12], __pagesize, PageAccess_ReadWrite());
-    m_PageProtectInfo[rampage].Mode = ProtMode_Manual;
+    m_PageProtectInfo[rampage].Mode        = ProtMode_Manual;
+    m_PageProtectInfo[rampage].CodeRegions = 0;
     Cpu->Clear(m_PageProtectInfo[rampage].ReverseRamMap, 0x400);
 }
 
@@ -28,6 +28,14 @@ struct Component_FileMcd;
 // #include "gui/ConsoleLogger.h"
 #include <wx/ffile.h>
 #include <map>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 static const int MCD_SIZE     = 1024 * 8 * 16;     // Legacy PSX card default size
 static const int MC2_MBSIZE   = 1024 * 528 * 2;    // Size of a single megabyte of card data
 bool             FileMcd_Open = false;
@@ -112,19 +120,103 @@ static bool ConvertRAWtoNoECC(wxString file_in, wxString file_out)
     }
     return result;
 }
+// Write back journal: magic, record count, {offset, size, data} records, magic and a hash
+// of everything before it. A journal without a valid tail was interrupted before the card
+// itself was touched and is simply dropped.
+static const u64 MCD_JOURNAL_MAGIC = 0x4c4e524a44434d50;    // "PMCDJRNL"
+static u64 JournalHash(u64 hash, const void *data, size_t size)
+{
+    const u8 *bytes = (const u8 *)data;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    return hash;
+}
+static bool SyncFile(wxFFile &f)
+{
+    if (!f.Flush())
+        return false;
+#ifdef _WIN32
+    return _commit(_fileno(f.fp())) == 0;
+#else
+    return fsync(fileno(f.fp())) == 0;
+#endif
+}
+// Finishes a write back that was interrupted after its journal was synced.  A journal that
+// couldn't be applied is kept for the next attempt, false is returned then.
+static bool ReplayJournal(const wxString &mcdFile)
+{
+    const wxString journalFile = mcdFile + L".journal";
+    if (!wxFileExists(journalFile))
+        return true;
+    std::vector<u8> journal;
+    {
+        wxFFile jf(journalFile, L"rb");
+        if (jf.IsOpened()) {
+            journal.resize(jf.Length());
+            if (jf.Read(journal.data(), journal.size()) != journal.size())
+                journal.clear();
+        }
+    }
+    bool      valid = false;
+    const u8 *pos   = journal.data();
+    const u8 *end   = journal.data() + journal.size();
+    u32       count = 0;
+    if (journal.size() >= 12 + 16 && *(u64 *)pos == MCD_JOURNAL_MAGIC) {
+        const u8 *tail = end - 16;
+        const u64 hash = JournalHash(0xcbf29ce484222325ULL, journal.data(), tail - journal.data());
+        valid          = *(u64 *)tail == MCD_JOURNAL_MAGIC && *(u64 *)(tail + 8) == hash;
+        count          = *(u32 *)(pos + 8);
+        pos += 12;
+        end = tail;
+    }
+    if (valid) {
+        wxFFile card(mcdFile, L"r+b");
+        for (u32 i = 0; card.IsOpened() && i < count && end - pos >= 8; i++) {
+            const u32 offset = *(u32 *)pos;
+            const u32 size   = *(u32 *)(pos + 4);
+            pos += 8;
+            if ((u32)(end - pos) < size || !card.Seek(offset) || card.Write(pos, size) != size)
+                break;
+            pos += size;
+        }
+        if (!card.IsOpened() || pos != end || !SyncFile(card)) {
+            Console.Error(L"(FileMcd) Could not complete an interrupted write to " + mcdFile);
+            return false;
+        }
+        Console.WriteLn(Color_StrongYellow, L"(FileMcd) Completed an interrupted write to " + mcdFile);
+    }
+    wxRemoveFile(journalFile);
+    return true;
+}
 // --------------------------------------------------------------------------------------
 //  FileMemoryCard
 // --------------------------------------------------------------------------------------
-// Provides thread-safe direct file IO mapping.
+// Keeps every card image in memory.  Reads and writes only touch that copy and the dirty
+// erase blocks are written back to the file by a background thread, through a journal so
+// that a crash or a power cut leaves each block with either its old or its new data, and
+// a write that failed is finished before the next one (see WriteBack).
 //
 class FileMemoryCard {
   protected:
-    wxFFile       m_file[8];
-    u8            m_effeffs[528 * 16];
-    SafeArray<u8> m_currentdata;
-    u64           m_chksum[8];
-    bool          m_ispsx[8];
-    u32           m_chkaddr;
+    struct WriteBackRecord
+    {
+        u32             offset;
+        std::vector<u8> data;
+    };
+    wxFFile                 m_file[8];
+    std::vector<u8>         m_image[8];
+    std::vector<u8>         m_dirty[8];    // one flag per erase block sized chunk of the image
+    u32                     m_offset[8];     // header of the legacy PSX card formats
+    u32                     m_crcsize[8];    // part of a PSX card covered by GetCRC
+    u8                      m_effeffs[528 * 16];
+    u64                     m_chksum[8];
+    bool                    m_ispsx[8];
+    u32                     m_chkaddr;
+    std::mutex              m_lock;
+    std::condition_variable m_wake;
+    std::thread             m_writer;
+    bool                    m_pending;
+    bool                    m_quit;
 
   public:
     FileMemoryCard();
@@ -142,8 +234,13 @@ class FileMemoryCard {
     u64  GetCRC(uint slot);
 
   protected:
-    bool     Seek(wxFFile &f, u32 adr);
+    u32      GetOffset(u32 filesize) const;
     bool     Create(const wxString &mcdFile, uint sizeInMB);
+    bool     InRange(uint slot, u32 pos, u32 size) const;
+    u64      PsxCRC(uint slot, u32 pos, u32 size) const;
+    void     MarkDirty(uint slot, u32 pos, u32 size);
+    void     WriterThread();
+    bool     WriteBack(uint slot, const std::vector<WriteBackRecord> &records);
     wxString GetDisabledMessage(uint slot) const
     {
         return wxString("");
@@ -204,9 +301,13 @@ FileMemoryCard::FileMemoryCard()
 {
     memset8<0xff>(m_effeffs);
     m_chkaddr = 0;
+    m_pending = false;
+    m_quit    = false;
 }
 void FileMemoryCard::Open()
 {
+    m_pending = false;
+    m_quit    = false;
     for (int slot = 0; slot < 8; ++slot) {
         if (FileMcd_IsMultitapSlot(slot)) {
             if (!EmuConfig.MultitapPort0_Enabled && (FileMcd_GetMtapPort(slot) == 0))
@@ -256,29 +357,61 @@ void FileMemoryCard::Open()
             }
             str = newname;
         }
+        ReplayJournal(str);
         if (!m_file[slot].Open(str.c_str(), L"r+b")) {
             // Translation note: detailed description should mention that the memory card will be disabled
             // for the duration of this session.
             // Msgbox::Alert(
             // 	wxsFormat(_("Access denied to memory card: \n\n%s\n\n"), str.c_str()) +
             // 	GetDisabledMessage(slot));
-        } else    // Load checksum
-        {
-            m_ispsx[slot] = m_file[slot].Length() == 0x20000;
-            m_chkaddr     = 0x210;
-            if (!m_ispsx[slot] && !!m_file[slot].Seek(m_chkaddr))
-                m_file[slot].Read(&m_chksum[slot], 8);
+            continue;
+        }
+        m_image[slot].resize(m_file[slot].Length());
+        if (m_file[slot].Read(m_image[slot].data(), m_image[slot].size()) != m_image[slot].size()) {
+            Console.Error(L"(FileMcd) Could not read memory card: " + str);
+            m_file[slot].Close();
+            m_image[slot].clear();
+            continue;
+        }
+        m_dirty[slot].assign(m_image[slot].size() / sizeof(m_effeffs) + 1, 0);
+        m_offset[slot] = GetOffset(m_image[slot].size());
+        // Load checksum
+        m_ispsx[slot] = m_image[slot].size() == 0x20000;
+        m_chkaddr     = 0x210;
+        if (m_ispsx[slot]) {
+            // same coverage as the chunked file read GetCRC used to do
+            m_crcsize[slot] = m_image[slot].size() / (528 * 8 * 8) * (528 * 8 * 8);
+            m_chksum[slot]  = PsxCRC(slot, 0, m_crcsize[slot]);
+        } else if (InRange(slot, m_offset[slot] + m_chkaddr, 8)) {
+            memcpy(&m_chksum[slot], &m_image[slot][m_offset[slot] + m_chkaddr], 8);
         }
     }
+    if (!m_writer.joinable())
+        m_writer = std::thread(&FileMemoryCard::WriterThread, this);
 }
 void FileMemoryCard::Close()
 {
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        for (int slot = 0; slot < 8; ++slot) {
+            // Store checksum
+            const u32 pos = m_offset[slot] + m_chkaddr;
+            if (m_file[slot].IsOpened() && !m_ispsx[slot] && InRange(slot, pos, 8)) {
+                memcpy(&m_image[slot][pos], &m_chksum[slot], 8);
+                MarkDirty(slot, pos, 8);
+            }
+        }
+        m_quit = true;
+    }
+    // the writer flushes everything still dirty before it exits
+    m_wake.notify_one();
+    if (m_writer.joinable())
+        m_writer.join();
     for (int slot = 0; slot < 8; ++slot) {
         if (m_file[slot].IsOpened()) {
-            // Store checksum
-            if (!m_ispsx[slot] && !!m_file[slot].Seek(m_chkaddr))
-                m_file[slot].Write(&m_chksum[slot], 8);
             m_file[slot].Close();
+            m_image[slot].clear();
+            m_image[slot].shrink_to_fit();
             if (m_file[slot].GetName().EndsWith(".binx")) {
                 wxString name     = m_file[slot].GetName();
                 wxString name_old = name.SubString(0, name.Last('.')) + "bin";
@@ -288,10 +421,9 @@ void FileMemoryCard::Close()
         }
     }
 }
-// Returns FALSE if the seek failed (is outside the bounds of the file).
-bool FileMemoryCard::Seek(wxFFile &f, u32 adr)
+// Returns the size of the header in front of the card data.
+u32 FileMemoryCard::GetOffset(u32 size) const
 {
-    const u32 size = f.Length();
     // If anyone knows why this filesize logic is here (it appears to be related to legacy PSX
     // cards, perhaps hacked support for some special emulator-specific memcard formats that
     // had header info?), then please replace this comment with something useful.  Thanks!  -- air
@@ -303,7 +435,7 @@ bool FileMemoryCard::Seek(wxFFile &f, u32 adr)
     else {
         // perform sanity checks here?
     }
-    return f.Seek(adr + offset);
+    return offset;
 }
 // returns FALSE if an error occurred (either permission denied or disk full)
 bool FileMemoryCard::Create(const wxString &mcdFile, uint sizeInMB)
@@ -319,6 +451,27 @@ bool FileMemoryCard::Create(const wxString &mcdFile, uint sizeInMB)
     }
     return true;
 }
+bool FileMemoryCard::InRange(uint slot, u32 pos, u32 size) const
+{
+    return pos <= m_image[slot].size() && size <= m_image[slot].size() - pos;
+}
+// XOR of the 64 bit words of a PSX card overlapping [pos, pos + size), within m_crcsize
+u64 FileMemoryCard::PsxCRC(uint slot, u32 pos, u32 size) const
+{
+    const u32 begin  = std::min(pos & ~7u, m_crcsize[slot]);
+    const u32 end    = std::min((pos + size + 7) & ~7u, m_crcsize[slot]);
+    u64       retval = 0;
+    for (u32 i = begin; i < end; i += 8)
+        retval ^= *(const u64 *)&m_image[slot][i];
+    return retval;
+}
+// Must be called with m_lock held.
+void FileMemoryCard::MarkDirty(uint slot, u32 pos, u32 size)
+{
+    for (u32 block = pos / sizeof(m_effeffs); block <= (pos + size - 1) / sizeof(m_effeffs); block++)
+        m_dirty[slot][block] = 1;
+    m_pending = true;
+}
 s32 FileMemoryCard::IsPresent(uint slot)
 {
     return m_file[slot].IsOpened();
@@ -329,7 +482,7 @@ void FileMemoryCard::GetSizeInfo(uint slot, McdSizeInfo &outways)
     outways.EraseBlockSizeInSectors = 16;     // 0x0010
     outways.Xor                     = 18;     // 0x12, XOR 02 00 00 10
     if (pxAssert(m_file[slot].IsOpened()))
-        outways.McdSizeInSectors = m_file[slot].Length() / (outways.SectorSize + outways.EraseBlockSizeInSectors);
+        outways.McdSizeInSectors = m_image[slot].size() / (outways.SectorSize + outways.EraseBlockSizeInSectors);
     else
         outways.McdSizeInSectors = 0x4000;
     u8 *pdata = (u8 *)&outways.McdSizeInSectors;
@@ -341,95 +494,184 @@ bool FileMemoryCard::IsPSX(uint slot)
 }
 s32 FileMemoryCard::Read(uint slot, u8 *dest, u32 adr, int size)
 {
-    wxFFile &mcfp(m_file[slot]);
-    if (!mcfp.IsOpened()) {
+    if (!m_file[slot].IsOpened()) {
         DevCon.Error("(FileMcd) Ignoring attempted read from disabled slot.");
         memset(dest, 0, size);
         return 1;
     }
-    if (!Seek(mcfp, adr))
+    const u32 pos = m_offset[slot] + adr;
+    if (!InRange(slot, pos, size))
         return 0;
-    return mcfp.Read(dest, size) != 0;
+    // only this thread modifies the image, no need to lock
+    memcpy(dest, &m_image[slot][pos], size);
+    return 1;
 }
 s32 FileMemoryCard::Save(uint slot, const u8 *src, u32 adr, int size)
 {
-    wxFFile &mcfp(m_file[slot]);
-    if (!mcfp.IsOpened()) {
+    if (!m_file[slot].IsOpened()) {
         DevCon.Error("(FileMcd) Ignoring attempted save/write to disabled slot.");
         return 1;
     }
-    if (m_ispsx[slot]) {
-        m_currentdata.MakeRoomFor(size);
-        for (int i = 0; i < size; i++)
-            m_currentdata[i] = src[i];
-    } else {
-        if (!Seek(mcfp, adr))
-            return 0;
-        m_currentdata.MakeRoomFor(size);
-        mcfp.Read(m_currentdata.GetPtr(), size);
-        for (int i = 0; i < size; i++) {
-            if ((m_currentdata[i] & src[i]) != src[i])
-                Console.Warning("(FileMcd) Warning: writing to uncleared data. (%d) [%08X]", slot, adr);
-            m_currentdata[i] &= src[i];
-        }
-        // Checksumness
-        {
-            if (adr == m_chkaddr)
-                Console.Warning("(FileMcd) Warning: checksum sector overwritten. (%d)", slot);
-            u64 *pdata = (u64 *)&m_currentdata[0];
-            u32  loops = size / 8;
-            for (u32 i = 0; i < loops; i++)
-                m_chksum[slot] ^= pdata[i];
-        }
-    }
-    if (!Seek(mcfp, adr))
+    const u32 pos = m_offset[slot] + adr;
+    if (!InRange(slot, pos, size) || !size)
         return 0;
-    int status = mcfp.Write(m_currentdata.GetPtr(), size);
-    if (status) {
-        static auto                  last    = std::chrono::time_point<std::chrono::system_clock>();
-        std::chrono::duration<float> elapsed = std::chrono::system_clock::now() - last;
-        if (elapsed > std::chrono::seconds(5)) {
-            wxString name, ext;
-            wxFileName::SplitPath(m_file[slot].GetName(), NULL, NULL, &name, &ext);
-            // OSDlog(Color_StrongYellow, true, "Memory Card %s written.", (const char *)(name + "." + ext).c_str());
-            last = std::chrono::system_clock::now();
+    u8 *data = &m_image[slot][pos];
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (m_ispsx[slot]) {
+            m_chksum[slot] ^= PsxCRC(slot, pos, size);
+            memcpy(data, src, size);
+            m_chksum[slot] ^= PsxCRC(slot, pos, size);
+        } else {
+            for (int i = 0; i < size; i++) {
+                if ((data[i] & src[i]) != src[i])
+                    Console.Warning("(FileMcd) Warning: writing to uncleared data. (%d) [%08X]", slot, adr);
+                data[i] &= src[i];
+            }
+            // Checksumness
+            {
+                if (adr == m_chkaddr)
+                    Console.Warning("(FileMcd) Warning: checksum sector overwritten. (%d)", slot);
+                u64 *pdata = (u64 *)data;
+                u32  loops = size / 8;
+                for (u32 i = 0; i < loops; i++)
+                    m_chksum[slot] ^= pdata[i];
+            }
         }
-        return 1;
+        MarkDirty(slot, pos, size);
+    }
+    m_wake.notify_one();
+    static auto                  last    = std::chrono::time_point<std::chrono::system_clock>();
+    std::chrono::duration<float> elapsed = std::chrono::system_clock::now() - last;
+    if (elapsed > std::chrono::seconds(5)) {
+        wxString name, ext;
+        wxFileName::SplitPath(m_file[slot].GetName(), NULL, NULL, &name, &ext);
+        // OSDlog(Color_StrongYellow, true, "Memory Card %s written.", (const char *)(name + "." + ext).c_str());
+        last = std::chrono::system_clock::now();
     }
-    return 0;
+    return 1;
 }
 s32 FileMemoryCard::EraseBlock(uint slot, u32 adr)
 {
-    wxFFile &mcfp(m_file[slot]);
-    if (!mcfp.IsOpened()) {
+    if (!m_file[slot].IsOpened()) {
         DevCon.Error("MemoryCard: Ignoring erase for disabled slot.");
         return 1;
     }
-    if (!Seek(mcfp, adr))
+    const u32 pos = m_offset[slot] + adr;
+    if (!InRange(slot, pos, sizeof(m_effeffs)))
         return 0;
-    return mcfp.Write(m_effeffs, sizeof(m_effeffs)) != 0;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (m_ispsx[slot])
+            m_chksum[slot] ^= PsxCRC(slot, pos, sizeof(m_effeffs));
+        memcpy(&m_image[slot][pos], m_effeffs, sizeof(m_effeffs));
+        if (m_ispsx[slot])
+            m_chksum[slot] ^= PsxCRC(slot, pos, sizeof(m_effeffs));
+        MarkDirty(slot, pos, sizeof(m_effeffs));
+    }
+    m_wake.notify_one();
+    return 1;
 }
 u64 FileMemoryCard::GetCRC(uint slot)
 {
-    wxFFile &mcfp(m_file[slot]);
-    if (!mcfp.IsOpened())
+    if (!m_file[slot].IsOpened())
         return 0;
-    u64 retval = 0;
-    if (m_ispsx[slot]) {
-        if (!Seek(mcfp, 0))
-            return 0;
-        // Process the file in 4k chunks.  Speeds things up significantly.
-        u64        buffer[528 * 8];    // use 528 (sector size), ensures even divisibility
-        const uint filesize = mcfp.Length() / sizeof(buffer);
-        for (uint i = filesize; i; --i) {
-            mcfp.Read(&buffer, sizeof(buffer));
-            for (uint t = 0; t < ArraySize(buffer); ++t)
-                retval ^= buffer[t];
+    // PSX cards used to be re-read here, the running checksum covers the same words
+    return m_chksum[slot];
+}
+// Writes come in bursts while a game saves, dirty blocks are collected for a moment and
+// copied out under the lock, the file IO itself happens without it.
+void FileMemoryCard::WriterThread()
+{
+    Threading::SetNameOfCurrentThread("MemoryCard Writer");
+    std::unique_lock<std::mutex> lock(m_lock);
+    bool                         failed[8] = {};    // reported until the slot is written again
+    while (true) {
+        m_wake.wait(lock, [this] { return m_pending || m_quit; });
+        if (!m_quit)
+            m_wake.wait_for(lock, std::chrono::milliseconds(500), [this] { return m_quit; });
+        const bool quit = m_quit;
+        m_pending       = false;
+        std::vector<WriteBackRecord> records[8];
+        for (uint slot = 0; slot < 8; ++slot) {
+            for (u32 block = 0; block < m_dirty[slot].size(); block++) {
+                if (!m_dirty[slot][block])
+                    continue;
+                m_dirty[slot][block] = 0;
+                const u32       pos  = block * sizeof(m_effeffs);
+                const u32       size = std::min<u32>(sizeof(m_effeffs), m_image[slot].size() - pos);
+                const u8       *data = &m_image[slot][pos];
+                WriteBackRecord record;
+                record.offset = pos;
+                record.data.assign(data, data + size);
+                records[slot].push_back(std::move(record));
+            }
         }
-    } else {
-        retval = m_chksum[slot];
+        lock.unlock();
+        bool written[8];
+        for (uint slot = 0; slot < 8; ++slot)
+            written[slot] = records[slot].empty() || WriteBack(slot, records[slot]);
+        lock.lock();
+        // Blocks that didn't make it are dirty again and retried with the next batch
+        for (uint slot = 0; slot < 8; ++slot) {
+            if (written[slot]) {
+                failed[slot] = false;
+                continue;
+            }
+            if (!failed[slot])
+                Console.Error(L"(FileMcd) Failed to write memory card: " + m_file[slot].GetName());
+            failed[slot] = true;
+            for (const WriteBackRecord &record : records[slot])
+                m_dirty[slot][record.offset / sizeof(m_effeffs)] = 1;
+            m_pending = true;
+        }
+        if (quit)
+            return;
     }
-    return retval;
+}
+// The records go to <card>.journal first and the journal is synced, then they are written
+// to the card, which is synced before the journal is removed.  ReplayJournal redoes the
+// second step if it was interrupted, and a journal left by a failed write back is applied
+// before it's replaced, its records may not be part of this batch.
+bool FileMemoryCard::WriteBack(uint slot, const std::vector<WriteBackRecord> &records)
+{
+    const wxString journalFile = m_file[slot].GetName() + L".journal";
+    if (!SyncFile(m_file[slot]) || !ReplayJournal(m_file[slot].GetName()))
+        return false;
+    {
+        wxFFile   jf(journalFile, L"wb");
+        const u32 count = records.size();
+        u64       hash  = 0xcbf29ce484222325ULL;
+        bool      ok    = jf.IsOpened();
+        auto      put   = [&](const void *data, size_t size) {
+            ok   = ok && jf.Write(data, size) == size;
+            hash = JournalHash(hash, data, size);
+        };
+        put(&MCD_JOURNAL_MAGIC, 8);
+        put(&count, 4);
+        for (const WriteBackRecord &record : records) {
+            const u32 size = record.data.size();
+            put(&record.offset, 4);
+            put(&size, 4);
+            put(record.data.data(), size);
+        }
+        const u64 tail[2] = {MCD_JOURNAL_MAGIC, hash};
+        ok                = ok && jf.Write(tail, sizeof(tail)) == sizeof(tail) && SyncFile(jf);
+        if (!ok) {
+            jf.Close();
+            wxRemoveFile(journalFile);
+            return false;
+        }
+    }
+    wxFFile &mcfp(m_file[slot]);
+    for (const WriteBackRecord &record : records) {
+        if (!mcfp.Seek(record.offset) || mcfp.Write(record.data.data(), record.data.size()) != record.data.size())
+            return false;
+    }
+    if (!SyncFile(mcfp))
+        return false;
+    wxRemoveFile(journalFile);
+    return true;
 }
 // --------------------------------------------------------------------------------------
 //  MemoryCard Component API Bindings
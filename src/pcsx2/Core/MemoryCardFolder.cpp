@@ -52,6 +52,58 @@ static YAML::Node LoadYAMLFromFile(const wxString &fileName)
     return index;
 }
 
+// Indexing a folder means parsing every index and meta file and laying out the whole card, which adds up with a lot
+// of saves. The result is stored in the card folder and reused as long as nothing in the folder has changed.
+static const wxChar *const IndexCacheFileName = L"_pcsx2_cache";
+static const u32           IndexCacheMagic    = 0x4344434D;    // 'MCDC'
+static const u32           IndexCacheVersion  = 1;
+
+static void HashBytes(u64 &hash, const void *data, size_t size)
+{
+    const u8 *bytes = static_cast<const u8 *>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    }
+}
+
+// only needs to stat the files, their contents are never read
+static void HashFolderContents(u64 &hash, const wxString &dirPath)
+{
+    wxDir dir(dirPath);
+    if (!dir.IsOpened()) {
+        return;
+    }
+
+    // wxDir returns the entries in whatever order the file system has them
+    std::vector<wxString> names;
+    wxString              fileName;
+    bool                  hasNext = dir.GetFirst(&fileName);
+    while (hasNext) {
+        if (fileName != IndexCacheFileName) {
+            names.push_back(fileName);
+        }
+        hasNext = dir.GetNext(&fileName);
+    }
+    std::sort(names.begin(), names.end());
+
+    for (const wxString &name : names) {
+        const wxScopedCharBuffer nameUTF8(name.ToUTF8());
+        HashBytes(hash, nameUTF8.data(), nameUTF8.length() + 1);
+
+        wxFileName fileInfo(dirPath, name);
+        if (wxFile::Exists(fileInfo.GetFullPath())) {
+            const u64 size     = fileInfo.GetSize().GetValue();
+            const s64 modified = fileInfo.GetModificationTime().GetValue().GetValue();
+            HashBytes(hash, &size, sizeof(size));
+            HashBytes(hash, &modified, sizeof(modified));
+        } else {
+            const u8 dirMarker = 0xFF;
+            HashBytes(hash, &dirMarker, sizeof(dirMarker));
+            HashFolderContents(hash, fileInfo.GetFullPath());
+        }
+    }
+}
+
 FolderMemoryCard::FolderMemoryCard()
 {
     m_slot              = 0;
@@ -200,10 +252,17 @@ void FolderMemoryCard::LoadMemoryCardData(const u32 sizeInClusters, const bool e
             Console.WriteLn(Color_Green, L"(FolderMcd) Indexing slot %u without filter.", m_slot);
         }
 
+        const u64 signature = GetFolderSignature(enableFiltering, filter);
+        if (LoadIndexCache(signature)) {
+            Console.WriteLn(Color_Green, L"(FolderMcd) Folder of slot %u is unchanged, using cached index.", m_slot);
+            return;
+        }
+
         CreateFat();
         CreateRootDir();
         MemoryCardFileEntry *const rootDirEntry = &m_fileEntryDict[m_superBlock.data.rootdir_cluster].entries[0];
         AddFolder(rootDirEntry, m_folderName.GetPath(), nullptr, enableFiltering, filter);
+        SaveIndexCache(signature);
 
 #ifdef DEBUG_WRITE_FOLDER_CARD_IN_MEMORY_TO_FILE_ON_CHANGE
         WriteToFile(m_folderName.GetFullPath().RemoveLast() + L"-debug_" +
@@ -212,6 +271,100 @@ void FolderMemoryCard::LoadMemoryCardData(const u32 sizeInClusters, const bool e
     }
 }
 
+u64 FolderMemoryCard::GetFolderSignature(const bool enableFiltering, const wxString &filter) const
+{
+    u64 hash = 0xCBF29CE484222325ull;
+    HashBytes(hash, &IndexCacheVersion, sizeof(IndexCacheVersion));
+    HashBytes(hash, &m_superBlock.raw, sizeof(m_superBlock.raw));
+    HashBytes(hash, &enableFiltering, sizeof(enableFiltering));
+    if (enableFiltering) {
+        const wxScopedCharBuffer filterUTF8(filter.ToUTF8());
+        HashBytes(hash, filterUTF8.data(), filterUTF8.length());
+    }
+    HashFolderContents(hash, m_folderName.GetPath());
+    return hash;
+}
+
+bool FolderMemoryCard::LoadIndexCache(const u64 signature)
+{
+    wxFFile cacheFile;
+    {
+        // Suppress "file does not exist" errors
+        wxLogNull noLog;
+        if (!cacheFile.Open(wxFileName(m_folderName.GetPath(), IndexCacheFileName).GetFullPath(), L"rb")) {
+            return false;
+        }
+    }
+
+    u32 header[2];
+    u64 cachedSignature;
+    if (cacheFile.Read(header, sizeof(header)) != sizeof(header) || header[0] != IndexCacheMagic ||
+        header[1] != IndexCacheVersion || cacheFile.Read(&cachedSignature, sizeof(cachedSignature)) != sizeof(u64) ||
+        cachedSignature != signature) {
+        return false;
+    }
+
+    u32  entryClusterCount = 0;
+    bool valid             = cacheFile.Read(&m_indirectFat.raw, sizeof(m_indirectFat.raw)) == sizeof(m_indirectFat.raw);
+    valid = valid && cacheFile.Read(&m_fat.raw, sizeof(m_fat.raw)) == sizeof(m_fat.raw);
+    valid = valid && cacheFile.Read(&entryClusterCount, sizeof(entryClusterCount)) == sizeof(entryClusterCount);
+    for (u32 i = 0; valid && i < entryClusterCount; ++i) {
+        u32                        cluster;
+        MemoryCardFileEntryCluster entries;
+        valid = cacheFile.Read(&cluster, sizeof(cluster)) == sizeof(cluster) &&
+                cacheFile.Read(&entries, sizeof(entries)) == sizeof(entries) &&
+                cluster < sizeof(m_fat.data) / sizeof(u32);
+        if (valid) {
+            m_fileEntryDict[cluster] = entries;
+        }
+    }
+
+    const u32 rootDirCluster = m_superBlock.data.rootdir_cluster;
+    if (!valid || m_fileEntryDict.find(rootDirCluster) == m_fileEntryDict.end()) {
+        memset(&m_indirectFat, 0xFF, sizeof(m_indirectFat));
+        memset(&m_fat, 0xFF, sizeof(m_fat));
+        m_fileEntryDict.clear();
+        return false;
+    }
+
+    // file data is read through the quick-access references, the files themselves are opened on first access
+    AddDirContentsToMetadataQuickAccess(rootDirCluster,
+                                        m_fileEntryDict[rootDirCluster].entries[0].entry.data.length);
+    return true;
+}
+
+void FolderMemoryCard::SaveIndexCache(const u64 signature) const
+{
+    if (!m_performFileWrites) {
+        return;
+    }
+
+    wxFFile cacheFile(wxFileName(m_folderName.GetPath(), IndexCacheFileName).GetFullPath(), L"wb");
+    if (!cacheFile.IsOpened()) {
+        return;
+    }
+
+    const u32 header[2]         = {IndexCacheMagic, IndexCacheVersion};
+    const u32 entryClusterCount = static_cast<u32>(m_fileEntryDict.size());
+    cacheFile.Write(header, sizeof(header));
+    cacheFile.Write(&signature, sizeof(signature));
+    cacheFile.Write(&m_indirectFat.raw, sizeof(m_indirectFat.raw));
+    cacheFile.Write(&m_fat.raw, sizeof(m_fat.raw));
+    cacheFile.Write(&entryClusterCount, sizeof(entryClusterCount));
+    for (const auto &it : m_fileEntryDict) {
+        cacheFile.Write(&it.first, sizeof(it.first));
+        cacheFile.Write(&it.second, sizeof(it.second));
+    }
+}
+
+void FolderMemoryCard::InvalidateIndexCache() const
+{
+    const wxString cacheFileName = wxFileName(m_folderName.GetPath(), IndexCacheFileName).GetFullPath();
+    if (wxFileExists(cacheFileName)) {
+        wxRemoveFile(cacheFileName);
+    }
+}
+
 void FolderMemoryCard::CreateFat()
 {
     const u32 totalClusters        = m_superBlock.data.clusters_per_card;
@@ -481,12 +634,11 @@ bool FolderMemoryCard::AddFile(MemoryCardFileEntry *const dirEntry, const wxStri
     wxFileName relativeFilePath(dirPath, fileEntry.m_fileName);
     relativeFilePath.MakeRelativeTo(m_folderName.GetPath());
 
-    wxFileName fileInfo(dirPath, fileEntry.m_fileName);
-    wxFFile    file(fileInfo.GetFullPath(), L"rb");
-    if (file.IsOpened()) {
+    // the size comes from the directory listing, the file itself is only opened once its data is accessed
+    if (fileEntry.m_fileSize != wxInvalidSize) {
         // make sure we have enough space on the memcard to hold the data
         const u32 clusterSize = m_superBlock.data.pages_per_cluster * m_superBlock.data.page_len;
-        const u32 filesize    = file.Length();
+        const u32 filesize    = fileEntry.m_fileSize.GetLo();
         const u32 countClusters =
             (filesize % clusterSize) != 0 ? (filesize / clusterSize + 1) : (filesize / clusterSize);
         const u32 newNeededClusters = (dirEntry->entry.data.length % 2) == 0 ? countClusters + 1 : countClusters;
@@ -534,13 +686,7 @@ bool FolderMemoryCard::AddFile(MemoryCardFileEntry *const dirEntry, const wxStri
             newFileEntry->entry.data.cluster = MemoryCardFileEntry::EmptyFileCluster;
         }
 
-        file.Close();
-
-        MemoryCardFileMetadataReference *fileRef = AddFileEntryToMetadataQuickAccess(newFileEntry, parent);
-        if (fileRef != nullptr) {
-            // acquire a handle on the file so nothing else can change the file contents while the memory card is open
-            m_lastAccessedFile.ReOpen(m_folderName, fileRef);
-        }
+        AddFileEntryToMetadataQuickAccess(newFileEntry, parent);
 
         // and finally, increase file count in the directory entry
         dirEntry->entry.data.length++;
@@ -624,6 +770,32 @@ FolderMemoryCard::AddFileEntryToMetadataQuickAccess(MemoryCardFileEntry *const
     return &m_fileMetadataQuickAccess[firstFileCluster & NextDataClusterMask];
 }
 
+void FolderMemoryCard::AddDirContentsToMetadataQuickAccess(const u32 dirCluster, const u32 remainingFiles,
+                                                           MemoryCardFileMetadataReference *parent)
+{
+    MemoryCardFileEntryCluster *entries            = &m_fileEntryDict[dirCluster];
+    const u32                   filesInThisCluster = std::min(remainingFiles, 2u);
+    for (unsigned int i = 0; i < filesInThisCluster; ++i) {
+        MemoryCardFileEntry *entry = &entries->entries[i];
+        if (entry->IsValid() && entry->IsUsed()) {
+            if (entry->IsDir()) {
+                if (!entry->IsDotDir()) {
+                    MemoryCardFileMetadataReference *dirRef = AddDirEntryToMetadataQuickAccess(entry, parent);
+                    AddDirContentsToMetadataQuickAccess(entry->entry.data.cluster, entry->entry.data.length, dirRef);
+                }
+            } else if (entry->IsFile()) {
+                AddFileEntryToMetadataQuickAccess(entry, parent);
+            }
+        }
+    }
+
+    // continue to the next cluster of this directory
+    const u32 nextCluster = m_fat.data[0][0][dirCluster];
+    if (remainingFiles > 2 && nextCluster != (LastDataCluster | DataClusterInUseMask)) {
+        AddDirContentsToMetadataQuickAccess(nextCluster & NextDataClusterMask, remainingFiles - 2, parent);
+    }
+}
+
 s32 FolderMemoryCard::IsPresent() const
 {
     return m_isEnabled;
@@ -948,6 +1120,11 @@ void FolderMemoryCard::Flush()
         return;
     }
 
+    // the folder contents are about to change, the next open indexes it again
+    if (m_performFileWrites) {
+        InvalidateIndexCache();
+    }
+
 #ifdef DEBUG_WRITE_FOLDER_CARD_IN_MEMORY_TO_FILE_ON_CHANGE
     WriteToFile(m_folderName.GetFullPath().RemoveLast() + L"-debug_" + wxDateTime::Now().Format(L"%Y-%m-%d-%H-%M-%S") +
                 L"_pre-flush.ps2");
@@ -1538,7 +1715,8 @@ std::vector<FolderMemoryCard::EnumeratedFileEntry> FolderMemoryCard::GetOrderedF
                 auto key = std::make_pair(true, getOptionalNodeAttribute(node, "order", orderForLegacyFiles--));
                 EnumeratedFileEntry entry{
                     fileName, getOptionalNodeAttribute(node, "timeCreated", creationTime.GetTicks()),
-                    getOptionalNodeAttribute(node, "timeModified", modificationTime.GetTicks()), true};
+                    getOptionalNodeAttribute(node, "timeModified", modificationTime.GetTicks()), true,
+                    fileInfo.GetSize()};
                 sortContainer.try_emplace(std::move(key), std::move(entry));
             } else {
                 fileInfo.AppendDir(fileInfo.GetFullName());
@@ -1555,7 +1733,7 @@ std::vector<FolderMemoryCard::EnumeratedFileEntry> FolderMemoryCard::GetOrderedF
                 auto                key = std::make_pair(false, orderForDirectories++);
                 EnumeratedFileEntry entry{
                     fileName, getOptionalNodeAttribute(node, "timeCreated", creationTime.GetTicks()),
-                    getOptionalNodeAttribute(node, "timeModified", modificationTime.GetTicks()), false};
+                    getOptionalNodeAttribute(node, "timeModified", modificationTime.GetTicks()), false, 0};
                 sortContainer.try_emplace(std::move(key), std::move(entry));
             }
 
@@ -19,6 +19,7 @@
 #include <wx/dir.h>
 #include <wx/ffile.h>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 #include "Config.h"
@@ -352,16 +353,17 @@ class FolderMemoryCard {
     } m_backupBlock2;
 
     // stores directory and file metadata
-    std::map<u32, MemoryCardFileEntryCluster> m_fileEntryDict;
+    // (hash tables are node based, so the entry pointers held by m_fileMetadataQuickAccess stay valid)
+    std::unordered_map<u32, MemoryCardFileEntryCluster> m_fileEntryDict;
     // quick-access map of related file entry metadata for each memory card FAT cluster that contains file data
-    std::map<u32, MemoryCardFileMetadataReference> m_fileMetadataQuickAccess;
+    std::unordered_map<u32, MemoryCardFileMetadataReference> m_fileMetadataQuickAccess;
 
     // holds a copy of modified pages of the memory card before they're flushed to the file system
-    std::map<u32, MemoryCardPage> m_cache;
+    std::unordered_map<u32, MemoryCardPage> m_cache;
     // contains the state of how the data looked before the first write to it
     // used to reduce the amount of disk I/O by not re-writing unchanged data that just happened to be
     // touched in memory due to how actual physical memory cards have to erase and rewrite in blocks
-    std::map<u32, MemoryCardPage> m_oldDataCache;
+    std::unordered_map<u32, MemoryCardPage> m_oldDataCache;
     // if > 0, the amount of frames until data is flushed to the file system
     // reset to FramesAfterWriteUntilFlush on each write
     int m_framesUntilFlush;
@@ -434,10 +436,11 @@ class FolderMemoryCard {
   protected:
     struct EnumeratedFileEntry
     {
-        wxString m_fileName;    // TODO: Replace with std::string
-        time_t   m_timeCreated;
-        time_t   m_timeModified;
-        bool     m_isFile;
+        wxString    m_fileName;    // TODO: Replace with std::string
+        time_t      m_timeCreated;
+        time_t      m_timeModified;
+        bool        m_isFile;
+        wxULongLong m_fileSize;    // from the directory listing, wxInvalidSize if it couldn't be read
     };
 
     // initializes memory card data, as if it was fresh from the factory
@@ -486,6 +489,20 @@ class FolderMemoryCard {
     // - filter: can include multiple filters by separating them with "/"
     void LoadMemoryCardData(const u32 sizeInClusters, const bool enableFiltering, const wxString &filter);
 
+    // hashes names, sizes and modification times of everything in the folder along with the superblock and filter
+    // settings, the index cache is only used if this still matches
+    u64 GetFolderSignature(const bool enableFiltering, const wxString &filter) const;
+
+    // restores the FAT and file entries from the index cache written by SaveIndexCache()
+    // returns false if there is no cache or it was made for a different folder state
+    bool LoadIndexCache(const u64 signature);
+
+    // stores the FAT and file entries of a freshly indexed folder, so the next open can skip the indexing
+    void SaveIndexCache(const u64 signature) const;
+
+    // removes the index cache, called before the folder contents are changed by a flush
+    void InvalidateIndexCache() const;
+
     // creates the FAT and indirect FAT
     void CreateFat();
 
@@ -547,6 +564,11 @@ class FolderMemoryCard {
                                                                       MemoryCardFileMetadataReference *const parent);
 
 
+    // adds all entries of a directory and its subdirectories to the quick-access dictionary
+    void AddDirContentsToMetadataQuickAccess(const u32 dirCluster, const u32 remainingFiles,
+                                             MemoryCardFileMetadataReference *parent = nullptr);
+
+
     // read data from the memory card, ignoring the cache
     // do NOT attempt to read ECC with this method, it will not work
     void ReadDataWithoutCache(u8 *const dest, const u32 adr, const u32 dataLength);
@@ -85,8 +85,9 @@ Pcsx2Config::SpeedhackOptions::SpeedhackOptions()
     // Set recommended speedhacks to enabled by default. They'll still be off globally on resets.
     WaitLoop   = true;
     IntcStat   = true;
-    vuFlagHack = true;
-    vu1Instant = true;
+    vuFlagHack    = true;
+    vu1Instant    = true;
+    vifTraceCache = true;
 }
 
 Pcsx2Config::SpeedhackOptions &Pcsx2Config::SpeedhackOptions::DisableAll()
@@ -110,6 +111,34 @@ void Pcsx2Config::SpeedhackOptions::LoadSave(SettingsWrapper &wrap)
     SettingsWrapBitBool(vuFlagHack);
     SettingsWrapBitBool(vuThread);
     SettingsWrapBitBool(vu1Instant);
+    SettingsWrapBitBool(vu0Thread);
+    SettingsWrapEntry(vu0ThreadSerials);
+    SettingsWrapBitBool(vifTraceCache);
+}
+
+bool Pcsx2Config::SpeedhackOptions::IsVU0ThreadAllowed(const wxString &serial) const
+{
+    if (vu0ThreadSerials == "*")
+        return true;
+    if (serial.IsEmpty())
+        return false;
+
+    const std::string disc(StringUtil::wxStringToUTF8String(serial));
+    size_t            pos = 0;
+    while (pos <= vu0ThreadSerials.size()) {
+        size_t end = vu0ThreadSerials.find(',', pos);
+        if (end == std::string::npos)
+            end = vu0ThreadSerials.size();
+
+        const size_t first = vu0ThreadSerials.find_first_not_of(' ', pos);
+        if (first < end) {
+            const size_t last = vu0ThreadSerials.find_last_not_of(' ', end - 1);
+            if (vu0ThreadSerials.compare(first, last - first + 1, disc) == 0)
+                return true;
+        }
+        pos = end + 1;
+    }
+    return false;
 }
 
 void Pcsx2Config::ProfilerOptions::LoadSave(SettingsWrapper &wrap)
@@ -129,6 +158,9 @@ Pcsx2Config::RecompilerOptions::RecompilerOptions()
 
     // StackFrameChecks	= false;
     // PreBlockCheckEE	= false;
+    // DeferEECompile	= false;
+    // PersistIOPBlocks	= false;
+    // PrecompileIOPModules = false;
 
     // All recs are enabled by default.
 
@@ -189,6 +221,9 @@ void Pcsx2Config::RecompilerOptions::LoadSave(SettingsWrapper &wrap)
     SettingsWrapBitBool(EnableEE);
     SettingsWrapBitBool(EnableIOP);
     SettingsWrapBitBool(EnableEECache);
+    SettingsWrapBitBool(DeferEECompile);
+    SettingsWrapBitBool(PersistIOPBlocks);
+    SettingsWrapBitBool(PrecompileIOPModules);
     SettingsWrapBitBool(EnableVU0);
     SettingsWrapBitBool(EnableVU1);
 
@@ -542,6 +577,7 @@ void Pcsx2Config::LoadSave(SettingsWrapper &wrap)
     SettingsWrapBitBool(ConsoleToStdio);
     SettingsWrapBitBool(HostFs);
 
+    SettingsWrapBitBool(UseBootSnapshot);
     SettingsWrapBitBool(BackupSavestate);
     SettingsWrapBitBool(McdEnableEjection);
     SettingsWrapBitBool(McdFolderAutoManage);
@@ -624,6 +660,7 @@ void Pcsx2Config::CopyConfig(const Pcsx2Config &cfg)
     EnableWideScreenPatches = cfg.EnableWideScreenPatches;
 
     UseBOOT2Injection     = cfg.UseBOOT2Injection;
+    UseBootSnapshot       = cfg.UseBootSnapshot;
     BackupSavestate       = cfg.BackupSavestate;
     McdEnableEjection     = cfg.McdEnableEjection;
     McdFolderAutoManage   = cfg.McdFolderAutoManage;
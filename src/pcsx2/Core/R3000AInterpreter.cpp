@@ -20,6 +20,8 @@
 // #include "gui/AppCoreThread.h"
 
 #include "R5900OpcodeTables.h"
+
+#include <memory>
 // #include "DebugTools/Breakpoints.h"
 
 using namespace R3000A;
@@ -208,6 +210,60 @@ void psxCheckMemcheck()
     // }
 }
 
+// --------------------------------------------------------------------------------------
+//  Predecoded pages
+// --------------------------------------------------------------------------------------
+// Every word executed from IOP RAM keeps the leaf handler it decodes to, so execI() skips
+// iopMemRead32() and the SPECIAL/REGIMM/COP dispatchers. IOP RAM isn't write protected like
+// the EE's, an entry is only used while memory still holds the word it was decoded from.
+//
+struct psxPredecoded
+{
+    void (*handler)();
+    u32 code;
+};
+
+static std::unique_ptr<psxPredecoded[]> s_intPages[Ps2MemSize::IopRam >> 12];
+
+static void (*psxDecode(u32 code))()
+{
+    switch (code >> 26) {
+        case 0x00:
+            return psxSPC[code & 0x3f];
+        case 0x01:
+            return psxREG[(code >> 16) & 0x1f];
+        case 0x10:
+            return psxCP0[(code >> 21) & 0x1f];
+        case 0x12:
+            // COP2 funct 0 is BASIC, the register moves
+            return (code & 0x3f) ? psxCP2[code & 0x3f] : psxCP2BSC[(code >> 21) & 0x1f];
+        default:
+            return psxBSC[code >> 26];
+    }
+}
+
+// Loads psxRegs.code and returns its handler
+static __fi void (*psxFetch(u32 pc))()
+{
+    const uptr offset = psxMemRLUT[(pc & 0x1fffffff) >> 16] + (pc & 0xffff) - (uptr)iopMem->Main;
+    if (offset >= Ps2MemSize::IopRam) {
+        psxRegs.code = iopMemRead32(pc);
+        return psxBSC[psxRegs.code >> 26];
+    }
+
+    std::unique_ptr<psxPredecoded[]> &page = s_intPages[offset >> 12];
+    if (!page)
+        page.reset(new psxPredecoded[0x400]());
+
+    psxPredecoded &entry = page[(offset >> 2) & 0x3ff];
+    psxRegs.code         = *(u32 *)&iopMem->Main[offset];
+    if (entry.code != psxRegs.code || !entry.handler) {
+        entry.code    = psxRegs.code;
+        entry.handler = psxDecode(psxRegs.code);
+    }
+    return entry.handler;
+}
+
 ///////////////////////////////////////////
 // These macros are used to assemble the repassembler functions
 
@@ -231,7 +287,7 @@ static __fi void execI()
         }
     }
 
-    psxRegs.code = iopMemRead32(psxRegs.pc);
+    void (*handler)() = psxFetch(psxRegs.pc);
 
     // PSXCPU_LOG("%s", disR3000AF(psxRegs.code, psxRegs.pc));
 
@@ -244,7 +300,7 @@ static __fi void execI()
     } else {    // default ps2 mode value
         iopCycleEE -= 8;
     }
-    psxBSC[psxRegs.code >> 26]();
+    handler();
 }
 
 static void doBranch(s32 tar)
@@ -273,6 +329,9 @@ static void intAlloc()
 static void intReset()
 {
     intAlloc();
+
+    for (auto &page : s_intPages)
+        page.reset();
 }
 
 static void intExecute()
@@ -305,6 +364,8 @@ static void intClear(u32 Addr, u32 Size)
 
 static void intShutdown()
 {
+    for (auto &page : s_intPages)
+        page.reset();
 }
 
 static void intSetCacheReserve(uint reserveInMegs)
@@ -33,6 +33,8 @@
 
 #include "Elfheader.h"
 #include "CDVD/CDVD.h"
+#include "SaveState.h"
+#include "Lockstep.h"
 // #include "USB/USB.h"
 
 // #include "GameDatabase.h"
@@ -60,6 +62,8 @@ bool eeEventTestIsActive = false;
 
 u32 g_eeloadMain = 0, g_eeloadExec = 0, g_osdsys_str = 0;
 
+static bool s_bootSnapshotDone = false;    // the boot snapshot was restored or saved since the last reset
+
 /* I don't know how much space for args there is in the memory block used for args in full boot mode,
 but in fast boot mode, the block we use can fit at least 16 argv pointers (varies with BIOS version).
 The second EELOAD call during full boot has three built-in arguments ("EELOAD rom0:PS2LOGO <ELF>"),
@@ -73,6 +77,8 @@ extern SysMainMemory &GetVmMemory();
 
 void cpuReset()
 {
+    vu0Thread.WaitVU();
+    vu0Thread.Reset();
     vu1Thread.WaitVU();
     if (GetMTGS().IsOpen())
         GetMTGS().WaitGS();    // GS better be done processing before we reset the EE, just in case.
@@ -121,6 +127,89 @@ void cpuReset()
     LastELF = L"";
 
     g_eeloadMain = 0, g_eeloadExec = 0, g_osdsys_str = 0;
+
+    s_bootSnapshotDone = false;
+}
+
+// --------------------------------------------------------------------------------------
+//  Boot snapshot
+// --------------------------------------------------------------------------------------
+// The machine as the BIOS hands over to EELOAD for the first time. Nothing game specific has happened yet, so it
+// only depends on the BIOS and the kind of media in the drive, and a fast boot can start from there instead of
+// running the BIOS. A full boot doesn't qualify, OSDSYS reads its launch parameters from the kernel later on.
+
+static bool BootSnapshotEnabled()
+{
+    return EmuConfig.UseBootSnapshot && EmuConfig.UseBOOT2Injection;
+}
+
+static wxString GetBootSnapshotFilename()
+{
+    return (EmuFolders::Savestates + pxsFmt(L"BIOS (%08X).%02X.boot.p2s", BiosChecksum, (u32)cdvd.Type)).GetFullPath();
+}
+
+static void DiscardBootSnapshot(const wxString &filename)
+{
+    Console.Warning(L"Boot snapshot '%s' is unusable, running the BIOS instead.", WX_STR(filename));
+    wxRemoveFile(filename);
+    cpuReset();
+}
+
+// Called right after cpuReset(); returns false if the BIOS has to boot the machine itself.
+bool cpuLoadBootSnapshot()
+{
+    if (!BootSnapshotEnabled())
+        return false;
+
+    const wxString filename(GetBootSnapshotFilename());
+    if (!wxFileExists(filename))
+        return false;
+
+    Console.WriteLn(Color_StrongGreen, L"Restoring boot snapshot '%s'", WX_STR(filename));
+    try {
+        SaveState_UnzipFromDisk(filename);
+    } catch (BaseException &ex) {
+        Console.Error(ex.FormatDiagnosticMessage());
+        DiscardBootSnapshot(filename);
+        return false;
+    } catch (std::runtime_error &ex) {
+        Console.Error("%s", ex.what());
+        DiscardBootSnapshot(filename);
+        return false;
+    }
+
+    cdvdReloadHostState();
+
+    // The cpu resumes at EELOAD_START, which the interpreter only recognises while looking for it from a reset.
+    // See comments on this code in iR5900-32.cpp's recRecompile()
+    u32 mainjump = memRead32(EELOAD_START + 0x9c);
+    if (mainjump >> 26 == 3)    // JAL
+        g_eeloadMain = ((EELOAD_START + 0xa0) & 0xf0000000U) | (mainjump << 2 & 0x0fffffffU);
+
+    s_bootSnapshotDone = true;
+    return true;
+}
+
+// Called from recompilers; __fastcall define is mandatory.
+// Called whenever EELOAD_START is about to run, only the first time after a reset matters
+void __fastcall eeloadStartHook()
+{
+    if (s_bootSnapshotDone || !BootSnapshotEnabled())
+        return;
+    s_bootSnapshotDone = true;
+
+    const wxString filename(GetBootSnapshotFilename());
+    Console.WriteLn(Color_StrongGreen, L"Saving boot snapshot '%s'", WX_STR(filename));
+    try {
+        EmuFolders::Savestates.Mkdir();
+        std::unique_ptr<ArchiveEntryList> list(new ArchiveEntryList(new VmStateBuffer(L"BootSnapshot")));
+        SaveState_DownloadState(list.get());
+        SaveState_ZipToDisk(list.release(), filename);
+    } catch (BaseException &ex) {
+        Console.Error(ex.FormatDiagnosticMessage());
+    } catch (std::runtime_error &ex) {
+        Console.Error("%s", ex.what());
+    }
 }
 
 void cpuShutdown()
@@ -450,6 +539,9 @@ __fi void _cpuEventTest_Shared()
     cpuSetNextEvent(nextsCounter, nextCounter);
 
     eeEventTestIsActive = false;
+
+    // The event test is complete here, so the lockstep tester can stop the cpu without replaying any of it
+    Lockstep_EventTest();
 }
 
 __ri void cpuTestINTCInts()
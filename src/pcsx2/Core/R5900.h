@@ -268,6 +268,9 @@ void intSetBranch();
 // parts of the Recs (namely COP0's branch codes and stuff).
 void __fastcall intDoBranch(u32 target);
 
+// Interprets a single block on behalf of the recompiler, see recJITCompile.
+void intExecuteBlock();
+
 // modules loaded at hardcoded addresses by the kernel
 const u32 EEKERNEL_START	= 0;
 const u32 EENULL_START		= 0x81FC0;
@@ -276,6 +279,7 @@ const u32 EELOAD_SIZE		= 0x20000; // overestimate for searching
 extern u32 g_eeloadMain, g_eeloadExec;
 
 extern void __fastcall eeGameStarting();
+extern void __fastcall eeloadStartHook();
 extern void __fastcall eeloadHook();
 extern void __fastcall eeloadHook2();
 
@@ -433,6 +437,7 @@ extern uint dmacInterrupt();
 
 extern void cpuInit();
 extern void cpuReset();		// can throw Exception::FileNotFound.
+extern bool cpuLoadBootSnapshot();
 extern void cpuException(u32 code, u32 bd);
 extern void cpuTlbMissR(u32 addr, u32 bd);
 extern void cpuTlbMissW(u32 addr, u32 bd);
@@ -212,6 +212,49 @@ void _SPR0interleave()
     spr0ch.qwc = 0;
 }
 
+// Data a chain can stream in one event, one full pass over the scratchpad.
+static const u32 SPRChainStreamQWC = 0x400;
+
+// Once a tag's data went through, follows the rest of the destination chain in the same event.
+// The tags sit in the scratchpad right before their data, so they are read as it goes. Only CNT
+// tags into main RAM are followed (plus a final END), CNTS stall control, the MFIFO ring and VU
+// memory stay on the one event per tag path. Returns the cycles the extra tags took.
+static int SPR0chainStream(bool &done)
+{
+    if (spr0ch.qwc || mfifotransferred || dmacRegs.ctrl.STS == STS_fromSPR)
+        return 0;
+
+    int cycles   = 0;
+    u32 streamed = 0;
+    for (;;) {
+        tDMA_TAG *ptag = (tDMA_TAG *)&psSu32(spr0ch.sadr);
+        const u32 madr = ptag[1]._u32;
+        const u32 qwc  = ptag[0].QWC;
+        const u32 addr = madr & 0x1ffffff0;
+
+        if ((ptag->ID != TAG_CNT && ptag->ID != TAG_END) || (spr0ch.chcr.TIE && ptag->IRQ) ||
+            (madr & 0x70000000) == 0x70000000 || addr >= Ps2MemSize::MainRam ||
+            qwc > (Ps2MemSize::MainRam - addr) / 16 || streamed + qwc > SPRChainStreamQWC ||
+            (madr >= dmacRegs.rbor.ADDR && madr < (dmacRegs.rbor.ADDR + dmacRegs.rbsr.RMSK + 16u)))
+            return cycles;
+
+        spr0ch.sadr += 16;
+        spr0ch.sadr &= 0x3FFF;    // Limited to 16K
+        spr0ch.unsafeTransfer(ptag);
+        spr0ch.madr = madr;
+
+        cycles += _SPR0chain() * BIAS;
+        streamed += qwc;
+
+        if (ptag->ID == TAG_END) {
+            done = true;
+            return cycles;
+        }
+        if (spr0ch.qwc)
+            return cycles;
+    }
+}
+
 static __fi void _dmaSPR0()
 {
     // Transfer Dn_QWC from SPR to Dn_MADR
@@ -262,7 +305,7 @@ static __fi void _dmaSPR0()
                     break;
             }
 
-            SPR0chain();
+            int cycles = _SPR0chain() * BIAS;
 
             if (spr0ch.chcr.TIE && ptag->IRQ)    // Check TIE bit of CHCR and IRQ bit of tag
             {
@@ -270,6 +313,10 @@ static __fi void _dmaSPR0()
                 done = true;
             }
 
+            if (!done && cycles > 0)
+                cycles += SPR0chainStream(done);
+            CPU_INT(DMAC_FROM_SPR, cycles);
+
             spr0finished = done;
             // SPR_LOG("spr0 dmaChain complete %8.8x_%8.8x size=%d, id=%d, addr=%lx spr=%lx",
             // 	ptag[1]._u32, ptag[0]._u32, spr0ch.qwc, ptag->ID, spr0ch.madr);
@@ -406,6 +453,33 @@ void _SPR1interleave()
     spr1ch.qwc = 0;
 }
 
+// Once a tag's data went through, follows the rest of the chain in the same event, see
+// DMAChainWalk. Returns the cycles the extra tags took.
+static int SPR1chainStream(bool &done)
+{
+    if (spr1ch.qwc)
+        return 0;
+
+    DMAChainWalk walk;
+    hwDmacWalkSrcChain(spr1ch, walk, SPRChainStreamQWC);
+
+    int cycles = 0;
+    for (uint i = 0; i < walk.count; i++) {
+        tDMA_TAG *ptag = SPRdmaGetAddr(spr1ch.tadr, false);
+        spr1ch.unsafeTransfer(ptag);
+        spr1ch.madr = ptag[1]._u32;
+
+        if (spr1ch.chcr.TTE)
+            SPR1transfer(ptag, 1);
+
+        done = hwDmacSrcChain(spr1ch, ptag->ID);
+        cycles += _SPR1chain() * BIAS;
+        if (done || spr1ch.qwc)
+            break;
+    }
+    return cycles;
+}
+
 void _dmaSPR1()    // toSPR work function
 {
     switch (spr1ch.chcr.MOD) {
@@ -446,8 +520,8 @@ void _dmaSPR1()    // toSPR work function
             // SPR_LOG("spr1 dmaChain %8.8x_%8.8x size=%d, id=%d, addr=%lx taddr=%lx saddr=%lx",
             // 	ptag[1]._u32, ptag[0]._u32, spr1ch.qwc, ptag->ID, spr1ch.madr, spr1ch.tadr, spr1ch.sadr);
 
-            done = hwDmacSrcChain(spr1ch, ptag->ID);
-            SPR1chain();    // Transfers the data set by the switch
+            done       = hwDmacSrcChain(spr1ch, ptag->ID);
+            int cycles = _SPR1chain() * BIAS;    // Transfers the data set by the switch
 
             if (spr1ch.chcr.TIE && ptag->IRQ)    // Check TIE bit of CHCR and IRQ bit of tag
             {
@@ -457,6 +531,10 @@ void _dmaSPR1()    // toSPR work function
                 done = true;
             }
 
+            if (!done && cycles > 0)
+                cycles += SPR1chainStream(done);
+            CPU_INT(DMAC_TO_SPR, cycles);
+
             spr1finished = done;
             break;
         }
@@ -133,6 +133,8 @@ static const uint MainMemorySizeInBytes =
     Ps2MemSize::MainRam + Ps2MemSize::Scratch + Ps2MemSize::Hardware + Ps2MemSize::IopRam + Ps2MemSize::IopHardware;
 SaveStateBase &SaveStateBase::FreezeMainMemory()
 {
+    vu0Thread.WaitVU();    // Pause VU0 and pick up its E-Bit, the program carries on from the saved state
+    vu0Thread.Get_MTVUChanges();
     vu1Thread.WaitVU();    // Finish VU1 just in-case...
     if (IsLoading())
         PreLoadPrep();
@@ -153,6 +155,8 @@ SaveStateBase &SaveStateBase::FreezeMainMemory()
 }
 SaveStateBase &SaveStateBase::FreezeInternals()
 {
+    vu0Thread.WaitVU();
+    vu0Thread.Get_MTVUChanges();
     vu1Thread.WaitVU();    // Finish VU1 just in-case...
     // Print this until the MTVU problem in gifPathFreeze is taken care of (rama)
     if (THREAD_VU1)
@@ -649,6 +653,52 @@ static const std::unique_ptr<BaseSavestateEntry> SavestateEntries[] = {
     std::unique_ptr<BaseSavestateEntry>(new SavestateEntry_PAD),
     std::unique_ptr<BaseSavestateEntry>(new SavestateEntry_GS),
 };
+void SaveState_DownloadState(ArchiveEntryList *destlist)
+{
+    memSavingState saveme(destlist->GetBuffer());
+    ArchiveEntry   internals(EntryFilename_InternalStructures);
+    internals.SetDataIndex(saveme.GetCurrentPos());
+    saveme.FreezeBios();
+    saveme.FreezeInternals();
+    internals.SetDataSize(saveme.GetCurrentPos() - internals.GetDataIndex());
+    destlist->Add(internals);
+    for (uint i = 0; i < ArraySize(SavestateEntries); ++i) {
+        uint startpos = saveme.GetCurrentPos();
+        SavestateEntries[i]->FreezeOut(saveme);
+        destlist->Add(ArchiveEntry(SavestateEntries[i]->GetFilename())
+                          .SetDataIndex(startpos)
+                          .SetDataSize(saveme.GetCurrentPos() - startpos));
+    }
+}
+// Same components as a savestate file, without the archive around them. The plugin blocks go through the
+// buffer as they are, the session that reads them back is the one that wrote them.
+static void SysState_ComponentFreezeInPlace(SaveStateBase &state, SysState_Component comp)
+{
+    freezeData fP = {0, nullptr};
+    if (comp.freeze(FreezeAction::Size, &fP) != 0 || !fP.size)
+        return;
+    state.PrepBlock(fP.size);
+    fP.data = state.GetBlockPtr();
+    if (comp.freeze(state.IsSaving() ? FreezeAction::Save : FreezeAction::Load, &fP) != 0)
+        throw std::runtime_error(std::string(" * ") + comp.name + std::string(": Error freezing state!\n"));
+    state.CommitBlock(fP.size);
+}
+void SaveState_SaveToMemory(VmStateBuffer &buffer)
+{
+    memSavingState saveme(buffer);
+    saveme.FreezeBios().FreezeMainMemory().FreezeInternals();
+    SysState_ComponentFreezeInPlace(saveme, SPU2);
+    SysState_ComponentFreezeInPlace(saveme, PAD);
+    SysState_ComponentFreezeInPlace(saveme, GS);
+}
+void SaveState_LoadFromMemory(const VmStateBuffer &buffer)
+{
+    memLoadingState loadme(buffer);
+    loadme.FreezeBios().FreezeMainMemory().FreezeInternals();
+    SysState_ComponentFreezeInPlace(loadme, SPU2);
+    SysState_ComponentFreezeInPlace(loadme, PAD);
+    SysState_ComponentFreezeInPlace(loadme, GS);
+}
 // It's bad mojo to have savestates trying to read and write from the same file at the
 // same time.  To prevent that we use this mutex lock, which is used by both the
 // CompressThread and the UnzipFromDisk events.  (note that CompressThread locks the
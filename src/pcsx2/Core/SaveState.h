@@ -41,9 +41,12 @@ struct freezeData
 class ArchiveEntryList;
 // Wrappers to generate a save state compatible across all frontends.
 // These functions assume that the caller has paused the core thread.
-// extern void SaveState_DownloadState(ArchiveEntryList *destlist);
+extern void SaveState_DownloadState(ArchiveEntryList *destlist);
 extern void SaveState_ZipToDisk(ArchiveEntryList *srclist, const wxString &filename);
 extern void SaveState_UnzipFromDisk(const wxString &filename);
+// The whole machine in one uncompressed buffer, for snapshots taken and restored by the same session.
+extern void SaveState_SaveToMemory(VmStateBuffer &buffer);
+extern void SaveState_LoadFromMemory(const VmStateBuffer &buffer);
 // --------------------------------------------------------------------------------------
 //  SaveStateBase class
 // --------------------------------------------------------------------------------------
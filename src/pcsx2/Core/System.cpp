@@ -358,9 +358,11 @@ void SysMainMemory::DecommitAll()
     ConsoleIndentScope indent(1);
 
     // On linux, the MTVU isn't empty and the thread still uses the m_ee/m_vu memory
+    vu0Thread.WaitVU();
     vu1Thread.WaitVU();
     // The EE thread must be stopped here command mustn't be send
     // to the ring. Let's call it an extra safety valve :)
+    vu0Thread.Reset();
     vu1Thread.Reset();
 
     m_ee.Decommit();
@@ -487,6 +489,10 @@ void SysCpuProviderPack::ApplyConfig() const
         CpuVU1 = (BaseVUmicroCPU *)CpuProviders->microVU1;
 }
 
+RecompilerStats g_eeRecStats    = {};
+RecompilerStats g_iopRecStats   = {};
+RecompilerStats g_vuRecStats[2] = {};
+
 // Resets all PS2 cpu execution caches, which does not affect that actual PS2 state/condition.
 // This can be called at any time outside the context of a Cpu->Execute() block without
 // bad things happening (recompilers will slow down for a brief moment since rec code blocks
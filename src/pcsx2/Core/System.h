@@ -172,6 +172,22 @@ class SysCpuProviderPack {
 // implemented by the provisioning interface.
 extern SysCpuProviderPack &GetCpuProviders();
 
+// Recompiler activity since startup, only written by the thread running the recompiler.
+struct RecompilerStats
+{
+    u64 BlocksCompiled;
+    u64 CacheResets;      // all the code was dropped
+    u64 CacheFlushes;     // only the old generation of code was dropped
+    u64 BlocksEvicted;    // by flushes
+    u64 EvictedAge;       // blocks compiled after the evicted ones, summed over them
+    u64 CacheUsed;        // bytes of live code
+    u64 CacheSize;        // bytes of code the cache holds
+};
+
+extern RecompilerStats g_eeRecStats;
+extern RecompilerStats g_iopRecStats;
+extern RecompilerStats g_vuRecStats[2];
+
 // extern void SysLogMachineCaps();		// Detects cpu type and fills cpuInfo structs.
 extern void SysClearExecutionCache();    // clears recompiled execution caches!
 extern void SysOutOfMemory_EmergencyResponse(uptr blocksize);
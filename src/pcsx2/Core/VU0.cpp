@@ -30,6 +30,7 @@
 #include "R5900OpcodeTables.h"
 #include "VUmicro.h"
 #include "Vif_Dma.h"
+#include "MTVU.h"
 
 #define _Ft_ _Rt_
 #define _Fs_ _Rd_
@@ -67,6 +68,27 @@ __fi void _vu0run(bool breakOnMbit, bool addCycles)
     if (!(VU0.VI[REG_VPU_STAT].UL & 1))
         return;
 
+    if (THREAD_VU0) {
+        for (;;) {    // Let the VU0 thread finish its slice and hand it another one until E-Bit or M-Bit
+            vu0Thread.WaitVU();
+            vu0Thread.Get_MTVUChanges();
+            if (!(VU0.VI[REG_VPU_STAT].UL & 1) || (breakOnMbit && (VU0.flags & VUFLAG_MFLAGSET)))
+                break;
+            vu0Thread.ExecuteVU(-1, 0, 0);
+        }
+
+        // The EE waited for VU0 to get there
+        if (addCycles) {
+            if ((s32)(VU0.cycle - cpuRegs.cycle) > 0)
+                cpuRegs.cycle = VU0.cycle;
+            CpuVU1->ExecuteBlock(0);
+
+            if (VU0.VI[REG_VPU_STAT].UL & 1)
+                cpuSetNextEventDelta(4);
+        }
+        return;
+    }
+
     // VU0 is ahead of the EE and M-Bit is already encountered, so no need to wait for it, just catch up the EE
     if ((VU0.flags & VUFLAG_MFLAGSET) && breakOnMbit && (s32)(cpuRegs.cycle - VU0.cycle) <= 0) {
         cpuRegs.cycle = VU0.cycle;
@@ -105,6 +127,19 @@ void vu0Finish()
     _vu0run(0, 0);
 }    // Runs VU0 Micro Until E-Bit End (doesn't stall EE)
 
+// Stops the VU0 thread at the end of its current slice so the EE can touch VU0's registers or
+// memory, the program carries on from the next event test. Nothing to do when VU0 runs on the EE.
+void vu0Sync()
+{
+    if (!THREAD_VU0)
+        return;
+
+    vu0Thread.WaitVU();
+    vu0Thread.Get_MTVUChanges();
+    if (VU0.VI[REG_VPU_STAT].UL & 1)
+        cpuSetNextEventDelta(4);
+}
+
 namespace R5900 {
 namespace Interpreter {
 namespace OpcodeImpl {
@@ -23,20 +23,23 @@
 
 extern void _vuFlushAll(VURegs *VU);
 
-static void _vu0ExecUpper(VURegs *VU, u32 *ptr)
+static void _vu0ExecUpper(VURegs *VU, const _VUPredecoded &op)
 {
-    VU->code = ptr[1];
+    VU->code = op.upper;
     // IdebugUPPER(VU0);
-    VU0_UPPER_OPCODE[VU->code & 0x3f]();
+    op.execUpper();
 }
 
-static void _vu0ExecLower(VURegs *VU, u32 *ptr)
+static void _vu0ExecLower(VURegs *VU, const _VUPredecoded &op)
 {
-    VU->code = ptr[0];
+    VU->code = op.lower;
     // IdebugLOWER(VU0);
-    VU0_LOWER_OPCODE[VU->code >> 25]();
+    op.execLower();
 }
 
+// Decoded pairs of the micro memory, by TPC
+static _VUPredecoded s_vu0Predecoded[VU0_PROGSIZE / 8];
+
 int         vu0branch = 0;
 static void _vu0Exec(VURegs *VU)
 {
@@ -44,7 +47,8 @@ static void _vu0Exec(VURegs *VU)
     _VURegsNum uregs;
     u32       *ptr;
 
-    ptr = (u32 *)&VU->Micro[VU->VI[REG_TPC].UL];
+    ptr                 = (u32 *)&VU->Micro[VU->VI[REG_TPC].UL];
+    _VUPredecoded &slot = s_vu0Predecoded[(VU->VI[REG_TPC].UL / 8) % std::size(s_vu0Predecoded)];
     VU->VI[REG_TPC].UL += 8;
 
     if (ptr[1] & 0x40000000)    // E flag
@@ -74,8 +78,9 @@ static void _vu0Exec(VURegs *VU)
         }
     }
 
-    VU->code = ptr[1];
-    VU0regs_UPPER_OPCODE[VU->code & 0x3f](&uregs);
+    const _VUPredecoded &op = _vuPredecode(VU, slot, ptr);
+    uregs                   = op.uregs;
+    VU->code                = ptr[1];
 
     u32 cyclesBeforeOp = VU0.cycle - 1;
 
@@ -89,7 +94,7 @@ static void _vu0Exec(VURegs *VU)
         if (VU->VIBackupCycles > 0)
             VU->VIBackupCycles -= std::min((u8)(VU0.cycle - cyclesBeforeOp), VU->VIBackupCycles);
 
-        _vu0ExecUpper(VU, ptr);
+        _vu0ExecUpper(VU, op);
 
         VU->VI[REG_I].UL = ptr[0];
         memset(&lregs, 0, sizeof(lregs));
@@ -102,9 +107,8 @@ static void _vu0Exec(VURegs *VU)
         int    vireg   = 0;
         int    discard = 0;
 
-        VU->code     = ptr[0];
-        lregs.cycles = 0;
-        VU0regs_LOWER_OPCODE[VU->code >> 25](&lregs);
+        VU->code = ptr[0];
+        lregs    = op.lregs;
         _vuTestLowerStalls(VU, &lregs);
 
         _vuTestPipes(VU);
@@ -135,7 +139,7 @@ static void _vu0Exec(VURegs *VU)
             }
         }
 
-        _vu0ExecUpper(VU, ptr);
+        _vu0ExecUpper(VU, op);
 
         if (discard == 0) {
             if (vfreg) {
@@ -147,7 +151,7 @@ static void _vu0Exec(VURegs *VU)
                 VU->VI[vireg] = _VI;
             }
 
-            _vu0ExecLower(VU, ptr);
+            _vu0ExecLower(VU, op);
 
             if (vfreg) {
                 VU->VF[vfreg] = _VFc;
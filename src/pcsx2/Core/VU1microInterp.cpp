@@ -27,20 +27,23 @@
 extern void _vuFlushAll(VURegs *VU);
 extern void _vuXGKICKFlush(VURegs *VU);
 
-void _vu1ExecUpper(VURegs *VU, u32 *ptr)
+void _vu1ExecUpper(VURegs *VU, const _VUPredecoded &op)
 {
-    VU->code = ptr[1];
+    VU->code = op.upper;
     // IdebugUPPER(VU1);
-    VU1_UPPER_OPCODE[VU->code & 0x3f]();
+    op.execUpper();
 }
 
-void _vu1ExecLower(VURegs *VU, u32 *ptr)
+void _vu1ExecLower(VURegs *VU, const _VUPredecoded &op)
 {
-    VU->code = ptr[0];
+    VU->code = op.lower;
     // IdebugLOWER(VU1);
-    VU1_LOWER_OPCODE[VU->code >> 25]();
+    op.execLower();
 }
 
+// Decoded pairs of the micro memory, by TPC
+static _VUPredecoded s_vu1Predecoded[VU1_PROGSIZE / 8];
+
 int vu1branch = 0;
 
 static void _vu1Exec(VURegs *VU)
@@ -49,7 +52,8 @@ static void _vu1Exec(VURegs *VU)
     _VURegsNum uregs;
     u32       *ptr;
 
-    ptr = (u32 *)&VU->Micro[VU->VI[REG_TPC].UL];
+    ptr                 = (u32 *)&VU->Micro[VU->VI[REG_TPC].UL];
+    _VUPredecoded &slot = s_vu1Predecoded[(VU->VI[REG_TPC].UL / 8) % std::size(s_vu1Predecoded)];
     VU->VI[REG_TPC].UL += 8;
 
     if (ptr[1] & 0x40000000)    // E flag
@@ -76,8 +80,9 @@ static void _vu1Exec(VURegs *VU)
     // VUM_LOG("VU->cycle = %d (flags st=%x;mac=%x;clip=%x,q=%f)", VU->cycle, VU->statusflag, VU->macflag, VU->clipflag,
     // VU->q.F);
 
-    VU->code = ptr[1];
-    VU1regs_UPPER_OPCODE[VU->code & 0x3f](&uregs);
+    const _VUPredecoded &op = _vuPredecode(VU, slot, ptr);
+    uregs                   = op.uregs;
+    VU->code                = ptr[1];
 
     u32 cyclesBeforeOp = VU1.cycle - 1;
 
@@ -91,7 +96,7 @@ static void _vu1Exec(VURegs *VU)
         if (VU->VIBackupCycles > 0)
             VU->VIBackupCycles -= std::min((u8)(VU1.cycle - cyclesBeforeOp), VU->VIBackupCycles);
 
-        _vu1ExecUpper(VU, ptr);
+        _vu1ExecUpper(VU, op);
 
         VU->VI[REG_I].UL = ptr[0];
         // Lower not used, set to 0 to fill in the FMAC stall gap
@@ -106,9 +111,8 @@ static void _vu1Exec(VURegs *VU)
         int    vireg   = 0;
         int    discard = 0;
 
-        VU->code     = ptr[0];
-        lregs.cycles = 0;
-        VU1regs_LOWER_OPCODE[VU->code >> 25](&lregs);
+        VU->code = ptr[0];
+        lregs    = op.lregs;
 
         _vuTestLowerStalls(VU, &lregs);
         _vuTestPipes(VU);
@@ -141,7 +145,7 @@ static void _vu1Exec(VURegs *VU)
             }
         }
 
-        _vu1ExecUpper(VU, ptr);
+        _vu1ExecUpper(VU, op);
 
         if (discard == 0) {
             if (vfreg) {
@@ -153,7 +157,7 @@ static void _vu1Exec(VURegs *VU)
                 VU->VI[vireg] = _VI;
             }
 
-            _vu1ExecLower(VU, ptr);
+            _vu1ExecLower(VU, op);
 
             if (vfreg) {
                 VU->VF[vfreg] = _VFc;
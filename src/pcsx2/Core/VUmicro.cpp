@@ -34,6 +34,18 @@ void BaseVUmicroCPU::ExecuteBlock(bool startUp)
         return;
     }
 
+    if (!m_Idx && THREAD_VU0) {
+        // VU0 keeps its own time on the thread, only pick up E-Bits and hand out a new slice
+        if (startUp)
+            vu0Thread.ExecuteVU(-1, 0, 0);
+        else if ((stat & test) && vu0Thread.IsDone()) {
+            vu0Thread.Get_MTVUChanges();
+            if (stat & test)
+                vu0Thread.ExecuteVU(-1, 0, 0);
+        }
+        return;
+    }
+
 
     if (!(stat & test)) {
         // VU currently flushes XGKICK on VU1 end so no need for this, yet
@@ -73,6 +85,11 @@ void BaseVUmicroCPU::ExecuteBlockJIT(BaseVUmicroCPU *cpu)
     const u32 &stat = VU0.VI[REG_VPU_STAT].UL;
     const int  test = 1;
 
+    if (THREAD_VU0) {
+        vu0Sync();
+        return;
+    }
+
     // DevCon.Warning("Was set %d cycles ago", cpuRegs.cycle - setcycle);
     if (stat & test) {    // VU is running
         s32 delta = (s32)(u32)(cpuRegs.cycle - VU0.cycle);
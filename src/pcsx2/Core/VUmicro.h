@@ -30,6 +30,7 @@ static const uint VU1_MEMMASK  = VU1_MEMSIZE - 1;
 static const uint VU1_PROGMASK = VU1_PROGSIZE - 1;
 
 #define vu1RunCycles (3000000)    // mVU1 uses this for inf loop detection on dev builds
+#define vu0RunCycles (100000)     // VU0 thread hands back to the EE after this, so it can't spin forever
 
 // --------------------------------------------------------------------------------------
 //  BaseCpuProvider
@@ -319,6 +320,7 @@ extern void __fastcall vu0ExecMicro(u32 addr);
 extern void vu0Exec(VURegs *VU);
 extern void _vu0FinishMicro();
 extern void vu0Finish();
+extern void vu0Sync();
 extern void iDumpVU0Registers();
 
 // VU1
@@ -7720,12 +7720,61 @@ static void __vuRegsCall VU1regsunknown(_VURegsNum *VUregsn)
         PREFIX##LowerOP_T3_11_OPCODE[(VU.code >> 6) & 0x1f](VUregsn);                                                  \
     }
 
+// Skips the FD and LowerOP dispatchers, for the predecoded micro interpreters
+#define _vuTablesLeaf(PREFIX)                                                                                          \
+    static Fnptr_Void PREFIX##_UpperLeaf(u32 code)                                                                     \
+    {                                                                                                                  \
+        static const Fnptr_Void *const fd[4] = {PREFIX##_UPPER_FD_00_TABLE, PREFIX##_UPPER_FD_01_TABLE,                \
+                                                PREFIX##_UPPER_FD_10_TABLE, PREFIX##_UPPER_FD_11_TABLE};               \
+        if ((code & 0x3f) >= 0x3c)                                                                                     \
+            return fd[(code & 0x3f) - 0x3c][(code >> 6) & 0x1f];                                                       \
+        return PREFIX##_UPPER_OPCODE[code & 0x3f];                                                                     \
+    }                                                                                                                  \
+                                                                                                                       \
+    static Fnptr_Void PREFIX##_LowerLeaf(u32 code)                                                                     \
+    {                                                                                                                  \
+        static const Fnptr_Void *const t3[4] = {PREFIX##LowerOP_T3_00_OPCODE, PREFIX##LowerOP_T3_01_OPCODE,            \
+                                                PREFIX##LowerOP_T3_10_OPCODE, PREFIX##LowerOP_T3_11_OPCODE};           \
+        if ((code >> 25) != 0x40)                                                                                      \
+            return PREFIX##_LOWER_OPCODE[code >> 25];                                                                  \
+        if ((code & 0x3f) >= 0x3c)                                                                                     \
+            return t3[(code & 0x3f) - 0x3c][(code >> 6) & 0x1f];                                                       \
+        return PREFIX##LowerOP_OPCODE[code & 0x3f];                                                                    \
+    }
+
 _vuTablesPre(VU0, VU0) _vuTablesMess(VU0, Fnptr_Void) _vuTablesPost(VU0, VU0)
 
     _vuTablesPre(VU1, VU1) _vuTablesMess(VU1, Fnptr_Void) _vuTablesPost(VU1, VU1)
 
         _vuRegsTables(VU0, VU0regs, Fnptr_VuRegsN) _vuRegsTables(VU1, VU1regs, Fnptr_VuRegsN)
 
+            _vuTablesLeaf(VU0) _vuTablesLeaf(VU1)
+
+// Both words of the pair are kept, the entry is decoded again when the micro memory holds
+// something else at that address.
+const _VUPredecoded &_vuPredecode(VURegs *VU, _VUPredecoded &op, const u32 *ptr)
+{
+    if (op.execUpper && op.upper == ptr[1] && op.lower == ptr[0])
+        return op;
+
+    const bool vu0 = VU == &VU0;
+    op             = _VUPredecoded();
+    op.lower       = ptr[0];
+    op.upper       = ptr[1];
+
+    VU->code     = op.upper;
+    op.execUpper = vu0 ? VU0_UpperLeaf(op.upper) : VU1_UpperLeaf(op.upper);
+    (vu0 ? VU0regs_UPPER_OPCODE : VU1regs_UPPER_OPCODE)[op.upper & 0x3f](&op.uregs);
+
+    // With the I bit the lower word is a float for the I register
+    if (!(op.upper & 0x80000000)) {
+        VU->code     = op.lower;
+        op.execLower = vu0 ? VU0_LowerLeaf(op.lower) : VU1_LowerLeaf(op.lower);
+        (vu0 ? VU0regs_LOWER_OPCODE : VU1regs_LOWER_OPCODE)[op.lower >> 25](&op.lregs);
+    }
+    return op;
+}
+
 
     // --------------------------------------------------------------------------------------
     //  VU0macro (COP2)
@@ -56,6 +56,21 @@ extern __aligned16 const Fnptr_Void    VU1_UPPER_OPCODE[64];
 extern __aligned16 const Fnptr_VuRegsN VU1regs_LOWER_OPCODE[128];
 extern __aligned16 const Fnptr_VuRegsN VU1regs_UPPER_OPCODE[64];
 extern void                            _vuClearFMAC(VURegs *VU);
+
+// A micro instruction pair as the interpreters run it: the leaf handlers of both words and
+// their pipeline usage, worked out once for each address of the micro memory.
+struct _VUPredecoded
+{
+    u32        lower;
+    u32        upper;
+    Fnptr_Void execLower;
+    Fnptr_Void execUpper;
+    _VURegsNum lregs;
+    _VURegsNum uregs;
+};
+
+extern const _VUPredecoded &_vuPredecode(VURegs *VU, _VUPredecoded &op, const u32 *ptr);
+
 extern void                            _vuTestPipes(VURegs *VU);
 extern void                            _vuTestUpperStalls(VURegs *VU, _VURegsNum *VUregsn);
 extern void                            _vuTestLowerStalls(VURegs *VU, _VURegsNum *VUregsn);
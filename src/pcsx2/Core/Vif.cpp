@@ -32,6 +32,7 @@ void vif0Reset()
     memzero(vif0Regs);
 
     resetNewVif(0);
+    vifTraceReset(0);
 }
 
 void vif1Reset()
@@ -41,6 +42,7 @@ void vif1Reset()
     memzero(vif1Regs);
 
     resetNewVif(1);
+    vifTraceReset(1);
 }
 
 void SaveStateBase::vif0Freeze()
@@ -18,6 +18,7 @@
 #include "Vif_Dma.h"
 #include "VUmicro.h"
 #include "newVif.h"
+#include "common/Tracing.h"
 
 u32 g_vif0Cycles = 0;
 
@@ -160,6 +161,7 @@ __fi void vif0VUFinish()
 
 __fi void vif0Interrupt()
 {
+    TRACE_ZONE("VIF0 DMA");
     // VIF_LOG("vif0Interrupt: %8.8x", cpuRegs.cycle);
 
     g_vif0Cycles = 0;
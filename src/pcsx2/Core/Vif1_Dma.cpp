@@ -21,6 +21,7 @@
 #include "VUmicro.h"
 #include "newVif.h"
 #include "MTVU.h"
+#include "common/Tracing.h"
 
 u32 g_vif1Cycles = 0;
 
@@ -223,6 +224,37 @@ __fi void vif1SetupTransfer()
     }
 }
 
+// Data a chain can stream in one event, what the SPR moves in a single step, so the other
+// channels still get in regularly.
+static const u32 Vif1ChainStreamQWC = 0x400;
+
+// Once a tag's data went through, follows the rest of the chain without an event for every tag,
+// see DMAChainWalk. Stops as soon as the VIF stalls, waits on something, or leaves data behind,
+// vif1Interrupt picks it up from there like it always did.
+static void vif1ChainStream()
+{
+    if ((vif1.inprogress & 0x1) || vif1.done || vif1.dmamode != VIF_CHAIN_MODE || vif1ch.chcr.TTE)
+        return;
+
+    DMAChainWalk walk;
+    hwDmacWalkSrcChain(vif1ch, walk, Vif1ChainStreamQWC);
+
+    for (uint i = 0; i < walk.count; i++) {
+        const bool isDirect   = (vif1.cmd & 0x7f) == 0x50;
+        const bool isDirectHL = (vif1.cmd & 0x7f) == 0x51;
+        if (vif1.vifstalled.enabled || vif1.waitforvu || vif1.irq || vif1Regs.stat.VGW ||
+            vif1Regs.stat.test(VIF1_STAT_VSS | VIF1_STAT_VIS | VIF1_STAT_VFS) || !dmacRegs.ctrl.DMAE ||
+            gifRegs.stat.APATH == 2 || (isDirect && !gifUnit.CanDoPath2()) ||
+            (isDirectHL && !gifUnit.CanDoPath2HL()) || vif1ch.tadr != walk.seg[i].tadr)
+            return;
+
+        vif1SetupTransfer();
+        _VIF1chain();
+        if ((vif1.inprogress & 0x1) || vif1.done)
+            return;
+    }
+}
+
 __fi void vif1VUFinish()
 {
     if (VU0.VI[REG_VPU_STAT].UL & 0x500) {
@@ -261,6 +293,7 @@ __fi void vif1VUFinish()
 
 __fi void vif1Interrupt()
 {
+    TRACE_ZONE("VIF1 DMA");
     // VIF_LOG("vif1Interrupt: %8.8x chcr %x, done %x, qwc %x", cpuRegs.cycle, vif1ch.chcr._u32, vif1.done, vif1ch.qwc);
 
     g_vif1Cycles = 0;
@@ -356,6 +389,7 @@ __fi void vif1Interrupt()
 
     if (vif1.inprogress & 0x1) {
         _VIF1chain();
+        vif1ChainStream();
         // VIF_NORMAL_FROM_MEM_MODE is a very slow operation.
         // Timesplitters 2 depends on this beeing a bit higher than 128.
         if (vif1ch.chcr.DIR)
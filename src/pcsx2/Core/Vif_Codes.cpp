@@ -326,7 +326,9 @@ static __fi void _vifCode_MPG(int idx, u32 addr, const u32 *data, int size)
 
     vifExecQueue(idx);
 
-    if (idx && THREAD_VU1) {
+    if (!idx)
+        vu0Sync();
+    else if (THREAD_VU1) {
         if ((addr + size * 4) > vuMemSize) {
             vu1Thread.WriteMicroMem(addr, (u8 *)data, vuMemSize - addr);
             size -= (vuMemSize - addr) / 4;
@@ -136,4 +136,8 @@ extern u32 g_vif1Cycles;
 extern void vif0FLUSH();
 extern void vif1FLUSH();
 
-extern void vifExecQueue(int idx);
\ No newline at end of file
+extern void vifExecQueue(int idx);
+
+// Replays decoded runs of register codes and unpacks, see Vif_Trace.cpp (enabled by VIF_TRACE)
+_vifT extern bool vifTraceRun(u32*& data);
+extern void vifTraceReset(int idx);
\ No newline at end of file
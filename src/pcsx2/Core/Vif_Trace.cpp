@@ -0,0 +1,402 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Core/PrecompiledHeader.h"
+#include "Common.h"
+#include "Vif_Dma.h"
+#include "newVif.h"
+#include "MTVU.h"
+
+//------------------------------------------------------------------
+// VifCode Trace Cache (Vif0/Vif1)
+//------------------------------------------------------------------
+// Games send the same packets every frame: a few register codes followed by unpacks, with only the
+// unpacked data changing. A trace is the decoded form of such a run of vifcodes, keyed on the control
+// words, with the register codes between two unpacks folded into a single write of their final
+// values. Replaying it skips the per-code dispatch and pass handling of vifTransferLoop.
+//
+// Only codes whose effect depends on nothing but the vifcode and the packet data are traced. Anything
+// touching the VU, the GIF or the stall state (MSCAL*, MSCNT, FLUSH*, MPG, DIRECT*, MSKPATH3), unknown
+// codes and codes with the I bit end the trace, and the normal interpreter takes over from there.
+
+static const uint VifTraceMaxOps    = 16;
+static const uint VifTraceMinCodes  = 2;    // a single code isn't worth the lookup
+static const uint VifTraceBuckets   = 0x100;
+static const uint VifTraceBucketMax = 4;
+
+enum VifTraceOpType : u8
+{
+    VifTrace_Regs,
+    VifTrace_Nop,
+    VifTrace_Unpack,
+};
+
+enum VifTraceSet : u32
+{
+    VifTraceSet_Cycle     = 1 << 0,
+    VifTraceSet_Mode      = 1 << 1,
+    VifTraceSet_ITop      = 1 << 2,
+    VifTraceSet_Mark      = 1 << 3,
+    VifTraceSet_Mask      = 1 << 4,
+    VifTraceSet_Row       = 1 << 5,
+    VifTraceSet_Col       = 1 << 6,
+    VifTraceSet_Base      = 1 << 7,
+    VifTraceSet_Offset    = 1 << 8,
+    VifTraceSet_TopsConst = 1 << 9,    // OFFSET came after a BASE of the same run
+};
+
+struct VifTraceOp
+{
+    VifTraceOpType type;
+    u32            offset;    // Unpack: position of the vifcode in the packet
+    u32            code;      // Unpack: the vifcode
+    u32            size;      // Unpack: data words following the vifcode
+
+    // VifTrace_Regs, the final values of a run of register codes
+    u32      set;
+    vifCycle cycle;
+    u32      mode;
+    u32      itops;
+    u32      mark;
+    u32      base;
+    u32      ofst;
+    u32      tops;
+    u32      maskOffset;    // STMASK/STROW/STCOL data is read from the packet at replay
+    u32      rowOffset;
+    u32      colOffset;
+};
+
+struct VifTrace
+{
+    u32 firstCode;
+    u32 cycle;     // CYCLE at the start, unpack sizes depend on it until the first STCYCL
+    u32 length;    // words of packet covered
+    u32 lastCode;  // left in the CODE register
+    u32 numCodes;
+    u32 numOps;
+    u32 codeOffset[VifTraceMaxOps];
+    u32 code[VifTraceMaxOps];
+    VifTraceOp ops[VifTraceMaxOps];
+};
+
+struct VifTraceBucket
+{
+    VifTrace trace[VifTraceBucketMax];
+    u32      count;
+    u32      next;    // replaced next once full
+};
+
+static std::unique_ptr<VifTraceBucket[]> s_vifTraces[2];
+
+void vifTraceReset(int idx)
+{
+    if (!VIF_TRACE)
+        return;
+    if (!s_vifTraces[idx])
+        s_vifTraces[idx].reset(new VifTraceBucket[VifTraceBuckets]);
+    for (uint i = 0; i < VifTraceBuckets; i++)
+        s_vifTraces[idx][i].count = s_vifTraces[idx][i].next = 0;
+}
+
+static __fi u32 vifTraceCycle(const vifCycle &cycle)
+{
+    return cycle.cl | (cycle.wl << 8);
+}
+
+static __fi uint vifTraceBucketIndex(u32 code, u32 cycle)
+{
+    return (code ^ (code >> 16) ^ (cycle << 2)) & (VifTraceBuckets - 1);
+}
+
+// Same size vifUnpackSetup gives tag.size
+static __fi u32 vifTraceUnpackSize(u32 code, u32 cycle)
+{
+    const u8  gsize = nVifT[(code >> 24) & 0x0f];
+    const int cl    = cycle & 0xff;
+    const int wl    = (cycle >> 8) ? (cycle >> 8) : 256;
+    int       num   = (code >> 16) & 0xff;
+    if (num == 0)
+        num = 256;
+
+    if (wl <= cl)
+        return ((num * gsize) + 3) / 4;
+    const int n = cl * (num / wl) + _limit(num % wl, cl);
+    return ((n * gsize) + 3) >> 2;
+}
+
+static __fi VifTraceOp &vifTraceRegsOp(VifTrace &trace)
+{
+    if (!trace.numOps || trace.ops[trace.numOps - 1].type != VifTrace_Regs) {
+        VifTraceOp &op = trace.ops[trace.numOps++];
+        memzero(op);
+        op.type = VifTrace_Regs;
+    }
+    return trace.ops[trace.numOps - 1];
+}
+
+// Decodes the traceable codes at the start of the packet, false if there are too few of them
+_vifT static bool vifTraceBuild(VifTrace &trace, const u32 *data, u32 pSize)
+{
+    u32 cycle = vifTraceCycle(vifXRegs.cycle);
+    u32 pos   = 0;
+
+    trace.firstCode = data[0];
+    trace.cycle     = cycle;
+    trace.numCodes  = 0;
+    trace.numOps    = 0;
+
+    while (pos < pSize && trace.numCodes < VifTraceMaxOps) {
+        const u32 code = data[pos];
+        const u32 cmd  = (code >> 24) & 0x7f;
+        u32       size = 1;
+
+        if (code & 0x80000000)
+            break;
+
+        if ((cmd & 0x60) == 0x60) {
+            if (!nVifT[cmd & 0x0f])
+                break;
+            size += vifTraceUnpackSize(code, cycle);
+        } else if (cmd == 0x20) {
+            size = 2;
+        } else if (cmd == 0x30 || cmd == 0x31) {
+            size = 5;
+        } else if (cmd == 0x00) {
+            // NOP stalls the transfer when a masking MSKPATH3 follows
+            if (pos + 1 < pSize && ((data[pos + 1] >> 24) & 0x7f) == 0x6 && (data[pos + 1] & 0x1))
+                break;
+        } else if (cmd > 0x07 || cmd == 0x06 || (!idx && (cmd == 0x02 || cmd == 0x03))) {
+            break;
+        }
+
+        if (pos + size > pSize)
+            break;
+
+        switch (cmd) {
+            case 0x00:
+                trace.ops[trace.numOps++].type = VifTrace_Nop;
+                break;
+            case 0x01: {
+                VifTraceOp &op = vifTraceRegsOp(trace);
+                op.set |= VifTraceSet_Cycle;
+                op.cycle.cl = (u8)code;
+                op.cycle.wl = (u8)(code >> 8);
+                cycle       = code & 0xffff;
+                break;
+            }
+            case 0x02: {
+                VifTraceOp &op = vifTraceRegsOp(trace);
+                op.set |= VifTraceSet_Offset;
+                op.ofst = code & 0x3ff;
+                if (op.set & VifTraceSet_Base) {
+                    op.set |= VifTraceSet_TopsConst;
+                    op.tops = op.base;
+                } else
+                    op.set &= ~VifTraceSet_TopsConst;
+                break;
+            }
+            case 0x03: {
+                VifTraceOp &op = vifTraceRegsOp(trace);
+                op.set |= VifTraceSet_Base;
+                op.base = code & 0x3ff;
+                break;
+            }
+            case 0x04: {
+                VifTraceOp &op = vifTraceRegsOp(trace);
+                op.set |= VifTraceSet_ITop;
+                op.itops = code & 0x3ff;
+                break;
+            }
+            case 0x05: {
+                VifTraceOp &op = vifTraceRegsOp(trace);
+                op.set |= VifTraceSet_Mode;
+                op.mode = code & 0x3;
+                break;
+            }
+            case 0x07: {
+                VifTraceOp &op = vifTraceRegsOp(trace);
+                op.set |= VifTraceSet_Mark;
+                op.mark = (u16)code;
+                break;
+            }
+            case 0x20: {
+                VifTraceOp &op = vifTraceRegsOp(trace);
+                op.set |= VifTraceSet_Mask;
+                op.maskOffset = pos + 1;
+                break;
+            }
+            case 0x30: {
+                VifTraceOp &op = vifTraceRegsOp(trace);
+                op.set |= VifTraceSet_Row;
+                op.rowOffset = pos + 1;
+                break;
+            }
+            case 0x31: {
+                VifTraceOp &op = vifTraceRegsOp(trace);
+                op.set |= VifTraceSet_Col;
+                op.colOffset = pos + 1;
+                break;
+            }
+            default: {
+                VifTraceOp &op = trace.ops[trace.numOps++];
+                op.type        = VifTrace_Unpack;
+                op.offset      = pos;
+                op.code        = code;
+                op.size        = size - 1;
+                break;
+            }
+        }
+
+        trace.codeOffset[trace.numCodes] = pos;
+        trace.code[trace.numCodes++]     = code;
+        trace.lastCode                   = code;
+        pos += size;
+    }
+
+    // A NOP stalls or not depending on the code after it, which a replay only checks when that code
+    // is part of the trace, so the trace stops before any trailing NOPs.
+    while (trace.numCodes && !((trace.code[trace.numCodes - 1] >> 24) & 0x7f)) {
+        pos = trace.codeOffset[--trace.numCodes];
+        trace.numOps--;
+    }
+    trace.lastCode = trace.numCodes ? trace.code[trace.numCodes - 1] : 0;
+
+    trace.length = pos;
+    return trace.numCodes >= VifTraceMinCodes;
+}
+
+_vifT static __fi void vifTraceApplyRegs(const VifTraceOp &op, const u32 *data)
+{
+    vifStruct    &vifX    = GetVifX;
+    VIFregisters &vifRegs = vifXRegs;
+
+    if (op.set & VifTraceSet_Cycle)
+        vifRegs.cycle = op.cycle;
+    if (op.set & VifTraceSet_Mode)
+        vifRegs.mode = op.mode;
+    if (op.set & VifTraceSet_ITop)
+        vifRegs.itops = op.itops;
+    if (op.set & VifTraceSet_Mark) {
+        vifRegs.mark     = op.mark;
+        vifRegs.stat.MRK = true;
+    }
+    if (op.set & VifTraceSet_Mask)
+        vifRegs.mask = data[op.maskOffset];
+    if (op.set & VifTraceSet_Row) {
+        memcpy(&vifX.MaskRow, &data[op.rowOffset], sizeof(vifX.MaskRow));
+        if (idx)
+            vu1Thread.WriteRow(vifX);
+    }
+    if (op.set & VifTraceSet_Col) {
+        memcpy(&vifX.MaskCol, &data[op.colOffset], sizeof(vifX.MaskCol));
+        if (idx)
+            vu1Thread.WriteCol(vifX);
+    }
+    // VIF1 only, the build doesn't take OFFSET/BASE on VIF0
+    if (op.set & VifTraceSet_Offset) {
+        vif1Regs.stat.DBF = false;
+        vif1Regs.ofst     = op.ofst;
+        if (!(op.set & VifTraceSet_TopsConst))
+            vif1Regs.tops = vif1Regs.base;
+    }
+    if (op.set & VifTraceSet_Base)
+        vif1Regs.base = op.base;
+    if (op.set & VifTraceSet_TopsConst)
+        vif1Regs.tops = op.tops;
+}
+
+_vifT static void vifTraceReplay(const VifTrace &trace, u32 *&data)
+{
+    vifStruct &vifX  = GetVifX;
+    const u32  pSize = vifX.vifpacketsize;
+
+    for (u32 i = 0; i < trace.numOps; i++) {
+        const VifTraceOp &op = trace.ops[i];
+        switch (op.type) {
+            case VifTrace_Regs:
+                vifTraceApplyRegs<idx>(op, data);
+                break;
+            case VifTrace_Nop:
+                vifExecQueue(idx);
+                break;
+            case VifTrace_Unpack: {
+                vifXRegs.code      = op.code;
+                vifX.cmd           = op.code >> 24;
+                vifX.vifpacketsize = pSize - op.offset;
+                vifUnpackSetup<idx>(&data[op.offset]);
+                pxAssume(vifX.tag.size == op.size);
+                vifX.vifpacketsize--;
+                nVifUnpack<idx>((const u8 *)&data[op.offset + 1]);
+                break;
+            }
+                jNO_DEFAULT
+        }
+    }
+
+    vifXRegs.code      = trace.lastCode;
+    vifX.cmd           = 0;
+    vifX.pass          = 0;
+    vifX.tag.size      = 0;
+    vifX.vifpacketsize = pSize - trace.length;
+    data += trace.length;
+}
+
+// Runs the trace of the codes at the start of the packet, building it on a miss. Returns false
+// without touching anything when the packet doesn't start with a traceable run.
+_vifT bool vifTraceRun(u32 *&data)
+{
+    vifStruct &vifX  = GetVifX;
+    const u32  pSize = vifX.vifpacketsize;
+
+    if (!VIF_TRACE || vifX.cmd || vifX.irq || vifX.vifstalled.enabled || nVif[idx].bSize || pSize < 2)
+        return false;
+    if (!s_vifTraces[idx])
+        vifTraceReset(idx);    // switched on since the last reset
+
+    const u32 code  = data[0];
+    const u32 cycle = vifTraceCycle(vifXRegs.cycle);
+    const u32 cmd   = (code >> 24) & 0x7f;
+    if ((code & 0x80000000) || !((cmd & 0x60) == 0x60 || cmd == 0x20 || cmd == 0x30 || cmd == 0x31 || cmd <= 0x07))
+        return false;
+
+    VifTraceBucket &bucket = s_vifTraces[idx][vifTraceBucketIndex(code, cycle)];
+    for (u32 i = 0; i < bucket.count; i++) {
+        const VifTrace &trace = bucket.trace[i];
+        if (trace.firstCode != code || trace.cycle != cycle || trace.length > pSize)
+            continue;
+
+        u32 c = 1;
+        while (c < trace.numCodes && data[trace.codeOffset[c]] == trace.code[c])
+            c++;
+        if (c < trace.numCodes)
+            continue;
+
+        vifTraceReplay<idx>(trace, data);
+        return true;
+    }
+
+    // Packets that don't make a trace are decoded again each time, that's as cheap as the lookup would be
+    VifTrace trace;
+    if (!vifTraceBuild<idx>(trace, data, pSize))
+        return false;
+
+    const u32 slot     = bucket.count < VifTraceBucketMax ? bucket.count++ : bucket.next++ % VifTraceBucketMax;
+    bucket.trace[slot] = trace;
+    vifTraceReplay<idx>(bucket.trace[slot], data);
+    return true;
+}
+
+template bool vifTraceRun<0>(u32 *&data);
+template bool vifTraceRun<1>(u32 *&data);
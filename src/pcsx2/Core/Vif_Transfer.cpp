@@ -36,6 +36,9 @@ _vifT void vifTransferLoop(u32 *&data)
     // VIF_LOG("Starting VIF%d loop, pSize = %x, stalled = %x", idx, pSize, vifX.vifstalled.enabled );
     while (pSize > 0 && !vifX.vifstalled.enabled) {
 
+        if (!vifX.cmd && vifTraceRun<idx>(data))
+            continue;
+
         if (!vifX.cmd) {    // Get new VifCode
 
             if (!vifXRegs.err.MII) {
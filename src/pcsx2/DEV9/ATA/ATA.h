@@ -21,7 +21,10 @@
 #include <mutex>
 #include <condition_variable>
 #include <ghc/filesystem.h>
-#include <fstream>
+#include <vector>
+#ifdef _WIN32
+#include <Windows.h>
+#endif
 
 #include "DEV9/SimpleQueue.h"
 
@@ -35,7 +38,12 @@ public:
 private:
 	const bool lba48Supported = false;
 
-	std::fstream hddImage;
+	//Accessed with positional reads/writes only, so the IO thread never shares a file position with anyone
+#ifdef _WIN32
+	HANDLE hddImage = INVALID_HANDLE_VALUE;
+#else
+	int hddImage = -1;
+#endif
 	u64 hddImageSize;
 
 	int pioMode;
@@ -110,6 +118,8 @@ private:
 		u64 sector;
 	};
 	SimpleQueue<WriteQueueEntry> writeQueue;
+	//Adjacent queued writes are merged into a single write through here
+	std::vector<u8> ioWriteBuffer;
 
 	std::thread ioThread;
 	bool ioRunning = false;
@@ -200,6 +210,9 @@ private:
 	void ClearHOB();
 
 	//Transfer
+	bool HDD_IsOpen();
+	bool HDD_ReadImage(u8* data, u64 offset, u32 length);
+	bool HDD_WriteImage(const u8* data, u64 offset, u32 length);
 	void IO_Thread();
 	void IO_Read();
 	bool IO_Write();
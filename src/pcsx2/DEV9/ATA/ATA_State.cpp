@@ -15,6 +15,11 @@
 
 #include "Core/PrecompiledHeader.h"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #include "ATA.h"
 #include "DEV9/DEV9.h"
 #include "HddCreate.h"
@@ -43,11 +48,22 @@ int ATA::Open(ghc::filesystem::path hddPath)
         if (hddCreator.errored)
             return -1;
     }
-    hddImage = ghc::filesystem::fstream(hddPath, std::ios::in | std::ios::out | std::ios::binary);
+#ifdef _WIN32
+    hddImage = CreateFileW(hddPath.wstring().c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+#else
+    hddImage = open(hddPath.c_str(), O_RDWR);
+#endif
+    if (!HDD_IsOpen()) {
+        Console.Error("DEV9: ATA: Failed to open HDD image");
+        return -1;
+    }
 
     // Store HddImage size for later check
-    hddImage.seekg(0, std::ios::end);
-    hddImageSize = hddImage.tellg();
+    std::error_code ec;
+    hddImageSize = ghc::filesystem::file_size(hddPath, ec);
+    if (ec)
+        hddImageSize = 0;
 
     {
         std::lock_guard ioSignallock(ioMutex);
@@ -84,8 +100,17 @@ void ATA::Close()
     }
 
     // Close File Handle
-    if (hddImage.is_open())
-        hddImage.close();
+    if (HDD_IsOpen()) {
+#ifdef _WIN32
+        CloseHandle(hddImage);
+        hddImage = INVALID_HANDLE_VALUE;
+#else
+        close(hddImage);
+        hddImage = -1;
+#endif
+    }
+    ioWriteBuffer.clear();
+    ioWriteBuffer.shrink_to_fit();
 
     delete[] readBuffer;
     readBuffer = nullptr;
@@ -274,7 +299,7 @@ void ATA::Write16(u32 addr, u16 value)
 
 void ATA::Async(uint cycles)
 {
-    if (!hddImage.is_open())
+    if (!HDD_IsOpen())
         return;
 
     if ((regStatus & (ATA_STAT_BUSY | ATA_STAT_DRQ)) == 0 || awaitFlush || (waitingCmd != nullptr)) {
@@ -15,9 +15,79 @@
 
 #include "Core/PrecompiledHeader.h"
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 #include "ATA.h"
 #include "DEV9/DEV9.h"
 
+// Upper bound for merging queued writes, a single DMA write is at most 256 sectors
+static constexpr u32 MaxCoalescedWrite = 2 * 1024 * 1024;
+
+bool ATA::HDD_IsOpen()
+{
+#ifdef _WIN32
+    return hddImage != INVALID_HANDLE_VALUE;
+#else
+    return hddImage != -1;
+#endif
+}
+
+// Reads past the end of the image return zeros, the image may be shorter than the configured size
+bool ATA::HDD_ReadImage(u8 *data, u64 offset, u32 length)
+{
+    while (length > 0) {
+#ifdef _WIN32
+        OVERLAPPED ov = {};
+        ov.Offset     = (DWORD)offset;
+        ov.OffsetHigh = (DWORD)(offset >> 32);
+        DWORD read    = 0;
+        if (!ReadFile(hddImage, data, length, &read, &ov) && GetLastError() != ERROR_HANDLE_EOF)
+            return false;
+#else
+        const ssize_t read = pread(hddImage, data, length, offset);
+        if (read < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+#endif
+        if (read == 0) {
+            memset(data, 0, length);
+            return true;
+        }
+        data += read;
+        offset += read;
+        length -= read;
+    }
+    return true;
+}
+
+bool ATA::HDD_WriteImage(const u8 *data, u64 offset, u32 length)
+{
+    while (length > 0) {
+#ifdef _WIN32
+        OVERLAPPED ov = {};
+        ov.Offset     = (DWORD)offset;
+        ov.OffsetHigh = (DWORD)(offset >> 32);
+        DWORD written = 0;
+        if (!WriteFile(hddImage, data, length, &written, &ov) || written == 0)
+            return false;
+#else
+        const ssize_t written = pwrite(hddImage, data, length, offset);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            return false;
+#endif
+        data += written;
+        offset += written;
+        length -= written;
+    }
+    return true;
+}
+
 void ATA::IO_Thread()
 {
     std::unique_lock ioWaitHandle(ioMutex);
@@ -68,13 +138,11 @@ void ATA::IO_Read()
     }
 
     const u64 pos = lba * 512;
-    hddImage.seekg(pos, std::ios::beg);
-    if (hddImage.fail()) {
+    if (!HDD_ReadImage(readBuffer, pos, (u32)nsector * 512)) {
         Console.Error("DEV9: ATA: File read error");
         pxAssert(false);
         abort();
     }
-    hddImage.read((char *)readBuffer, (u64)nsector * 512);
     {
         std::lock_guard ioSignallock(ioMutex);
         ioRead = false;
@@ -90,14 +158,27 @@ bool ATA::IO_Write()
         return false;
     }
 
-    hddImage.seekp(entry.sector * 512, std::ios::beg);
-    hddImage.write((char *)entry.data, entry.length);
-    if (hddImage.fail()) {
+    // Merge whatever follows on directly from this write, games tend to write files as a run of DMA transfers
+    WriteQueueEntry next;
+    u32             length = entry.length;
+    bool            merged = false;
+    while (writeQueue.Peek(&next) && next.sector * 512 == entry.sector * 512 + length &&
+           length + next.length <= MaxCoalescedWrite) {
+        if (!merged)
+            ioWriteBuffer.assign(entry.data, entry.data + entry.length);
+        merged = true;
+        ioWriteBuffer.insert(ioWriteBuffer.end(), next.data, next.data + next.length);
+        length += next.length;
+        writeQueue.Dequeue(&next);
+        delete[] next.data;
+    }
+
+    const u8 *data = merged ? ioWriteBuffer.data() : entry.data;
+    if (!HDD_WriteImage(data, entry.sector * 512, length)) {
         Console.Error("DEV9: ATA: File write error");
         pxAssert(false);
         abort();
     }
-    hddImage.flush();
     delete[] entry.data;
     return true;
 }
@@ -17,6 +17,10 @@
 
 #include <fstream>
 #include <wx/app.h>
+#ifdef _WIN32
+#include <Windows.h>
+#include <winioctl.h>
+#endif
 #include "HddCreate.h"
 
 void HddCreate::Start()
@@ -70,9 +74,6 @@ void HddCreate::Start()
 
 void HddCreate::WriteImage(ghc::filesystem::path hddPath, int reqSizeMiB)
 {
-    constexpr int buffsize       = 4 * 1024;
-    u8            buff[buffsize] = {0};    // 4kb
-
     if (ghc::filesystem::exists(hddPath)) {
         SetError();
         return;
@@ -84,49 +85,33 @@ void HddCreate::WriteImage(ghc::filesystem::path hddPath, int reqSizeMiB)
         SetError();
         return;
     }
+    newImage.close();
+
+#ifdef _WIN32
+    // NTFS only leaves holes in files flagged as sparse, otherwise the first write near the end of the image would
+    // allocate and zero everything before it
+    HANDLE sparseImage = CreateFileW(hddPath.wstring().c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+                                     OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (sparseImage != INVALID_HANDLE_VALUE) {
+        DWORD bytesReturned;
+        DeviceIoControl(sparseImage, FSCTL_SET_SPARSE, nullptr, 0, nullptr, 0, &bytesReturned, nullptr);
+        CloseHandle(sparseImage);
+    }
+#endif
 
     // Size file
-    newImage.seekp(((u64)reqSizeMiB) * 1024 * 1024 - 1, std::ios::beg);
-    const char zero = 0;
-    newImage.write(&zero, 1);
+    // The image is left as one big hole, unwritten sectors read back as zero and take no disk space until the
+    // guest writes to them
+    std::error_code ec;
+    ghc::filesystem::resize_file(hddPath, ((u64)reqSizeMiB) * 1024 * 1024, ec);
 
-    if (newImage.fail()) {
-        newImage.close();
-        ghc::filesystem::remove(filePath);
+    if (ec || canceled.load()) {
+        ghc::filesystem::remove(hddPath, ec);
         SetError();
         return;
     }
 
-    lastUpdate = std::chrono::steady_clock::now();
-
-    newImage.seekp(0, std::ios::beg);
-
-    for (int iMiB = 0; iMiB < reqSizeMiB; iMiB++) {
-        for (int i4kb = 0; i4kb < 256; i4kb++) {
-            newImage.write((char *)buff, buffsize);
-            if (newImage.fail()) {
-                newImage.close();
-                ghc::filesystem::remove(filePath);
-                SetError();
-                return;
-            }
-        }
-
-        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
-        if (std::chrono::duration_cast<std::chrono::milliseconds>(now - lastUpdate).count() >= 100 ||
-            (iMiB + 1) == neededSize) {
-            lastUpdate = now;
-            SetFileProgress(iMiB + 1);
-        }
-        if (canceled.load()) {
-            newImage.close();
-            ghc::filesystem::remove(filePath);
-            SetError();
-            return;
-        }
-    }
-    newImage.flush();
-    newImage.close();
+    SetFileProgress(reqSizeMiB);
 }
 
 void HddCreate::SetFileProgress(int currentSize)
@@ -37,6 +37,8 @@ public:
 	void Enqueue(T entry);
 	//Used by single worker thread (i.e. IO)
 	bool Dequeue(T* entry);
+	//Used by single worker thread, looks at the next entry without removing it
+	bool Peek(T* entry);
 	//May return false negative when another thread is mid Queue()
 	//Intended to only be used from queue thread
 	bool IsQueueEmpty();
@@ -80,6 +82,16 @@ bool SimpleQueue<T>::Dequeue(T* entry)
 	return true;
 }
 
+template <class T>
+bool SimpleQueue<T>::Peek(T* entry)
+{
+	if (!tail->ready.load())
+		return false;
+
+	*entry = tail->value;
+	return true;
+}
+
 //Note, next entry may not be ready to dequeue
 template <class T>
 bool SimpleQueue<T>::IsQueueEmpty()
@@ -8,6 +8,8 @@
 #include "Renderers/OpenGL/GSDeviceOGL.h"
 #include "Renderers/OpenGL/GSRendererOGL.h"
 #include "GSLzma.h"
+#include "GSPipeline.h"
+#include "Host.h"
 #include "common/pxStreams.h"
 #include "Config.h"
 #include <wx/stdpaths.h>
@@ -27,11 +29,14 @@ static HRESULT s_hr = E_FAIL;
 #include <fstream>
 #undef None
 static GSRenderer *s_gs        = NULL;
+static GSPipeline *s_pipeline  = NULL;
+static GSState    *s_gif       = NULL;    // parses the GIF packets, s_gs itself or the front end of s_pipeline
 static uint8      *s_basemem   = NULL;
 static int         s_vsync     = 0;
 static bool        s_exclusive = true;
 static std::string s_renderer_name;
 bool               gsopen_done = false;
+static std::atomic_bool s_vsync_changed{false};    // the pipeline only takes calls from the MTGS, see GSvsync
 #ifndef PCSX2_CORE
 static std::atomic_bool s_gs_window_resized{false};
 static std::mutex       s_gs_window_resized_lock;
@@ -44,12 +49,42 @@ extern wxString appIniPath;
 
 std::unique_ptr<GSScanlineConstantData> g_const;
 
+// Renderer and device calls go through here, with the pipeline enabled they are queued to its render thread
+// behind the draws already sent. GSRenderSync also waits for them, calls that return something have to.
+template <typename F> static void GSRender(F func)
+{
+    if (s_pipeline)
+        s_pipeline->Post(func);
+    else
+        func();
+}
+template <typename F> static void GSRenderSync(F func)
+{
+    if (s_pipeline)
+        s_pipeline->Sync(func);
+    else
+        func();
+}
+static void GSdestroy()
+{
+    if (s_pipeline) {
+        GSRenderSync([] { delete s_gs; });
+        delete s_pipeline;
+        s_pipeline = NULL;
+    } else {
+        delete s_gs;
+    }
+    s_gs  = NULL;
+    s_gif = NULL;
+}
+
 void GSsetBaseMem(uint8 *mem)
 {
     s_basemem = mem;
-    if (s_gs) {
+    if (s_pipeline)
+        s_pipeline->SetRegsMem(s_basemem);
+    else if (s_gs)
         s_gs->SetRegsMem(s_basemem);
-    }
 }
 int GSinit()
 {
@@ -71,8 +106,7 @@ int GSinit()
 void GSshutdown()
 {
     gsopen_done = false;
-    delete s_gs;
-    s_gs = nullptr;
+    GSdestroy();
     theApp.SetCurrentRendererType(GSRendererType::Undefined);
 #ifdef _WIN32
     if (SUCCEEDED(s_hr)) {
@@ -89,9 +123,11 @@ void GSclose()
 #endif
     if (s_gs == NULL)
         return;
-    s_gs->ResetDevice();
-    delete s_gs->m_dev;
-    s_gs->m_dev = NULL;
+    GSRenderSync([] {
+        s_gs->ResetDevice();
+        delete s_gs->m_dev;
+        s_gs->m_dev = NULL;
+    });
 }
 int _GSopen(const WindowInfo &wi, const char *title, GSRendererType renderer, int threads = -1)
 {
@@ -104,8 +140,7 @@ int _GSopen(const WindowInfo &wi, const char *title, GSRendererType renderer, in
     }
     try {
         if (theApp.GetCurrentRendererType() != renderer) {
-            delete s_gs;
-            s_gs = NULL;
+            GSdestroy();
             theApp.SetCurrentRendererType(renderer);
         }
         std::string renderer_name;
@@ -146,20 +181,32 @@ int _GSopen(const WindowInfo &wi, const char *title, GSRendererType renderer, in
             }
             if (s_gs == NULL)
                 return -1;
+            if (theApp.GetConfigB("render_thread"))
+                s_pipeline = new GSPipeline(s_gs);
+            s_gif = s_pipeline ? s_pipeline->GetFrontend() : s_gs;
         }
     } catch (std::exception &ex) {
         printf("GS error: Exception caught in GSopen: %s", ex.what());
         return -1;
     }
-    s_gs->SetRegsMem(s_basemem);
-    s_gs->SetVSync(s_vsync);
-    if (!s_gs->CreateDevice(dev, wi)) {
+    // with the pipeline the renderer keeps its own copy of the registers, see GSPipeline::VSync
+    if (s_pipeline)
+        s_pipeline->SetRegsMem(s_basemem);
+    else
+        s_gs->SetRegsMem(s_basemem);
+    // the device (and its context) belongs to the thread that creates it
+    bool created = false;
+    GSRenderSync([&] {
+        s_gs->SetVSync(s_vsync);
+        created = s_gs->CreateDevice(dev, wi);
+    });
+    if (!created) {
         GSclose();
         return -1;
     }
     if (renderer == GSRendererType::OGL_HW && theApp.GetConfigI("debug_glsl_shader") == 2) {
         printf("GS: test OpenGL shader. Please wait...\n\n");
-        static_cast<GSDeviceOGL *>(s_gs->m_dev)->SelfShaderTest();
+        GSRenderSync([] { static_cast<GSDeviceOGL *>(s_gs->m_dev)->SelfShaderTest(); });
         printf("\nGS: test OpenGL shader done. It will now exit\n");
         return -1;
     }
@@ -167,13 +214,19 @@ int _GSopen(const WindowInfo &wi, const char *title, GSRendererType renderer, in
 }
 void GSosdLog(const char *utf8, uint32 color)
 {
-    if (s_gs && s_gs->m_dev)
-        s_gs->m_dev->m_osd.Log(utf8);
+    if (s_gs)
+        GSRender([msg = std::string(utf8)] {
+            if (s_gs->m_dev)
+                s_gs->m_dev->m_osd.Log(msg.c_str());
+        });
 }
 void GSosdMonitor(const char *key, const char *value, uint32 color)
 {
-    if (s_gs && s_gs->m_dev)
-        s_gs->m_dev->m_osd.Monitor(key, value);
+    if (s_gs)
+        GSRender([k = std::string(key), v = std::string(value)] {
+            if (s_gs->m_dev)
+                s_gs->m_dev->m_osd.Monitor(k.c_str(), v.c_str());
+        });
 }
 int GSopen2(const WindowInfo &wi, uint32 flags)
 {
@@ -203,21 +256,25 @@ int GSopen2(const WindowInfo &wi, uint32 flags)
 void GSreset()
 {
     try {
-        s_gs->Reset();
+        s_gif->Reset();
+        if (s_pipeline)
+            GSRender([] { s_gs->Reset(); });
     } catch (GSRecoverableError) {
     }
 }
 void GSgifSoftReset(uint32 mask)
 {
     try {
-        s_gs->SoftReset(mask);
+        s_gif->SoftReset(mask);
+        if (s_pipeline)
+            GSRender([mask] { s_gs->SoftReset(mask); });
     } catch (GSRecoverableError) {
     }
 }
 void GSwriteCSR(uint32 csr)
 {
     try {
-        s_gs->WriteCSR(csr);
+        s_gif->WriteCSR(csr);
     } catch (GSRecoverableError) {
     }
 }
@@ -225,7 +282,10 @@ void GSinitReadFIFO(uint8 *mem)
 {
     GL_PERF("Init Read FIFO1");
     try {
-        s_gs->InitReadFIFO(mem, 1);
+        if (s_pipeline)
+            s_pipeline->InitReadFIFO(mem, 1);
+        else
+            s_gs->InitReadFIFO(mem, 1);
     } catch (GSRecoverableError) {
     } catch (const std::bad_alloc &) {
         fprintf(stderr, "GS: Memory allocation error\n");
@@ -234,7 +294,10 @@ void GSinitReadFIFO(uint8 *mem)
 void GSreadFIFO(uint8 *mem)
 {
     try {
-        s_gs->ReadFIFO(mem, 1);
+        if (s_pipeline)
+            s_pipeline->ReadFIFO(mem, 1);
+        else
+            s_gs->ReadFIFO(mem, 1);
     } catch (GSRecoverableError) {
     } catch (const std::bad_alloc &) {
         fprintf(stderr, "GS: Memory allocation error\n");
@@ -244,7 +307,10 @@ void GSinitReadFIFO2(uint8 *mem, uint32 size)
 {
     GL_PERF("Init Read FIFO2");
     try {
-        s_gs->InitReadFIFO(mem, size);
+        if (s_pipeline)
+            s_pipeline->InitReadFIFO(mem, size);
+        else
+            s_gs->InitReadFIFO(mem, size);
     } catch (GSRecoverableError) {
     } catch (const std::bad_alloc &) {
         fprintf(stderr, "GS: Memory allocation error\n");
@@ -253,7 +319,10 @@ void GSinitReadFIFO2(uint8 *mem, uint32 size)
 void GSreadFIFO2(uint8 *mem, uint32 size)
 {
     try {
-        s_gs->ReadFIFO(mem, size);
+        if (s_pipeline)
+            s_pipeline->ReadFIFO(mem, size);
+        else
+            s_gs->ReadFIFO(mem, size);
     } catch (GSRecoverableError) {
     } catch (const std::bad_alloc &) {
         fprintf(stderr, "GS: Memory allocation error\n");
@@ -262,35 +331,40 @@ void GSreadFIFO2(uint8 *mem, uint32 size)
 void GSgifTransfer(const uint8 *mem, uint32 size)
 {
     try {
-        s_gs->Transfer<3>(mem, size);
+        s_gif->Transfer<3>(mem, size);
     } catch (GSRecoverableError) {
     }
 }
 void GSgifTransfer1(uint8 *mem, uint32 addr)
 {
     try {
-        s_gs->Transfer<0>(const_cast<uint8 *>(mem) + addr, (0x4000 - addr) / 16);
+        s_gif->Transfer<0>(const_cast<uint8 *>(mem) + addr, (0x4000 - addr) / 16);
     } catch (GSRecoverableError) {
     }
 }
 void GSgifTransfer2(uint8 *mem, uint32 size)
 {
     try {
-        s_gs->Transfer<1>(const_cast<uint8 *>(mem), size);
+        s_gif->Transfer<1>(const_cast<uint8 *>(mem), size);
     } catch (GSRecoverableError) {
     }
 }
 void GSgifTransfer3(uint8 *mem, uint32 size)
 {
     try {
-        s_gs->Transfer<2>(const_cast<uint8 *>(mem), size);
+        s_gif->Transfer<2>(const_cast<uint8 *>(mem), size);
     } catch (GSRecoverableError) {
     }
 }
 void GSvsync(int field)
 {
     try {
-        s_gs->VSync(field);
+        if (s_pipeline && s_vsync_changed.exchange(false))
+            GSRender([vsync = s_vsync] { s_gs->SetVSync(vsync); });
+        if (s_pipeline)
+            s_pipeline->VSync(field);
+        else
+            s_gs->VSync(field);
     } catch (GSRecoverableError) {
     } catch (const std::bad_alloc &) {
         fprintf(stderr, "GS: Memory allocation error\n");
@@ -300,6 +374,7 @@ uint32 GSmakeSnapshot(char *path)
 {
     try {
         std::string s{path};
+        bool        png = false;
         if (!s.empty()) {
             std::string extension = s.substr(s.size() - 4, 4);
 #ifdef _WIN32
@@ -308,11 +383,18 @@ uint32 GSmakeSnapshot(char *path)
             std::transform(extension.begin(), extension.end(), extension.begin(), tolower);
 #endif
             if (extension == ".png")
-                return s_gs->MakeSnapshot(s);
+                png = true;
             else if (s[s.length() - 1] != DIRECTORY_SEPARATOR)
                 s = s + DIRECTORY_SEPARATOR;
         }
-        return s_gs->MakeSnapshot(s + "gs");
+        if (!png)
+            s += "gs";
+        bool ret = false;
+        GSRenderSync([&] { ret = s_gs->MakeSnapshot(s); });
+        // the snapshot is taken on the next vsync, which may also open a GS dump
+        if (ret && s_pipeline)
+            s_pipeline->SyncNextVSync();
+        return ret;
     } catch (GSRecoverableError) {
         return false;
     }
@@ -321,7 +403,7 @@ void GSkeyEvent(const HostKeyEvent &e)
 {
     try {
         if (gsopen_done) {
-            s_gs->KeyEvent(e);
+            GSRender([e] { s_gs->KeyEvent(e); });
         }
     } catch (GSRecoverableError) {
     }
@@ -329,7 +411,15 @@ void GSkeyEvent(const HostKeyEvent &e)
 int GSfreeze(FreezeAction mode, freezeData *data)
 {
     try {
-        if (mode == FreezeAction::Save) {
+        if (s_pipeline) {
+            if (mode == FreezeAction::Save) {
+                return s_pipeline->Freeze(data, false);
+            } else if (mode == FreezeAction::Size) {
+                return s_pipeline->Freeze(data, true);
+            } else if (mode == FreezeAction::Load) {
+                return s_pipeline->Defrost(data);
+            }
+        } else if (mode == FreezeAction::Save) {
             return s_gs->Freeze(data, false);
         } else if (mode == FreezeAction::Size) {
             return s_gs->Freeze(data, true);
@@ -396,7 +486,9 @@ bool GSsetupRecording(std::string &filename)
     }
 #endif
     printf("GS: Recording start command\n");
-    if (s_gs->BeginCapture(filename)) {
+    bool started = false;
+    GSRenderSync([&] { started = s_gs->BeginCapture(filename); });
+    if (started) {
         pt(" - Capture started\n");
         return true;
     } else {
@@ -407,12 +499,14 @@ bool GSsetupRecording(std::string &filename)
 void GSendRecording()
 {
     printf("GS: Recording end command\n");
-    s_gs->EndCapture();
+    GSRender([] { s_gs->EndCapture(); });
     pt(" - Capture ended\n");
 }
 void GSsetGameCRC(uint32 crc, int options)
 {
-    s_gs->SetGameCRC(crc, options);
+    s_gif->SetGameCRC(crc, options);
+    if (s_pipeline)
+        GSRender([crc, options] { s_gs->SetGameCRC(crc, options); });
 }
 void GSgetTitleInfo2(char *dest, size_t length)
 {
@@ -429,21 +523,26 @@ void GSgetTitleInfo2(char *dest, size_t length)
 }
 void GSsetFrameSkip(int frameskip)
 {
-    s_gs->SetFrameSkip(frameskip);
+    s_gif->SetFrameSkip(frameskip);
+    if (s_pipeline)
+        GSRender([frameskip] { s_gs->SetFrameSkip(frameskip); });
 }
 void GSsetVsync(int vsync)
 {
     s_vsync = vsync;
-    if (s_gs) {
+    // called from the core thread too, GSvsync hands it to the pipeline
+    if (s_pipeline)
+        s_vsync_changed = true;
+    else if (s_gs)
         s_gs->SetVSync(s_vsync);
-    }
 }
 void GSsetExclusive(int enabled)
 {
     s_exclusive = !!enabled;
-    if (s_gs) {
+    if (s_pipeline)
+        s_vsync_changed = true;
+    else if (s_gs)
         s_gs->SetVSync(s_vsync);
-    }
 }
 #ifndef PCSX2_CORE
 void GSResizeWindow(int width, int height)
@@ -833,6 +932,7 @@ void GSApp::Init()
     m_default_configuration["accurate_blending_unit"]   = "1";
     m_default_configuration["AspectRatio"]              = "1";
     m_default_configuration["autoflush_sw"]             = "1";
+    m_default_configuration["batch_draws"]              = "0";
     m_default_configuration["capture_enabled"]          = "0";
     m_default_configuration["capture_out_dir"]          = "/tmp/GS_Capture";
     m_default_configuration["capture_threads"]          = "4";
@@ -890,6 +990,7 @@ void GSApp::Init()
     m_default_configuration["paltex"]                     = "0";
     m_default_configuration["png_compression_level"]      = std::to_string(Z_BEST_SPEED);
     m_default_configuration["preload_frame_with_gs_data"] = "0";
+    m_default_configuration["render_thread"]              = "0";
     m_default_configuration["Renderer"]                   = std::to_string(static_cast<int>(GSRendererType::Default));
     m_default_configuration["resx"]                       = "1024";
     m_default_configuration["resy"]                       = "1024";
@@ -372,6 +372,11 @@ enum GIF_REG_COMPLEX
 {
 	GIF_REG_STQRGBAXYZF2 = 0x00,
 	GIF_REG_STQRGBAXYZ2 = 0x01,
+	GIF_REG_UVRGBAXYZF2 = 0x02,
+	GIF_REG_UVRGBAXYZ2 = 0x03,
+	GIF_REG_RGBAXYZF2 = 0x04,
+	GIF_REG_RGBAXYZ2 = 0x05,
+	GIF_REG_COMPLEX_LAST,
 };
 
 enum GIF_A_D_REG
@@ -1414,9 +1419,25 @@ struct alignas(32) GIFPath
 		TYPE_UNKNOWN,
 		TYPE_ADONLY,
 		TYPE_STQRGBAXYZF2,
-		TYPE_STQRGBAXYZ2
+		TYPE_STQRGBAXYZ2,
+		TYPE_UVRGBAXYZF2,
+		TYPE_UVRGBAXYZ2,
+		TYPE_RGBAXYZF2,
+		TYPE_RGBAXYZ2
 	};
 
+	// true if the register list repeats itself every n registers (ffx: 9 regs = 3 x 040102, dq8: 12 regs = 4 x 040102)
+	template <int n>
+	__forceinline bool IsRepeating() const
+	{
+		if (nreg <= n || nreg % n != 0)
+			return false;
+
+		const int m = (1 << (nreg - n)) - 1;
+
+		return (regs.eq8(regs.srl<n>()).mask() & m) == m;
+	}
+
 	__forceinline void SetTag(const void* mem)
 	{
 		const GIFTag* RESTRICT src = (const GIFTag*)mem;
@@ -1450,63 +1471,50 @@ struct alignas(32) GIFPath
 			}
 			else
 			{
-				switch (nreg)
+				// collapse tags sending several vertices per loop into the vertex format they repeat
+				uint32 period = nreg;
+
+				if (IsRepeating<3>())
+					period = 3;
+				else if (IsRepeating<2>())
+					period = 2;
+
+				// TODO: formats mixed with NOPs (xeno2: 040f010f02, 04010f020f, mgs3: 04010f0f02, 0401020f0f, 04010f020f)
+				switch (period)
 				{
-					case 1:
-						break;
 					case 2:
+						if (regs.u16[0] == 0x0401)
+							type = TYPE_RGBAXYZF2;
+						if (regs.u16[0] == 0x0501)
+							type = TYPE_RGBAXYZ2;
 						break;
 					case 3:
-						// many games, TODO: formats mixed with NOPs (xeno2: 040f010f02, 04010f020f, mgs3: 04010f0f02, 0401020f0f, 04010f020f)
-						if (regs.u32[0] == 0x00040102)
-							type = TYPE_STQRGBAXYZF2;
-						// GoW (has other crazy formats, like ...030503050103)
-						if (regs.u32[0] == 0x00050102)
-							type = TYPE_STQRGBAXYZ2;
-						// TODO: common types with UV instead
-						break;
-					case 4:
-						break;
-					case 5:
-						break;
-					case 6:
-						break;
-					case 7:
-						break;
-					case 8:
-						break;
-					case 9:
-						// ffx
-						if (regs.u32[0] == 0x02040102 && regs.u32[1] == 0x01020401 && regs.u32[2] == 0x00000004)
+						switch (regs.u32[0] & 0x00ffffff)
 						{
-							type = TYPE_STQRGBAXYZF2;
-							nreg = 3;
-							nloop *= 3;
+							case 0x040102: // many games
+								type = TYPE_STQRGBAXYZF2;
+								break;
+							case 0x050102: // GoW (has other crazy formats, like ...030503050103)
+								type = TYPE_STQRGBAXYZ2;
+								break;
+							case 0x040103:
+								type = TYPE_UVRGBAXYZF2;
+								break;
+							case 0x050103:
+								type = TYPE_UVRGBAXYZ2;
+								break;
+							default:
+								break;
 						}
 						break;
-					case 10:
-						break;
-					case 11:
-						break;
-					case 12:
-						// dq8 (not many, mostly 040102)
-						if (regs.u32[0] == 0x02040102 && regs.u32[1] == 0x01020401 && regs.u32[2] == 0x04010204)
-						{
-							type = TYPE_STQRGBAXYZF2;
-							nreg = 3;
-							nloop *= 4;
-						}
-						break;
-					case 13:
-						break;
-					case 14:
-						break;
-					case 15:
-						break;
-					case 16:
-						break;
 					default:
-						__assume(0);
+						break;
+				}
+
+				if (type != TYPE_UNKNOWN && period != nreg)
+				{
+					nloop *= nreg / period;
+					nreg = period;
 				}
 			}
 		}
@@ -154,6 +154,14 @@ void GSClut::Write(const GIFRegTEX0 &TEX0, const GIFRegTEXCLUT &TEXCLUT)
     (this->*m_wc[TEX0.CSM][TEX0.CPSM][TEX0.PSM])(TEX0, TEXCLUT);
 }
 
+// The palette was loaded into another copy of local memory, only WriteTest has to know about it
+void GSClut::MarkWritten(const GIFRegTEX0 &TEX0, const GIFRegTEXCLUT &TEXCLUT)
+{
+    m_write.TEX0    = TEX0;
+    m_write.TEXCLUT = TEXCLUT;
+    m_write.dirty   = false;
+}
+
 void GSClut::WriteCLUT32_I8_CSM1(const GIFRegTEX0 &TEX0, const GIFRegTEXCLUT &TEXCLUT)
 {
     ALIGN_STACK(32);
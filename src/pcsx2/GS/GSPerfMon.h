@@ -39,6 +39,7 @@ public:
 		Fillrate,
 		Quad,
 		SyncPoint,
+		Batch,
 		CounterLast,
 	};
 
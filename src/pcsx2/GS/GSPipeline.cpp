@@ -0,0 +1,335 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Core/PrecompiledHeader.h"
+#include "GSPipeline.h"
+
+GSPipeline::Record::Record()
+    : vertex(NULL), index(NULL), maxcount(0), head(0), tail(0), next(0), index_tail(0), packed_uv(false), field(0)
+{
+}
+
+GSPipeline::Record::~Record()
+{
+    _aligned_free(vertex);
+    _aligned_free(index);
+}
+
+// Same layout as GSState::GrowVertexBuffer, the buffers are handed over to the renderer for the duration of the draw
+void GSPipeline::Record::Reserve(size_t count)
+{
+    if (count <= maxcount)
+        return;
+    const size_t size = std::max<size_t>(count * 3 / 2, 1024);
+    _aligned_free(vertex);
+    _aligned_free(index);
+    vertex = (GSVertex *)_aligned_malloc(sizeof(GSVertex) * size, 32);
+    index  = (uint32 *)_aligned_malloc(sizeof(uint32) * size * 3, 32);
+    if (vertex == NULL || index == NULL) {
+        Console.Error("GS: failed to allocate %zu vertices for the draw queue.", size);
+        throw GSError();
+    }
+    maxcount = size - 3;
+}
+
+GSPipeline::Frontend::Frontend(GSPipeline *pipeline)
+    : m_pipeline(pipeline)
+{
+    m_batch_draws = theApp.GetConfigB("batch_draws");
+}
+
+void GSPipeline::Frontend::RenderPrim()
+{
+    Record &rec = m_pipeline->NextRecord();
+    // worst case is slightly less than vertex number * 3 indices, see GrowVertexBuffer
+    rec.Reserve(std::max<size_t>(m_vertex.tail, m_index.tail / 3 + 1));
+    rec.env        = m_env;
+    rec.head       = m_vertex.head;
+    rec.tail       = m_vertex.tail;
+    rec.next       = m_vertex.next;
+    rec.index_tail = m_index.tail;
+    rec.packed_uv  = m_isPackedUV_HackFlag;
+    memcpy(rec.vertex, m_vertex.buff, sizeof(GSVertex) * m_vertex.tail);
+    memcpy(rec.index, m_index.buff, sizeof(uint32) * m_index.tail);
+    m_pipeline->Push(Op::Draw, &rec);
+}
+
+void GSPipeline::Frontend::BeginTransfer()
+{
+    Record &rec       = m_pipeline->NextRecord();
+    rec.env.BITBLTBUF = m_env.BITBLTBUF;
+    rec.env.TRXPOS    = m_env.TRXPOS;
+    rec.env.TRXREG    = m_env.TRXREG;
+    rec.env.TRXDIR    = m_env.TRXDIR;
+    m_pipeline->Push(Op::Transfer, &rec);
+}
+
+void GSPipeline::Frontend::WriteCLUT(const GIFRegTEX0 &TEX0, const GIFRegTEXCLUT &TEXCLUT)
+{
+    Record &rec = m_pipeline->NextRecord();
+    rec.TEX0    = TEX0;
+    rec.TEXCLUT = TEXCLUT;
+    m_pipeline->Push(Op::CLUT, &rec);
+    // the palette itself is loaded by the renderer, the front end's copy of local memory is stale
+    m_mem.m_clut.MarkWritten(TEX0, TEXCLUT);
+}
+
+// The dump belongs to the renderer, it only gets the packets while one may be open (see ReplayVSync)
+void GSPipeline::Frontend::DumpTransfer(int index, const uint8 *mem, size_t size)
+{
+    if (!m_pipeline->m_dumping)
+        return;
+    Record &rec = m_pipeline->NextRecord();
+    rec.field   = index;
+    rec.data.assign(mem, mem + size);
+    m_pipeline->Push(Op::Dump, &rec);
+}
+
+void GSPipeline::Frontend::Write(const uint8 *mem, int len)
+{
+    SubmitBatch();
+    if (PRIM->TME && (m_env.BITBLTBUF.DBP == m_context->TEX0.TBP0 || m_env.BITBLTBUF.DBP == m_context->TEX0.CBP))
+        FlushPrim();
+    Record &rec = m_pipeline->NextRecord();
+    rec.data.assign(mem, mem + len);
+    m_pipeline->Push(Op::Write, &rec);
+    m_mem.m_clut.Invalidate();
+}
+
+GSPipeline::GSPipeline(GSRenderer *renderer)
+    : m_renderer(renderer), m_frontend(this), m_record_pos(0), m_sync_vsync(false), m_dumping(false),
+      m_vsync_pending(0), m_queue([this](Command &cmd) { Process(cmd); })
+{
+    memset(&m_regs, 0, sizeof(m_regs));
+    m_renderer->SetRegsMem((uint8 *)&m_regs);
+}
+
+GSPipeline::~GSPipeline()
+{
+    m_queue.Wait();
+}
+
+// A record is reused QUEUE_SIZE commands later, the queue never holds more than QUEUE_SIZE - 1 of them
+GSPipeline::Record &GSPipeline::NextRecord()
+{
+    Record &rec  = m_records[m_record_pos];
+    m_record_pos = (m_record_pos + 1) % QUEUE_SIZE;
+    return rec;
+}
+
+void GSPipeline::Push(Op op, Record *rec, const std::function<void()> *func)
+{
+    Command cmd;
+    cmd.op   = op;
+    cmd.rec  = rec;
+    cmd.func = func;
+    m_queue.Push(cmd);
+}
+
+void GSPipeline::Process(Command &cmd)
+{
+    try {
+        switch (cmd.op) {
+            case Op::Draw:
+                ReplayDraw(*cmd.rec);
+                break;
+            case Op::Transfer:
+                ReplayTransfer(*cmd.rec);
+                break;
+            case Op::Write:
+                m_renderer->Write(cmd.rec->data.data(), (int)cmd.rec->data.size());
+                break;
+            case Op::CLUT:
+                m_renderer->FlushWrite();
+                m_renderer->WriteCLUT(cmd.rec->TEX0, cmd.rec->TEXCLUT);
+                break;
+            case Op::VSync:
+                ReplayVSync(*cmd.rec);
+                break;
+            case Op::Dump:
+                if (m_renderer->m_dump)
+                    m_renderer->m_dump->Transfer(cmd.rec->field, cmd.rec->data.data(), cmd.rec->data.size());
+                break;
+            case Op::Call:
+                if (cmd.rec) {
+                    cmd.rec->func();
+                    cmd.rec->func = nullptr;
+                } else {
+                    m_renderer->m_perfmon.Put(GSPerfMon::SyncPoint, 1);
+                    (*cmd.func)();
+                }
+                break;
+        }
+    } catch (GSRecoverableError &) {
+    } catch (...) {
+        // rethrown on the MTGS thread by Sync, everything else has nobody waiting for it
+        if (cmd.op == Op::Call && !cmd.rec)
+            m_exception = std::current_exception();
+        else
+            Console.Error("GS: Exception caught on the render thread.");
+    }
+    if (cmd.op == Op::VSync) {
+        {
+            std::lock_guard<std::mutex> lock(m_vsync_lock);
+            m_vsync_pending--;
+        }
+        m_vsync_done.notify_one();
+    }
+}
+
+void GSPipeline::ReplayDraw(Record &rec)
+{
+    GSState &s = *m_renderer;
+    s.FlushWrite();
+    // the renderer keeps its own transfer registers, they go with m_tr and the pending upload
+    const GIFRegBITBLTBUF BITBLTBUF = s.m_env.BITBLTBUF;
+    const GIFRegTRXPOS    TRXPOS    = s.m_env.TRXPOS;
+    const GIFRegTRXREG    TRXREG    = s.m_env.TRXREG;
+    const GIFRegTRXDIR    TRXDIR    = s.m_env.TRXDIR;
+    s.m_env                         = rec.env;
+    s.m_env.BITBLTBUF               = BITBLTBUF;
+    s.m_env.TRXPOS                  = TRXPOS;
+    s.m_env.TRXREG                  = TRXREG;
+    s.m_env.TRXDIR                  = TRXDIR;
+    s.UpdateContext();
+    std::swap(s.m_vertex.buff, rec.vertex);
+    std::swap(s.m_vertex.maxcount, rec.maxcount);
+    std::swap(s.m_index.buff, rec.index);
+    s.m_vertex.head         = rec.head;
+    s.m_vertex.tail         = rec.tail;
+    s.m_vertex.next         = rec.next;
+    s.m_index.tail          = rec.index_tail;
+    s.m_isPackedUV_HackFlag = rec.packed_uv;
+    s.RenderPrim();
+    s.m_vertex.head = 0;
+    s.m_vertex.tail = 0;
+    s.m_vertex.next = 0;
+    s.m_index.tail  = 0;
+    // the draw may have grown the buffers, the record just keeps whatever it gets back
+    std::swap(s.m_vertex.buff, rec.vertex);
+    std::swap(s.m_vertex.maxcount, rec.maxcount);
+    std::swap(s.m_index.buff, rec.index);
+}
+
+void GSPipeline::ReplayTransfer(const Record &rec)
+{
+    GSState &s = *m_renderer;
+    // registers changing under a partial upload flush it with the old ones, like GIFRegHandlerBITBLTBUF does
+    s.FlushWrite();
+    s.m_env.BITBLTBUF = rec.env.BITBLTBUF;
+    s.m_env.TRXPOS    = rec.env.TRXPOS;
+    s.m_env.TRXREG    = rec.env.TRXREG;
+    s.m_env.TRXDIR    = rec.env.TRXDIR;
+    s.BeginTransfer();
+}
+
+// The privileged registers are read as they were at the vsync, the MTGS may already be writing the next frame's
+void GSPipeline::ReplayVSync(const Record &rec)
+{
+    memcpy(&m_regs, rec.data.data(), sizeof(m_regs));
+    m_renderer->VSync(rec.field);
+    m_dumping = m_renderer->m_dump != nullptr;
+}
+
+void GSPipeline::SetRegsMem(uint8 *basemem)
+{
+    m_frontend.SetRegsMem(basemem);
+}
+
+// Runs func on the render thread after everything queued before, without waiting for it
+void GSPipeline::Post(std::function<void()> func)
+{
+    Record &rec = NextRecord();
+    rec.func    = std::move(func);
+    Push(Op::Call, &rec);
+}
+
+// Runs func on the render thread once everything queued before has been processed, and waits for it
+void GSPipeline::Sync(const std::function<void()> &func)
+{
+    Push(Op::Call, nullptr, &func);
+    m_queue.Wait();
+    if (m_exception) {
+        std::exception_ptr e = m_exception;
+        m_exception          = nullptr;
+        std::rethrow_exception(e);
+    }
+}
+
+void GSPipeline::VSync(int field)
+{
+    // primitives still queued in the front end belong to this frame
+    m_frontend.Flush();
+    Record &rec = NextRecord();
+    rec.field   = field;
+    rec.data.assign((const uint8 *)m_frontend.m_regs, (const uint8 *)(m_frontend.m_regs + 1));
+    if (m_sync_vsync) {
+        // a snapshot was asked for and may open a GS dump here, the dump starts from the front end's registers
+        m_sync_vsync = false;
+        Sync([this, &rec] {
+            GSState &s = *m_renderer;
+            s.FlushWrite();
+            s.m_env = m_frontend.m_env;
+            s.m_v   = m_frontend.m_v;
+            s.m_q   = m_frontend.m_q;
+            std::copy(std::begin(m_frontend.m_path), std::end(m_frontend.m_path), s.m_path);
+            s.UpdateContext();
+            ReplayVSync(rec);
+        });
+        return;
+    }
+    // the draws of this frame overlap with the parsing of the next one, but not more
+    {
+        std::unique_lock<std::mutex> lock(m_vsync_lock);
+        m_vsync_done.wait(lock, [this] { return m_vsync_pending == 0; });
+        m_vsync_pending++;
+    }
+    Push(Op::VSync, &rec);
+}
+
+void GSPipeline::InitReadFIFO(uint8 *mem, int len)
+{
+    m_frontend.SubmitBatch();
+    Sync([this, mem, len] { m_renderer->InitReadFIFO(mem, len); });
+}
+
+void GSPipeline::ReadFIFO(uint8 *mem, int size)
+{
+    m_frontend.Flush();
+    Sync([this, mem, size] { m_renderer->ReadFIFO(mem, size); });
+}
+
+// The register state lives in the front end and local memory in the renderer, a savestate needs both
+int GSPipeline::Freeze(freezeData *fd, bool sizeonly)
+{
+    if (!sizeonly) {
+        m_frontend.Flush();
+        Sync([this] {
+            m_renderer->FlushWrite();
+            memcpy(m_frontend.m_mem.m_vm8, m_renderer->m_mem.m_vm8, m_renderer->m_mem.m_vmsize);
+            m_frontend.m_tr.x = m_renderer->m_tr.x;
+            m_frontend.m_tr.y = m_renderer->m_tr.y;
+        });
+    }
+    return m_frontend.Freeze(fd, sizeonly);
+}
+
+int GSPipeline::Defrost(const freezeData *fd)
+{
+    const int ret = m_frontend.Defrost(fd);
+    if (ret == 0)
+        Sync([this, fd] { m_renderer->Defrost(fd); });
+    return ret;
+}
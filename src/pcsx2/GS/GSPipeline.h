@@ -0,0 +1,125 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021 PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Renderers/Common/GSRenderer.h"
+#include "GSThread_CXX11.h"
+
+// Splits the GS in two stages. The front end is a GSState of its own that parses the GIF packets on the MTGS
+// thread, applies the registers and turns every flush into a draw record. The renderer consumes the records in
+// order on the render thread, which also owns the device. Everything touching local memory (uploads, moves, clut
+// loads) and every other renderer call travels through the same queue, the calls that return data wait for it (see
+// Sync). The MTGS runs at most one frame ahead of the renderer.
+class GSPipeline : public GSAlignedClass<32>
+{
+	enum
+	{
+		QUEUE_SIZE = 256
+	};
+
+	enum class Op
+	{
+		Draw,
+		Transfer,
+		Write,
+		CLUT,
+		VSync,
+		Dump,
+		Call,
+	};
+
+	struct alignas(32) Record
+	{
+		GSDrawingEnvironment env;
+		GSVertex* vertex;
+		uint32* index;
+		size_t maxcount;
+		size_t head, tail, next;
+		size_t index_tail;
+		bool packed_uv;
+		GIFRegTEX0 TEX0;
+		GIFRegTEXCLUT TEXCLUT;
+		int field;
+		std::vector<uint8> data;
+		std::function<void()> func;
+
+		Record();
+		~Record();
+
+		void Reserve(size_t count);
+	};
+
+	struct Command
+	{
+		Op op;
+		Record* rec;
+		const std::function<void()>* func;
+	};
+
+	class Frontend final : public GSState
+	{
+		GSPipeline* m_pipeline;
+
+	protected:
+		void RenderPrim() final;
+		void BeginTransfer() final;
+		void WriteCLUT(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT) final;
+		void DumpTransfer(int index, const uint8* mem, size_t size) final;
+		void Draw() final {}
+		void PurgePool() final {}
+
+	public:
+		Frontend(GSPipeline* pipeline);
+
+		void Write(const uint8* mem, int len) final;
+	};
+
+	GSRenderer* m_renderer;
+	Frontend m_frontend;
+	GSPrivRegSet m_regs; // the renderer's copy, taken at the last vsync
+	Record m_records[QUEUE_SIZE];
+	size_t m_record_pos;
+	std::exception_ptr m_exception;
+	bool m_sync_vsync;
+	std::atomic<bool> m_dumping;
+	int m_vsync_pending;
+	std::mutex m_vsync_lock;
+	std::condition_variable m_vsync_done;
+	GSJobQueue<Command, QUEUE_SIZE> m_queue;
+
+	Record& NextRecord();
+	void Push(Op op, Record* rec, const std::function<void()>* func = nullptr);
+	void Process(Command& cmd);
+	void ReplayDraw(Record& rec);
+	void ReplayTransfer(const Record& rec);
+	void ReplayVSync(const Record& rec);
+
+public:
+	GSPipeline(GSRenderer* renderer);
+	virtual ~GSPipeline();
+
+	GSState* GetFrontend() { return &m_frontend; }
+
+	void SetRegsMem(uint8* basemem);
+	void Post(std::function<void()> func);
+	void Sync(const std::function<void()>& func);
+	void SyncNextVSync() { m_sync_vsync = true; }
+	void VSync(int field);
+	void InitReadFIFO(uint8* mem, int len);
+	void ReadFIFO(uint8* mem, int size);
+	int Freeze(freezeData* fd, bool sizeonly);
+	int Defrost(const freezeData* fd);
+};
@@ -59,7 +59,9 @@ GSState::GSState()
     memset(&m_v, 0, sizeof(m_v));
     memset(&m_vertex, 0, sizeof(m_vertex));
     memset(&m_index, 0, sizeof(m_index));
-    m_v.RGBAQ.Q = 1.0f;
+    m_v.RGBAQ.Q     = 1.0f;
+    m_batch.pending = false;
+    m_batch_draws   = false;
     GrowVertexBuffer();
     m_sssize = 0;
     m_sssize += sizeof(m_version);
@@ -135,8 +137,8 @@ void GSState::SetFrameSkip(int skip)
         m_fpGIFRegHandlers[GIF_A_D_REG_XYZ2]            = &GSState::GIFRegHandlerNOP;
         m_fpGIFRegHandlers[GIF_A_D_REG_XYZF3]           = &GSState::GIFRegHandlerNOP;
         m_fpGIFRegHandlers[GIF_A_D_REG_XYZ3]            = &GSState::GIFRegHandlerNOP;
-        m_fpGIFPackedRegHandlersC[GIF_REG_STQRGBAXYZF2] = &GSState::GIFPackedRegHandlerNOP;
-        m_fpGIFPackedRegHandlersC[GIF_REG_STQRGBAXYZ2]  = &GSState::GIFPackedRegHandlerNOP;
+        for (size_t i = 0; i < countof(m_fpGIFPackedRegHandlersC); i++)
+            m_fpGIFPackedRegHandlersC[i] = &GSState::GIFPackedRegHandlerNOP;
     } else {
         UpdateVertexKick();
     }
@@ -164,10 +166,11 @@ void GSState::Reset()
         m_env.CTXT[i].offset.fzb4 = m_mem.GetPixelOffset4(m_env.CTXT[i].FRAME, m_env.CTXT[i].ZBUF);
     }
     UpdateScissor();
-    m_vertex.head = 0;
-    m_vertex.tail = 0;
-    m_vertex.next = 0;
-    m_index.tail  = 0;
+    m_vertex.head   = 0;
+    m_vertex.tail   = 0;
+    m_vertex.next   = 0;
+    m_index.tail    = 0;
+    m_batch.pending = false;
 }
 void GSState::ResetHandlers()
 {
@@ -195,7 +198,11 @@ void GSState::ResetHandlers()
     m_fpGIFRegHandlerXYZ[P][2]             = &GSState::GIFRegHandlerXYZ2<P, 0, auto_flush>;                            \
     m_fpGIFRegHandlerXYZ[P][3]             = &GSState::GIFRegHandlerXYZ2<P, 1, auto_flush>;                            \
     m_fpGIFPackedRegHandlerSTQRGBAXYZF2[P] = &GSState::GIFPackedRegHandlerSTQRGBAXYZF2<P, auto_flush>;                 \
-    m_fpGIFPackedRegHandlerSTQRGBAXYZ2[P]  = &GSState::GIFPackedRegHandlerSTQRGBAXYZ2<P, auto_flush>;
+    m_fpGIFPackedRegHandlerSTQRGBAXYZ2[P]  = &GSState::GIFPackedRegHandlerSTQRGBAXYZ2<P, auto_flush>;                  \
+    m_fpGIFPackedRegHandlerUVRGBAXYZF2[P]  = &GSState::GIFPackedRegHandlerUVRGBAXYZF2<P, auto_flush>;                  \
+    m_fpGIFPackedRegHandlerUVRGBAXYZ2[P]   = &GSState::GIFPackedRegHandlerUVRGBAXYZ2<P, auto_flush>;                   \
+    m_fpGIFPackedRegHandlerRGBAXYZF2[P]    = &GSState::GIFPackedRegHandlerRGBAXYZF2<P, auto_flush>;                    \
+    m_fpGIFPackedRegHandlerRGBAXYZ2[P]     = &GSState::GIFPackedRegHandlerRGBAXYZ2<P, auto_flush>;
     if (m_userhacks_auto_flush) {
         SetHandlerXYZ(GS_POINTLIST, true);
         SetHandlerXYZ(GS_LINELIST, true);
@@ -546,6 +553,91 @@ void GSState::GIFPackedRegHandlerSTQRGBAXYZ2(const GIFPackedReg *RESTRICT r, uin
     }
     m_q = r[-3].STQ.Q;    // remember the last one, STQ outputs this to the temp Q each time
 }
+// The loops below only touch m_v through whole 16 byte stores so VertexKick can forward them, and keep the
+// registers that are not part of the tag (ST/Q or UV, FOG) in vector registers for the whole loop.
+template <uint32 prim, bool auto_flush>
+void GSState::GIFPackedRegHandlerUVRGBAXYZF2(const GIFPackedReg *RESTRICT r, uint32 size)
+{
+    ASSERT(size > 0 && size % 3 == 0);
+    const GIFPackedReg *RESTRICT r_end = r + size;
+    const GSVector4i             st    = GSVector4i::loadl(&m_v.ST);
+    const GSVector4i             q     = GSVector4i::cast(GSVector4::load(m_q));
+    while (r < r_end) {
+        GSVector4i uv   = GSVector4i::loadl(&r[0]) & GSVector4i::x00003fff();
+        GSVector4i rgba = (GSVector4i::load<false>(&r[1]) & GSVector4i::x000000ff()).ps32().pu16();
+        GSVector4i xy   = GSVector4i::loadl(&r[2].u64[0]);
+        GSVector4i zf   = GSVector4i::loadl(&r[2].u64[1]);
+        uv              = uv.ps32(uv);
+        m_v.m[0]        = st.upl64(rgba.upl32(q));    // TODO: only store the last one
+        xy              = xy.upl16(xy.srl<4>()).upl32(uv);
+        zf              = zf.srl32(4) & GSVector4i::x00ffffff().upl32(GSVector4i::x000000ff());
+        m_v.m[1]        = xy.upl32(zf);    // TODO: only store the last one
+        VertexKick<prim, auto_flush>(r[2].XYZF2.Skip());
+        r += 3;
+    }
+    m_isPackedUV_HackFlag = true;    // see GIFPackedRegHandlerUV_Hack
+}
+template <uint32 prim, bool auto_flush>
+void GSState::GIFPackedRegHandlerUVRGBAXYZ2(const GIFPackedReg *RESTRICT r, uint32 size)
+{
+    ASSERT(size > 0 && size % 3 == 0);
+    const GIFPackedReg *RESTRICT r_end = r + size;
+    const GSVector4i             st    = GSVector4i::loadl(&m_v.ST);
+    const GSVector4i             q     = GSVector4i::cast(GSVector4::load(m_q));
+    const GSVector4i             fog   = GSVector4i::load((int)m_v.FOG);
+    while (r < r_end) {
+        GSVector4i uv   = GSVector4i::loadl(&r[0]) & GSVector4i::x00003fff();
+        GSVector4i rgba = (GSVector4i::load<false>(&r[1]) & GSVector4i::x000000ff()).ps32().pu16();
+        GSVector4i xy   = GSVector4i::loadl(&r[2].u64[0]);
+        GSVector4i z    = GSVector4i::loadl(&r[2].u64[1]);
+        uv              = uv.ps32(uv);
+        m_v.m[0]        = st.upl64(rgba.upl32(q));    // TODO: only store the last one
+        GSVector4i xyz  = xy.upl16(xy.srl<4>()).upl32(z);
+        m_v.m[1]        = xyz.upl64(uv.upl32(fog));    // TODO: only store the last one
+        VertexKick<prim, auto_flush>(r[2].XYZ2.Skip());
+        r += 3;
+    }
+    m_isPackedUV_HackFlag = true;    // see GIFPackedRegHandlerUV_Hack
+}
+template <uint32 prim, bool auto_flush>
+void GSState::GIFPackedRegHandlerRGBAXYZF2(const GIFPackedReg *RESTRICT r, uint32 size)
+{
+    ASSERT(size > 0 && size % 2 == 0);
+    const GIFPackedReg *RESTRICT r_end = r + size;
+    const GSVector4i             st    = GSVector4i::loadl(&m_v.ST);
+    const GSVector4i             q     = GSVector4i::cast(GSVector4::load(m_q));
+    const GSVector4i             uv    = GSVector4i::load((int)m_v.UV);
+    while (r < r_end) {
+        GSVector4i rgba = (GSVector4i::load<false>(&r[0]) & GSVector4i::x000000ff()).ps32().pu16();
+        GSVector4i xy   = GSVector4i::loadl(&r[1].u64[0]);
+        GSVector4i zf   = GSVector4i::loadl(&r[1].u64[1]);
+        m_v.m[0]        = st.upl64(rgba.upl32(q));    // TODO: only store the last one
+        xy              = xy.upl16(xy.srl<4>()).upl32(uv);
+        zf              = zf.srl32(4) & GSVector4i::x00ffffff().upl32(GSVector4i::x000000ff());
+        m_v.m[1]        = xy.upl32(zf);    // TODO: only store the last one
+        VertexKick<prim, auto_flush>(r[1].XYZF2.Skip());
+        r += 2;
+    }
+}
+template <uint32 prim, bool auto_flush>
+void GSState::GIFPackedRegHandlerRGBAXYZ2(const GIFPackedReg *RESTRICT r, uint32 size)
+{
+    ASSERT(size > 0 && size % 2 == 0);
+    const GIFPackedReg *RESTRICT r_end = r + size;
+    const GSVector4i             st    = GSVector4i::loadl(&m_v.ST);
+    const GSVector4i             q     = GSVector4i::cast(GSVector4::load(m_q));
+    const GSVector4i             uvf   = GSVector4i::loadl(&m_v.UV);
+    while (r < r_end) {
+        GSVector4i rgba = (GSVector4i::load<false>(&r[0]) & GSVector4i::x000000ff()).ps32().pu16();
+        GSVector4i xy   = GSVector4i::loadl(&r[1].u64[0]);
+        GSVector4i z    = GSVector4i::loadl(&r[1].u64[1]);
+        m_v.m[0]        = st.upl64(rgba.upl32(q));    // TODO: only store the last one
+        GSVector4i xyz  = xy.upl16(xy.srl<4>()).upl32(z);
+        m_v.m[1]        = xyz.upl64(uvf);    // TODO: only store the last one
+        VertexKick<prim, auto_flush>(r[1].XYZ2.Skip());
+        r += 2;
+    }
+}
 void GSState::GIFPackedRegHandlerNOP(const GIFPackedReg *RESTRICT r, uint32 size)
 {
 }
@@ -558,9 +650,9 @@ __forceinline void GSState::ApplyPRIM(uint32 prim)
         GSUtil::GetPrimClass(prim & 7))    // NOTE: assume strips/fans are converted to lists
     {
         if (m_env.PRMODECONT.AC == 1 && (m_env.PRIM.u32[0] ^ prim) & 0x7f8)    // all fields except PRIM
-            Flush();
+            DeferFlush();
     } else {
-        Flush();
+        DeferFlush();
     }
     if (m_env.PRMODECONT.AC == 1) {
         m_env.PRIM.u32[0] = prim;
@@ -640,42 +732,47 @@ template <int i> void GSState::ApplyTEX0(GIFRegTEX0 &TEX0)
     // clut loading already covered with WriteTest, for drawing only have to check CPSM and CSA (MGS3 intro skybox would
     // be drawn piece by piece without this)
     constexpr uint64 mask = 0x1f78001fffffffffull;    // TBP0 TBW PSM TW TH TCC TFX CPSM CSA
-    if (wt || PRIM->CTXT == i && ((TEX0.u64 ^ m_env.CTXT[i].TEX0.u64) & mask))
-        Flush();
+    if (wt)
+        Flush();    // the clut is about to be overwritten, queued primitives must not see it
+    else if (PRIM->CTXT == i && ((TEX0.u64 ^ m_env.CTXT[i].TEX0.u64) & mask))
+        DeferFlush();
     TEX0.CPSM &= 0xa;                                             // 1010b
     if ((TEX0.u32[0] ^ m_env.CTXT[i].TEX0.u32[0]) & 0x3ffffff)    // TBP0 TBW PSM
         m_env.CTXT[i].offset.tex = m_mem.GetOffset(TEX0.TBP0, TEX0.TBW, TEX0.PSM);
     m_env.CTXT[i].TEX0 = (GSVector4i)TEX0;
-    if (wt) {
-        GIFRegBITBLTBUF BITBLTBUF;
-        GSVector4i      r;
-        if (TEX0.CSM == 0) {
-            BITBLTBUF.SBP  = TEX0.CBP;
-            BITBLTBUF.SBW  = 1;
-            BITBLTBUF.SPSM = TEX0.CSM;
-            r.left         = 0;
-            r.top          = 0;
-            r.right        = GSLocalMemory::m_psm[TEX0.CPSM].bs.x;
-            r.bottom       = GSLocalMemory::m_psm[TEX0.CPSM].bs.y;
-            int blocks     = 4;
-            if (GSLocalMemory::m_psm[TEX0.CPSM].bpp == 16)
-                blocks >>= 1;
-            if (GSLocalMemory::m_psm[TEX0.PSM].bpp == 4)
-                blocks >>= 1;
-            for (int j = 0; j < blocks; j++, BITBLTBUF.SBP++)
-                InvalidateLocalMem(BITBLTBUF, r, true);
-        } else {
-            BITBLTBUF.SBP  = TEX0.CBP;
-            BITBLTBUF.SBW  = m_env.TEXCLUT.CBW;
-            BITBLTBUF.SPSM = TEX0.CSM;
-            r.left         = m_env.TEXCLUT.COU;
-            r.top          = m_env.TEXCLUT.COV;
-            r.right        = r.left + GSLocalMemory::m_psm[TEX0.CPSM].pal;
-            r.bottom       = r.top + 1;
+    if (wt)
+        WriteCLUT(m_env.CTXT[i].TEX0, m_env.TEXCLUT);
+}
+void GSState::WriteCLUT(const GIFRegTEX0 &TEX0, const GIFRegTEXCLUT &TEXCLUT)
+{
+    GIFRegBITBLTBUF BITBLTBUF;
+    GSVector4i      r;
+    if (TEX0.CSM == 0) {
+        BITBLTBUF.SBP  = TEX0.CBP;
+        BITBLTBUF.SBW  = 1;
+        BITBLTBUF.SPSM = TEX0.CSM;
+        r.left         = 0;
+        r.top          = 0;
+        r.right        = GSLocalMemory::m_psm[TEX0.CPSM].bs.x;
+        r.bottom       = GSLocalMemory::m_psm[TEX0.CPSM].bs.y;
+        int blocks     = 4;
+        if (GSLocalMemory::m_psm[TEX0.CPSM].bpp == 16)
+            blocks >>= 1;
+        if (GSLocalMemory::m_psm[TEX0.PSM].bpp == 4)
+            blocks >>= 1;
+        for (int j = 0; j < blocks; j++, BITBLTBUF.SBP++)
             InvalidateLocalMem(BITBLTBUF, r, true);
-        }
-        m_mem.m_clut.Write(m_env.CTXT[i].TEX0, m_env.TEXCLUT);
+    } else {
+        BITBLTBUF.SBP  = TEX0.CBP;
+        BITBLTBUF.SBW  = TEXCLUT.CBW;
+        BITBLTBUF.SPSM = TEX0.CSM;
+        r.left         = TEXCLUT.COU;
+        r.top          = TEXCLUT.COV;
+        r.right        = r.left + GSLocalMemory::m_psm[TEX0.CPSM].pal;
+        r.bottom       = r.top + 1;
+        InvalidateLocalMem(BITBLTBUF, r, true);
     }
+    m_mem.m_clut.Write(TEX0, TEXCLUT);
 }
 template <int i> void GSState::GIFRegHandlerTEX0(const GIFReg *RESTRICT r)
 {
@@ -731,7 +828,7 @@ template <int i> void GSState::GIFRegHandlerCLAMP(const GIFReg *RESTRICT r)
 {
     GL_REG("CLAMP_%d = 0x%x_%x", i, r->u32[1], r->u32[0]);
     if (PRIM->CTXT == i && r->CLAMP != m_env.CTXT[i].CLAMP)
-        Flush();
+        DeferFlush();
     m_env.CTXT[i].CLAMP = (GSVector4i)r->CLAMP;
 }
 void GSState::GIFRegHandlerFOG(const GIFReg *RESTRICT r)
@@ -745,7 +842,7 @@ template <int i> void GSState::GIFRegHandlerTEX1(const GIFReg *RESTRICT r)
 {
     GL_REG("TEX1_%d = 0x%x_%x", i, r->u32[1], r->u32[0]);
     if (PRIM->CTXT == i && r->TEX1 != m_env.CTXT[i].TEX1)
-        Flush();
+        DeferFlush();
     m_env.CTXT[i].TEX1 = (GSVector4i)r->TEX1;
 }
 template <int i> void GSState::GIFRegHandlerTEX2(const GIFReg *RESTRICT r)
@@ -766,7 +863,7 @@ template <int i> void GSState::GIFRegHandlerXYOFFSET(const GIFReg *RESTRICT r)
     GL_REG("XYOFFSET_%d = 0x%x_%x", i, r->u32[1], r->u32[0]);
     const GSVector4i o = (GSVector4i)r->XYOFFSET & GSVector4i::x0000ffff();
     if (!o.eq(m_env.CTXT[i].XYOFFSET))
-        Flush();
+        DeferFlush();
     m_env.CTXT[i].XYOFFSET = o;
     m_env.CTXT[i].UpdateScissor();
     UpdateScissor();
@@ -781,7 +878,7 @@ void GSState::GIFRegHandlerPRMODE(const GIFReg *RESTRICT r)
     GL_REG("PRMODE = 0x%x_%x", r->u32[1], r->u32[0]);
     if (!m_env.PRMODECONT.AC) {
         if ((m_env.PRIM.u32[0] ^ r->PRMODE.u32[0]) & 0x7f8)
-            Flush();
+            DeferFlush();
     } else {
         return;
     }
@@ -794,41 +891,41 @@ void GSState::GIFRegHandlerTEXCLUT(const GIFReg *RESTRICT r)
 {
     GL_REG("TEXCLUT = 0x%x_%x", r->u32[1], r->u32[0]);
     if (r->TEXCLUT != m_env.TEXCLUT)
-        Flush();
+        DeferFlush();
     m_env.TEXCLUT = (GSVector4i)r->TEXCLUT;
 }
 void GSState::GIFRegHandlerSCANMSK(const GIFReg *RESTRICT r)
 {
     if (r->SCANMSK != m_env.SCANMSK)
-        Flush();
+        DeferFlush();
     m_env.SCANMSK = (GSVector4i)r->SCANMSK;
 }
 template <int i> void GSState::GIFRegHandlerMIPTBP1(const GIFReg *RESTRICT r)
 {
     GL_REG("MIPTBP1_%d = 0x%x_%x", i, r->u32[1], r->u32[0]);
     if (PRIM->CTXT == i && r->MIPTBP1 != m_env.CTXT[i].MIPTBP1)
-        Flush();
+        DeferFlush();
     m_env.CTXT[i].MIPTBP1 = (GSVector4i)r->MIPTBP1;
 }
 template <int i> void GSState::GIFRegHandlerMIPTBP2(const GIFReg *RESTRICT r)
 {
     GL_REG("MIPTBP2_%d = 0x%x_%x", i, r->u32[1], r->u32[0]);
     if (PRIM->CTXT == i && r->MIPTBP2 != m_env.CTXT[i].MIPTBP2)
-        Flush();
+        DeferFlush();
     m_env.CTXT[i].MIPTBP2 = (GSVector4i)r->MIPTBP2;
 }
 void GSState::GIFRegHandlerTEXA(const GIFReg *RESTRICT r)
 {
     GL_REG("TEXA = 0x%x_%x", r->u32[1], r->u32[0]);
     if (r->TEXA != m_env.TEXA)
-        Flush();
+        DeferFlush();
     m_env.TEXA = (GSVector4i)r->TEXA;
 }
 void GSState::GIFRegHandlerFOGCOL(const GIFReg *RESTRICT r)
 {
     GL_REG("FOGCOL = 0x%x_%x", r->u32[1], r->u32[0]);
     if (r->FOGCOL != m_env.FOGCOL)
-        Flush();
+        DeferFlush();
     m_env.FOGCOL = (GSVector4i)r->FOGCOL;
 }
 void GSState::GIFRegHandlerTEXFLUSH(const GIFReg *RESTRICT r)
@@ -838,7 +935,7 @@ void GSState::GIFRegHandlerTEXFLUSH(const GIFReg *RESTRICT r)
 template <int i> void GSState::GIFRegHandlerSCISSOR(const GIFReg *RESTRICT r)
 {
     if (PRIM->CTXT == i && r->SCISSOR != m_env.CTXT[i].SCISSOR)
-        Flush();
+        DeferFlush();
     m_env.CTXT[i].SCISSOR = (GSVector4i)r->SCISSOR;
     m_env.CTXT[i].UpdateScissor();
     UpdateScissor();
@@ -847,7 +944,7 @@ template <int i> void GSState::GIFRegHandlerALPHA(const GIFReg *RESTRICT r)
 {
     GL_REG("ALPHA = 0x%x_%x", r->u32[1], r->u32[0]);
     if (PRIM->CTXT == i && r->ALPHA != m_env.CTXT[i].ALPHA)
-        Flush();
+        DeferFlush();
     m_env.CTXT[i].ALPHA = (GSVector4i)r->ALPHA;
     // value of 4 is not allowed by the spec
     // acts has 3 on real hw, so just clamp it
@@ -860,7 +957,7 @@ void GSState::GIFRegHandlerDIMX(const GIFReg *RESTRICT r)
 {
     bool update = false;
     if (r->DIMX != m_env.DIMX) {
-        Flush();
+        DeferFlush();
         update = true;
     }
     m_env.DIMX = (GSVector4i)r->DIMX;
@@ -870,38 +967,38 @@ void GSState::GIFRegHandlerDIMX(const GIFReg *RESTRICT r)
 void GSState::GIFRegHandlerDTHE(const GIFReg *RESTRICT r)
 {
     if (r->DTHE != m_env.DTHE)
-        Flush();
+        DeferFlush();
     m_env.DTHE = (GSVector4i)r->DTHE;
 }
 void GSState::GIFRegHandlerCOLCLAMP(const GIFReg *RESTRICT r)
 {
     if (r->COLCLAMP != m_env.COLCLAMP)
-        Flush();
+        DeferFlush();
     m_env.COLCLAMP = (GSVector4i)r->COLCLAMP;
 }
 template <int i> void GSState::GIFRegHandlerTEST(const GIFReg *RESTRICT r)
 {
     if (PRIM->CTXT == i && r->TEST != m_env.CTXT[i].TEST)
-        Flush();
+        DeferFlush();
     m_env.CTXT[i].TEST = (GSVector4i)r->TEST;
 }
 void GSState::GIFRegHandlerPABE(const GIFReg *RESTRICT r)
 {
     if (r->PABE != m_env.PABE)
-        Flush();
+        DeferFlush();
     m_env.PABE = (GSVector4i)r->PABE;
 }
 template <int i> void GSState::GIFRegHandlerFBA(const GIFReg *RESTRICT r)
 {
     if (PRIM->CTXT == i && r->FBA != m_env.CTXT[i].FBA)
-        Flush();
+        DeferFlush();
     m_env.CTXT[i].FBA = (GSVector4i)r->FBA;
 }
 template <int i> void GSState::GIFRegHandlerFRAME(const GIFReg *RESTRICT r)
 {
     GL_REG("FRAME_%d = 0x%x_%x", i, r->u32[1], r->u32[0]);
     if (PRIM->CTXT == i && r->FRAME != m_env.CTXT[i].FRAME)
-        Flush();
+        DeferFlush();
     if ((m_env.CTXT[i].FRAME.u32[0] ^ r->FRAME.u32[0]) & 0x3f3f01ff)    // FBP FBW PSM
     {
         m_env.CTXT[i].offset.fb   = m_mem.GetOffset(r->FRAME.Block(), r->FRAME.FBW, r->FRAME.PSM);
@@ -941,7 +1038,7 @@ template <int i> void GSState::GIFRegHandlerZBUF(const GIFReg *RESTRICT r)
     // we don't emulate this yet (and maybe we wont need to)
     ZBUF.PSM |= 0x30;
     if (PRIM->CTXT == i && ZBUF != m_env.CTXT[i].ZBUF)
-        Flush();
+        DeferFlush();
     if ((m_env.CTXT[i].ZBUF.u32[0] ^ ZBUF.u32[0]) & 0x3f0001ff)    // ZBP PSM
     {
         m_env.CTXT[i].offset.zb   = m_mem.GetOffset(ZBUF.Block(), m_env.CTXT[i].FRAME.FBW, ZBUF.PSM);
@@ -985,6 +1082,10 @@ void GSState::GIFRegHandlerTRXDIR(const GIFReg *RESTRICT r)
     GL_REG("TRXDIR = 0x%x_%x", r->u32[1], r->u32[0]);
     Flush();
     m_env.TRXDIR = (GSVector4i)r->TRXDIR;
+    BeginTransfer();
+}
+void GSState::BeginTransfer()
+{
     switch (m_env.TRXDIR.XDIR) {
         case 0:    // host -> local
             m_tr.Init(m_env.TRXPOS.DSAX, m_env.TRXPOS.DSAY, m_env.BITBLTBUF);
@@ -1014,11 +1115,103 @@ void GSState::Flush()
     FlushWrite();
     FlushPrim();
 }
+// Register handlers call this instead of Flush() right before a draw state register changes. With batching
+// enabled the queued primitives stay in the vertex/index buffers together with a copy of the current state,
+// the decision to draw them is taken on the next vertex kick (ResolveBatch) or by any hard flush.
+void GSState::DeferFlush()
+{
+    FlushWrite();
+    if (m_batch.pending || m_index.tail == 0)
+        return;
+    if (!m_batch_draws || IsFeedbackDraw()) {
+        FlushPrim();
+        return;
+    }
+    m_batch.env     = m_env;
+    m_batch.pending = true;
+}
+void GSState::ResolveBatch()
+{
+    if (IsBatchCompatible()) {
+        m_batch.pending = false;
+        m_perfmon.Put(GSPerfMon::Batch, 1);
+        return;
+    }
+    SubmitBatch();
+}
+void GSState::SubmitBatch()
+{
+    if (!m_batch.pending)
+        return;
+    m_batch.pending = false;
+    // m_env already moved on to the next draw, swap the queued state back in for the duration of the draw
+    GSDrawingEnvironment env = m_env;
+    m_env                    = m_batch.env;
+    UpdateContext();
+    FlushPrim();
+    m_env = env;
+    UpdateContext();
+}
+bool GSState::IsBatchCompatible() const
+{
+    const GSDrawingEnvironment &a  = m_env;
+    const GSDrawingEnvironment &b  = m_batch.env;
+    const GSDrawingContext     &ca = a.CTXT[a.PRIM.CTXT];
+    const GSDrawingContext     &cb = b.CTXT[b.PRIM.CTXT];
+    if ((a.PRIM.u32[0] ^ b.PRIM.u32[0]) & 0x7ff)
+        return false;
+    if (a.TEXCLUT != b.TEXCLUT || a.SCANMSK != b.SCANMSK || a.TEXA != b.TEXA || a.FOGCOL != b.FOGCOL ||
+        a.DIMX != b.DIMX || a.DTHE != b.DTHE || a.COLCLAMP != b.COLCLAMP || a.PABE != b.PABE)
+        return false;
+    return ca.XYOFFSET == cb.XYOFFSET && ca.TEX0 == cb.TEX0 && ca.TEX1 == cb.TEX1 && ca.CLAMP == cb.CLAMP &&
+           ca.MIPTBP1 == cb.MIPTBP1 && ca.MIPTBP2 == cb.MIPTBP2 && ca.SCISSOR == cb.SCISSOR &&
+           ca.ALPHA == cb.ALPHA && ca.TEST == cb.TEST && ca.FBA == cb.FBA && ca.FRAME == cb.FRAME &&
+           ca.ZBUF == cb.ZBUF;
+}
+// Block range [begin, end) touched by a w x h surface, rounded out to whole pages
+static void GetSurfaceBlocks(uint32 bp, uint32 bw, uint32 psm, uint32 w, uint32 h, uint32 &begin, uint32 &end)
+{
+    const GSVector2i &pgs  = GSLocalMemory::m_psm[psm].pgs;
+    const uint32      cols = std::max<uint32>((std::max(bw * 64, w) + pgs.x - 1) / pgs.x, 1);
+    const uint32      rows = std::max<uint32>((h + pgs.y - 1) / pgs.y, 1);
+    begin                  = bp & ~31u;
+    end                    = begin + (cols * rows + ((bp & 31) ? 1 : 0)) * 32;
+}
+static bool BlocksOverlap(uint32 a0, uint32 a1, uint32 b0, uint32 b1)
+{
+    // surfaces running past the end of local memory wrap around to its start
+    constexpr uint32 vmblocks = GSLocalMemory::m_vmsize / 256;
+    return (a0 < b1 && b0 < a1) || (a0 + vmblocks < b1 && b0 < a1 + vmblocks) ||
+           (a0 < b1 + vmblocks && b0 + vmblocks < a1);
+}
+// Draws that sample their own render target (or depth buffer), or depend on the destination alpha of the
+// previous primitives, must see the result of the preceding draw and are never merged.
+bool GSState::IsFeedbackDraw() const
+{
+    if (m_context->TEST.DATE)
+        return true;
+    if (!PRIM->TME)
+        return false;
+
+    const GIFRegTEX0 &TEX0 = m_context->TEX0;
+    uint32            tex_begin, tex_end;
+    GetSurfaceBlocks(TEX0.TBP0, TEX0.TBW, TEX0.PSM, 1u << TEX0.TW, 1u << TEX0.TH, tex_begin, tex_end);
+
+    const uint32 w = m_context->SCISSOR.SCAX1 + 1;
+    const uint32 h = m_context->SCISSOR.SCAY1 + 1;
+    uint32       begin, end;
+    GetSurfaceBlocks(m_context->FRAME.Block(), m_context->FRAME.FBW, m_context->FRAME.PSM, w, h, begin, end);
+    if (BlocksOverlap(tex_begin, tex_end, begin, end))
+        return true;
+    GetSurfaceBlocks(m_context->ZBUF.Block(), m_context->FRAME.FBW, m_context->ZBUF.PSM, w, h, begin, end);
+    return BlocksOverlap(tex_begin, tex_end, begin, end);
+}
 void GSState::FlushWrite()
 {
     const int len = m_tr.end - m_tr.start;
     if (len <= 0)
         return;
+    SubmitBatch();
     GSVector4i r;
     r.left   = m_env.TRXPOS.DSAX;
     r.top    = m_env.TRXPOS.DSAY;
@@ -1032,10 +1225,13 @@ void GSState::FlushWrite()
 }
 void GSState::FlushPrim()
 {
+    if (m_batch.pending) {
+        SubmitBatch();
+        return;
+    }
     if (m_index.tail > 0) {
         GL_REG("FlushPrim ctxt %d", PRIM->CTXT);
         GSVertex buff[2];
-        s_n++;
         size_t head   = m_vertex.head;
         size_t tail   = m_vertex.tail;
         size_t next   = m_vertex.next;
@@ -1068,28 +1264,7 @@ void GSState::FlushPrim()
             }
             ASSERT((int)unused < GSUtil::GetVertexCount(PRIM->PRIM));
         }
-        // If the PSM format of Z is invalid, but it is masked (no write) and ZTST is set to ALWAYS pass (no test, just
-        // allow) we can ignore the Z format, since it won't be used in the draw (Star Ocean 3 transitions)
-        const bool ignoreZ = m_context->ZBUF.ZMSK && m_context->TEST.ZTST == 1;
-        if (GSLocalMemory::m_psm[m_context->FRAME.PSM].fmt >= 3 ||
-            (GSLocalMemory::m_psm[m_context->ZBUF.PSM].fmt >= 3 && !ignoreZ)) {
-            Console.Warning("GS: Possible invalid draw, Frame PSM %x ZPSM %x", m_context->FRAME.PSM,
-                            m_context->ZBUF.PSM);
-        }
-        m_vt.Update(m_vertex.buff, m_index.buff, m_vertex.tail, m_index.tail, GSUtil::GetPrimClass(PRIM->PRIM));
-        m_context->SaveReg();
-        try {
-            Draw();
-        } catch (GSRecoverableError &) {
-            // could be an unsupported draw call
-        } catch (const std::bad_alloc &) {
-            // Texture Out Of Memory
-            PurgePool();
-            Console.Error("GS: Memory allocation failure.");
-        }
-        m_context->RestoreReg();
-        m_perfmon.Put(GSPerfMon::Draw, 1);
-        m_perfmon.Put(GSPerfMon::Prim, m_index.tail / GSUtil::GetVertexCount(PRIM->PRIM));
+        RenderPrim();
         m_index.tail  = 0;
         m_vertex.head = 0;
         if (unused > 0) {
@@ -1102,6 +1277,38 @@ void GSState::FlushPrim()
         }
     }
 }
+// Draws the primitives queued in m_vertex/m_index with the current state, the buffers are reset by the caller. The
+// draw is counted here rather than in FlushPrim, s_n belongs to whichever thread renders
+void GSState::RenderPrim()
+{
+    s_n++;
+    // If the PSM format of Z is invalid, but it is masked (no write) and ZTST is set to ALWAYS pass (no test, just
+    // allow) we can ignore the Z format, since it won't be used in the draw (Star Ocean 3 transitions)
+    const bool ignoreZ = m_context->ZBUF.ZMSK && m_context->TEST.ZTST == 1;
+    if (GSLocalMemory::m_psm[m_context->FRAME.PSM].fmt >= 3 ||
+        (GSLocalMemory::m_psm[m_context->ZBUF.PSM].fmt >= 3 && !ignoreZ)) {
+        Console.Warning("GS: Possible invalid draw, Frame PSM %x ZPSM %x", m_context->FRAME.PSM, m_context->ZBUF.PSM);
+    }
+    m_vt.Update(m_vertex.buff, m_index.buff, m_vertex.tail, m_index.tail, GSUtil::GetPrimClass(PRIM->PRIM));
+    m_context->SaveReg();
+    try {
+        Draw();
+    } catch (GSRecoverableError &) {
+        // could be an unsupported draw call
+    } catch (const std::bad_alloc &) {
+        // Texture Out Of Memory
+        PurgePool();
+        Console.Error("GS: Memory allocation failure.");
+    }
+    m_context->RestoreReg();
+    m_perfmon.Put(GSPerfMon::Draw, 1);
+    m_perfmon.Put(GSPerfMon::Prim, m_index.tail / GSUtil::GetVertexCount(PRIM->PRIM));
+}
+void GSState::DumpTransfer(int index, const uint8 *mem, size_t size)
+{
+    if (m_dump)
+        m_dump->Transfer(index, mem, size);
+}
 void GSState::Write(const uint8 *mem, int len)
 {
     int                         w    = m_env.TRXREG.RRW;
@@ -1130,6 +1337,7 @@ void GSState::Write(const uint8 *mem, int len)
     }
     if (!m_tr.Update(w, h, psm.trbpp, len))
         return;
+    SubmitBatch();
     GL_CACHE("Write! ...  => 0x%x W:%d F:%s (DIR %d%d), dPos(%d %d) size(%d %d)", blit.DBP, blit.DBW,
              psm_str(blit.DPSM), m_env.TRXPOS.DIRX, m_env.TRXPOS.DIRY, m_env.TRXPOS.DSAX, m_env.TRXPOS.DSAY, w, h);
     if (PRIM->TME && (blit.DBP == m_context->TEX0.TBP0 || blit.DBP == m_context->TEX0.CBP))    // TODO: hmmmm
@@ -1164,6 +1372,7 @@ void GSState::InitReadFIFO(uint8 *mem, int len)
     const uint16 bpp = GSLocalMemory::m_psm[m_env.BITBLTBUF.SPSM].trbpp;
     if (!m_tr.Update(w, h, bpp, len))
         return;
+    SubmitBatch();
     if (m_tr.x == sx && m_tr.y == sy)
         InvalidateLocalMem(m_env.BITBLTBUF, GSVector4i(sx, sy, sx + w, sy + h));
 }
@@ -1203,6 +1412,7 @@ void GSState::Move()
              m_env.BITBLTBUF.SBP, m_env.BITBLTBUF.SBW, psm_str(m_env.BITBLTBUF.SPSM), m_env.BITBLTBUF.DBP,
              m_env.BITBLTBUF.DBW, psm_str(m_env.BITBLTBUF.DPSM), m_env.TRXPOS.DIRX, m_env.TRXPOS.DIRY, sx, sy, dx, dy,
              w, h);
+    SubmitBatch();
     InvalidateLocalMem(m_env.BITBLTBUF, GSVector4i(sx, sy, sx + w, sy + h));
     InvalidateVideoMem(m_env.BITBLTBUF, GSVector4i(dx, dy, dx + w, dy + h));
     int xinc = 1;
@@ -1424,6 +1634,22 @@ template <int index> void GSState::Transfer(const uint8 *mem, uint32 size)
                                 (this->*m_fpGIFPackedRegHandlersC[GIF_REG_STQRGBAXYZ2])((GIFPackedReg *)mem, total);
                                 mem += total * sizeof(GIFPackedReg);
                                 break;
+                            case GIFPath::TYPE_UVRGBAXYZF2:
+                                (this->*m_fpGIFPackedRegHandlersC[GIF_REG_UVRGBAXYZF2])((GIFPackedReg *)mem, total);
+                                mem += total * sizeof(GIFPackedReg);
+                                break;
+                            case GIFPath::TYPE_UVRGBAXYZ2:
+                                (this->*m_fpGIFPackedRegHandlersC[GIF_REG_UVRGBAXYZ2])((GIFPackedReg *)mem, total);
+                                mem += total * sizeof(GIFPackedReg);
+                                break;
+                            case GIFPath::TYPE_RGBAXYZF2:
+                                (this->*m_fpGIFPackedRegHandlersC[GIF_REG_RGBAXYZF2])((GIFPackedReg *)mem, total);
+                                mem += total * sizeof(GIFPackedReg);
+                                break;
+                            case GIFPath::TYPE_RGBAXYZ2:
+                                (this->*m_fpGIFPackedRegHandlersC[GIF_REG_RGBAXYZ2])((GIFPackedReg *)mem, total);
+                                mem += total * sizeof(GIFPackedReg);
+                                break;
                             default:
                                 __assume(0);
                         }
@@ -1459,7 +1685,7 @@ template <int index> void GSState::Transfer(const uint8 *mem, uint32 size)
                             Write(mem, len * 16);
                             break;
                         case 2:
-                            Move();
+                            BeginTransfer();    // the move goes wherever the TRXDIR write sent it
                             break;
                         default:    // 1 and 3
                             // 1 is invalid because downloads can only be done
@@ -1482,8 +1708,8 @@ template <int index> void GSState::Transfer(const uint8 *mem, uint32 size)
                 break;
         }
     }
-    if (m_dump && mem > start)
-        m_dump->Transfer(index, start, mem - start);
+    if (mem > start)
+        DumpTransfer(index, start, mem - start);
     if (index == 0) {
         if (size == 0 && path.nloop > 0) {
             // Hackfix for BIOS, which sends an incomplete packet when it does an XGKICK without
@@ -1694,6 +1920,10 @@ void GSState::UpdateVertexKick()
     m_fpGIFRegHandlers[GIF_A_D_REG_XYZ3]            = m_fpGIFRegHandlerXYZ[prim][3];
     m_fpGIFPackedRegHandlersC[GIF_REG_STQRGBAXYZF2] = m_fpGIFPackedRegHandlerSTQRGBAXYZF2[prim];
     m_fpGIFPackedRegHandlersC[GIF_REG_STQRGBAXYZ2]  = m_fpGIFPackedRegHandlerSTQRGBAXYZ2[prim];
+    m_fpGIFPackedRegHandlersC[GIF_REG_UVRGBAXYZF2]  = m_fpGIFPackedRegHandlerUVRGBAXYZF2[prim];
+    m_fpGIFPackedRegHandlersC[GIF_REG_UVRGBAXYZ2]   = m_fpGIFPackedRegHandlerUVRGBAXYZ2[prim];
+    m_fpGIFPackedRegHandlersC[GIF_REG_RGBAXYZF2]    = m_fpGIFPackedRegHandlerRGBAXYZF2[prim];
+    m_fpGIFPackedRegHandlersC[GIF_REG_RGBAXYZ2]     = m_fpGIFPackedRegHandlerRGBAXYZ2[prim];
 }
 void GSState::GrowVertexBuffer()
 {
@@ -1723,6 +1953,8 @@ void GSState::GrowVertexBuffer()
 }
 template <uint32 prim, bool auto_flush> __forceinline void GSState::VertexKick(uint32 skip)
 {
+    if (m_batch.pending)
+        ResolveBatch();
     ASSERT(m_vertex.tail < m_vertex.maxcount + 3);
     size_t head    = m_vertex.head;
     size_t tail    = m_vertex.tail;
@@ -44,6 +44,8 @@ typedef bool (*GetSkipCount)(const GSFrameInfo& fi, int& skip);
 
 class GSState : public GSAlignedClass<32>
 {
+	friend class GSPipeline;
+
 	// RESTRICT prevents multiple loads of the same part of the register when accessing its bitfields (the compiler is happy to know that memory writes in-between will not go there)
 
 	typedef void (GSState::*GIFPackedRegHandler)(const GIFPackedReg* RESTRICT r);
@@ -69,12 +71,20 @@ class GSState : public GSAlignedClass<32>
 
 	typedef void (GSState::*GIFPackedRegHandlerC)(const GIFPackedReg* RESTRICT r, uint32 size);
 
-	GIFPackedRegHandlerC m_fpGIFPackedRegHandlersC[2];
+	GIFPackedRegHandlerC m_fpGIFPackedRegHandlersC[GIF_REG_COMPLEX_LAST];
 	GIFPackedRegHandlerC m_fpGIFPackedRegHandlerSTQRGBAXYZF2[8];
 	GIFPackedRegHandlerC m_fpGIFPackedRegHandlerSTQRGBAXYZ2[8];
+	GIFPackedRegHandlerC m_fpGIFPackedRegHandlerUVRGBAXYZF2[8];
+	GIFPackedRegHandlerC m_fpGIFPackedRegHandlerUVRGBAXYZ2[8];
+	GIFPackedRegHandlerC m_fpGIFPackedRegHandlerRGBAXYZF2[8];
+	GIFPackedRegHandlerC m_fpGIFPackedRegHandlerRGBAXYZ2[8];
 
 	template<uint32 prim, bool auto_flush> void GIFPackedRegHandlerSTQRGBAXYZF2(const GIFPackedReg* RESTRICT r, uint32 size);
 	template<uint32 prim, bool auto_flush> void GIFPackedRegHandlerSTQRGBAXYZ2(const GIFPackedReg* RESTRICT r, uint32 size);
+	template<uint32 prim, bool auto_flush> void GIFPackedRegHandlerUVRGBAXYZF2(const GIFPackedReg* RESTRICT r, uint32 size);
+	template<uint32 prim, bool auto_flush> void GIFPackedRegHandlerUVRGBAXYZ2(const GIFPackedReg* RESTRICT r, uint32 size);
+	template<uint32 prim, bool auto_flush> void GIFPackedRegHandlerRGBAXYZF2(const GIFPackedReg* RESTRICT r, uint32 size);
+	template<uint32 prim, bool auto_flush> void GIFPackedRegHandlerRGBAXYZ2(const GIFPackedReg* RESTRICT r, uint32 size);
 	void GIFPackedRegHandlerNOP(const GIFPackedReg* RESTRICT r, uint32 size);
 
 	template<int i> void ApplyTEX0(GIFRegTEX0& TEX0);
@@ -152,6 +162,7 @@ protected:
 	int m_userhacks_skipdraw;
 	int m_userhacks_skipdraw_offset;
 	bool m_userhacks_auto_flush;
+	bool m_batch_draws;
 
 	GSVertex m_v;
 	float m_q;
@@ -172,6 +183,26 @@ protected:
 		size_t tail;
 	} m_index;
 
+	// Primitives whose flush was deferred by a register write, drawn with the state they were queued with
+	// unless the next vertex kick finds the same draw state again (see DeferFlush/ResolveBatch)
+	struct
+	{
+		GSDrawingEnvironment env;
+		bool pending;
+	} m_batch;
+
+	void DeferFlush();
+	void ResolveBatch();
+	void SubmitBatch();
+	bool IsBatchCompatible() const;
+	bool IsFeedbackDraw() const;
+
+	// Local memory side effects of the GIF stream, GSPipeline's front end overrides these to queue them instead
+	virtual void RenderPrim();
+	virtual void BeginTransfer();
+	virtual void WriteCLUT(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT);
+	virtual void DumpTransfer(int index, const uint8* mem, size_t size);
+
 	void UpdateContext();
 	void UpdateScissor();
 
@@ -248,7 +279,7 @@ public:
 	virtual void InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r, bool clut = false) {}
 
 	void Move();
-	void Write(const uint8* mem, int len);
+	virtual void Write(const uint8* mem, int len);
 	void Read(uint8* mem, int len);
 	void InitReadFIFO(uint8* mem, int len);
 
@@ -20,6 +20,7 @@
 
 // #include "GS/Renderers/SW/GSScanlineEnvironment.h"
 #include "common/emitter/tools.h"
+#include "common/Perf.h"
 
 #include <xbyak/xbyak_util.h>
 
@@ -191,6 +192,9 @@ template <class CG, class KEY, class VALUE> class GSCodeGeneratorFunctionMap : p
 
             m_cgmap[key] = ret;
 
+            Perf::gs.map((uptr)cg->getCode(), (u32)cg->getSize(),
+                         format("%s<%016llx>", m_name.c_str(), (uint64)key).c_str());
+
 #ifdef ENABLE_VTUNE
 
             // vtune method registration
@@ -378,13 +378,14 @@ void GSRenderer::VSync(int field)
                                  ? (std::string("Interlaced ") + (m_regs->SMODE2.FFMD ? "(frame)" : "(field)"))
                                  : "Progressive";
 
-            s = format("%lld | %d x %d | %.2f fps (%d%%) | %s - %s | %s | %d S/%d P/%d D | %d%% CPU | %.2f | %.2f",
+            s = format("%lld | %d x %d | %.2f fps (%d%%) | %s - %s | %s | %d S/%d P/%d D/%d B | %d%% CPU | %.2f | %.2f",
                        m_perfmon.GetFrame(), GetInternalResolution().x, GetInternalResolution().y, fps,
                        (int)(100.0 * fps / GetTvRefreshRate()), s2.c_str(),
                        theApp.m_gs_interlace[m_interlace].name.c_str(),
                        aspect_ratio_names[static_cast<int>(EmuConfig.GS.AspectRatio)],
                        (int)m_perfmon.Get(GSPerfMon::SyncPoint), (int)m_perfmon.Get(GSPerfMon::Prim),
-                       (int)m_perfmon.Get(GSPerfMon::Draw), m_perfmon.CPU(), m_perfmon.Get(GSPerfMon::Swizzle) / 1024,
+                       (int)m_perfmon.Get(GSPerfMon::Draw), (int)m_perfmon.Get(GSPerfMon::Batch), m_perfmon.CPU(),
+                       m_perfmon.Get(GSPerfMon::Swizzle) / 1024,
                        m_perfmon.Get(GSPerfMon::Unswizzle) / 1024);
 
             double fillrate = m_perfmon.Get(GSPerfMon::Fillrate);
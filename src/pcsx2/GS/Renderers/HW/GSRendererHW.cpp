@@ -13,6 +13,7 @@ GSRendererHW::GSRendererHW(GSTextureCache *tc)
     m_upscale_multiplier       = std::max(0, theApp.GetConfigI("upscale_multiplier"));
     m_conservative_framebuffer = theApp.GetConfigB("conservative_framebuffer");
     m_accurate_date            = theApp.GetConfigB("accurate_date");
+    m_batch_draws              = theApp.GetConfigB("batch_draws");
 
     if (theApp.GetConfigB("UserHacks")) {
         m_userhacks_enabled_gs_mem_clear = !theApp.GetConfigB("UserHacks_Disable_Safe_Features");
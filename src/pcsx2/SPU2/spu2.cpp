@@ -25,6 +25,7 @@
 #endif
 #include "R3000A.h"
 #include "common/pxStreams.h"
+#include "common/Tracing.h"
 #include "gui/AppCoreThread.h"
 
 using namespace Threading;
@@ -338,6 +339,7 @@ static bool lState[6];
 
 void SPU2async(u32 cycles)
 {
+    TRACE_ZONE("SPU2 Mix");
     DspUpdate();
 
     TimeUpdate(psxRegs.cycle);
@@ -11,10 +11,12 @@
 #include "Counters.h"
 #include "GS.h"
 #include "Elfheader.h"
+#include "CDVD/CDVD.h"
 
 #include "SysThreads.h"
 #include "MTVU.h"
 #include "IPC.h"
+#include "Lockstep.h"
 #include "FW.h"
 #include "SPU2/spu2.h"
 #include "DEV9/DEV9.h"
@@ -144,12 +146,17 @@ void SysCoreThread::ApplySettings(const Pcsx2Config &src)
     m_resetProfilers   = (src.Profiler != EmuConfig.Profiler);
     m_resetVsyncTimers = (src.GS != EmuConfig.GS);
 
+    // Switching recompilers can turn THREAD_VU0 off under a running VU0 program
+    if (THREAD_VU0 && src.Cpu != EmuConfig.Cpu)
+        vu0Finish();
+
     EmuConfig.CopyConfig(src);
 }
 
 bool SysCoreThread::HasPendingStateChangeRequest() const
 {
-    return !m_hasActiveMachine || GetMTGS().HasPendingException() || _parent::HasPendingStateChangeRequest();
+    return !m_hasActiveMachine || GetMTGS().HasPendingException() || Lockstep_BreakPending() ||
+           _parent::HasPendingStateChangeRequest();
 }
 
 void SysCoreThread::_reset_stuff_as_needed()
@@ -157,6 +164,18 @@ void SysCoreThread::_reset_stuff_as_needed()
 
     GetVmMemory().CommitAll();
 
+    // The VU0 thread is only used for the discs on its allowlist, which is known once the disc is
+    // identified, and it needs the VU0 program out of the way before the recompilers switch over.
+    const bool useVU0Thread =
+        EmuConfig.Speedhacks.vu0Thread && EmuConfig.Speedhacks.IsVU0ThreadAllowed(DiscSerial);
+    if (useVU0Thread != EmuConfig.CurrentVU0Thread) {
+        if (!m_resetVirtualMachine)
+            vu0Finish();
+        EmuConfig.CurrentVU0Thread = useVU0Thread;
+        m_resetRecompilers         = true;
+        Console.WriteLn("VU0 thread %s", useVU0Thread ? "enabled" : "disabled");
+    }
+
     if (m_resetVirtualMachine || m_resetRecompilers || m_resetProfilers) {
         SysClearExecutionCache();
         memBindConditionalHandlers();
@@ -185,6 +204,7 @@ void SysCoreThread::DoCpuReset()
 {
     AffinityAssert_AllowFromSelf(pxDiagSpot);
     cpuReset();
+    cpuLoadBootSnapshot();
 }
 
 void SysCoreThread::VsyncInThread()
@@ -214,6 +234,7 @@ void SysCoreThread::DoCpuExecute()
     m_hasActiveMachine = true;
     // UI_EnableSysActions();
     Cpu->Execute();
+    Lockstep_Boundary();
 }
 
 void SysCoreThread::ExecuteTaskInThread()
@@ -273,6 +294,7 @@ void SysCoreThread::OnCleanupInThread()
     m_resetVirtualMachine = true;
 
     R3000A::ioman::reset();
+    vu0Thread.WaitVU();
     vu1Thread.WaitVU();
     SPU2close();
     PADclose();
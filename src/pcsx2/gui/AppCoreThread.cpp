@@ -446,6 +446,7 @@ void ExecutorThread::OnCleanupInThread()
 void SysExecEvent_Execute::InvokeEvent()
 {
     CoreThread.ResetQuick();
-    CDVDsys_ChangeSource(CDVD_SourceType::Iso);
+    // a host ELF can be booted without a disc
+    CDVDsys_ChangeSource(wxGetApp().m_gamefile.IsEmpty() ? CDVD_SourceType::NoDisc : CDVD_SourceType::Iso);
     CoreThread.Resume();
 }
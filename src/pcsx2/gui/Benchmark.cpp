@@ -0,0 +1,197 @@
+#include "Core/PrecompiledHeader.h"
+#include "Benchmark.h"
+#include "main.h"
+#include "MTVU.h"
+#include "Elfheader.h"
+#include "CDVD/CDVD.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <vector>
+
+enum BenchmarkThread
+{
+    BenchThread_EE,
+    BenchThread_MTGS,
+    BenchThread_MTVU,
+    BenchThread_Count
+};
+
+static const char *const BenchmarkThreadNames[BenchThread_Count] = {"ee", "mtgs", "mtvu"};
+
+static BenchmarkOptions  s_options;
+static bool              s_active = false;
+static std::atomic<bool> s_finished(false);
+
+// everything below is only touched by the core thread
+static u64              s_startTicks = 0;
+static u64              s_lastVsync  = 0;
+static u64              s_threadStart[BenchThread_Count];
+static RecompilerStats  s_eeRecStart;
+static RecompilerStats  s_iopRecStart;
+static RecompilerStats  s_vuRecStart[2];
+static std::vector<u32> s_frameTimes;    // vsync to vsync, in microseconds
+
+static void GetThreadTimes(u64 (&times)[BenchThread_Count])
+{
+    times[BenchThread_EE]   = CoreThread.GetCpuTime();
+    times[BenchThread_MTGS] = GetMTGS().GetCpuTime();
+    times[BenchThread_MTVU] = vu1Thread.GetCpuTime();
+}
+
+static u32 FramePercentile(std::vector<u32> &sorted, u32 percent)
+{
+    return sorted[std::min<size_t>(sorted.size() - 1, sorted.size() * percent / 100)];
+}
+
+static void WriteJsonString(FILE *fp, const char *str)
+{
+    fputc('"', fp);
+    for (; *str; str++) {
+        if (*str == '"' || *str == '\\')
+            fprintf(fp, "\\%c", *str);
+        else if ((u8)*str < 0x20)
+            fprintf(fp, "\\u%04x", (u8)*str);
+        else
+            fputc(*str, fp);
+    }
+    fputc('"', fp);
+}
+
+// Counts over the run, occupancy at its end. The age of evicted blocks is in blocks compiled after them.
+static void WriteRecStats(FILE *fp, const char *name, const RecompilerStats &now, const RecompilerStats &start,
+                          bool last)
+{
+    const u64 evicted = now.BlocksEvicted - start.BlocksEvicted;
+    fprintf(fp,
+            "    \"%s\": {\"blocks_compiled\": %llu, \"cache_resets\": %llu, \"cache_flushes\": %llu, "
+            "\"blocks_evicted\": %llu, \"evicted_age\": %.1f, \"cache_used\": %llu, \"cache_size\": %llu}%s\n",
+            name, (unsigned long long)(now.BlocksCompiled - start.BlocksCompiled),
+            (unsigned long long)(now.CacheResets - start.CacheResets),
+            (unsigned long long)(now.CacheFlushes - start.CacheFlushes), (unsigned long long)evicted,
+            evicted ? (double)(now.EvictedAge - start.EvictedAge) / evicted : 0.0, (unsigned long long)now.CacheUsed,
+            (unsigned long long)now.CacheSize, last ? "" : ",");
+}
+
+// Per wait site: how many waits were elided or already done, and log2 histograms of the others
+static void WriteWaitStats(FILE *fp)
+{
+    for (const Threading::WaitSite *site = Threading::WaitSite::GetFirst(); site; site = site->GetNext()) {
+        const Threading::WaitSite::Stats &stats = site->GetStats();
+        fprintf(fp, "    ");
+        WriteJsonString(fp, site->GetName());
+        fprintf(fp, ": {\"elided\": %llu, \"immediate\": %llu", (unsigned long long)stats.elided,
+                (unsigned long long)stats.immediate);
+        for (int phase = 0; phase < Threading::WaitSite::Phase_Count; phase++) {
+            fprintf(fp, ", \"%s\": [", Threading::WaitSite::GetPhaseName(phase));
+            for (int i = 0; i < Threading::WaitSite::Buckets; i++)
+                fprintf(fp, "%s%llu", i ? ", " : "", (unsigned long long)stats.waits[phase][i]);
+            fprintf(fp, "]");
+        }
+        fprintf(fp, "}%s\n", site->GetNext() ? "," : "");
+    }
+}
+
+static void WriteReport()
+{
+    const double seconds = (double)(s_lastVsync - s_startTicks) / GetTickFrequency();
+    const size_t frames  = s_frameTimes.size();
+
+    u64 threadNow[BenchThread_Count];
+    GetThreadTimes(threadNow);
+
+    FILE *fp = fopen(s_options.Report.ToUTF8(), "w");
+    if (!fp) {
+        Console.Error(L"Benchmark: cannot write the report to '%s'", WX_STR(s_options.Report));
+        return;
+    }
+
+    fprintf(fp, "{\n  \"serial\": ");
+    WriteJsonString(fp, DiscSerial.ToUTF8());
+    fprintf(fp, ",\n  \"crc\": \"%08X\",\n", ElfCRC);
+    fprintf(fp, "  \"frames\": %zu,\n  \"seconds\": %.6f,\n  \"fps\": %.3f,\n", frames, seconds,
+            seconds > 0 ? frames / seconds : 0.0);
+
+    if (frames) {
+        u64 total = 0;
+        for (u32 us : s_frameTimes)
+            total += us;
+        std::vector<u32> sorted(s_frameTimes);
+        std::sort(sorted.begin(), sorted.end());
+        fprintf(fp,
+                "  \"frame_time_us\": {\"mean\": %.1f, \"min\": %u, \"p50\": %u, \"p90\": %u, \"p99\": %u, "
+                "\"max\": %u},\n",
+                (double)total / frames, sorted.front(), FramePercentile(sorted, 50), FramePercentile(sorted, 90),
+                FramePercentile(sorted, 99), sorted.back());
+    }
+
+    fprintf(fp, "  \"threads\": {\n");
+    for (int i = 0; i < BenchThread_Count; i++) {
+        const double cpu = (double)(threadNow[i] - s_threadStart[i]) / Threading::GetThreadTicksPerSecond();
+        fprintf(fp, "    \"%s\": {\"cpu_seconds\": %.6f, \"utilization\": %.4f}%s\n", BenchmarkThreadNames[i], cpu,
+                seconds > 0 ? cpu / seconds : 0.0, i + 1 < BenchThread_Count ? "," : "");
+    }
+    fprintf(fp, "  },\n  \"recompilers\": {\n");
+    WriteRecStats(fp, "ee", g_eeRecStats, s_eeRecStart, false);
+    WriteRecStats(fp, "iop", g_iopRecStats, s_iopRecStart, false);
+    WriteRecStats(fp, "vu0", g_vuRecStats[0], s_vuRecStart[0], false);
+    WriteRecStats(fp, "vu1", g_vuRecStats[1], s_vuRecStart[1], true);
+    fprintf(fp, "  },\n  \"waits_us_log2\": {\n");
+    WriteWaitStats(fp);
+    fprintf(fp, "  }\n}\n");
+    fclose(fp);
+
+    Console.WriteLn(Color_StrongGreen, L"Benchmark: %zu frames in %.2f seconds, report written to '%s'", frames,
+                    seconds, WX_STR(s_options.Report));
+}
+
+void Benchmark_Start(const BenchmarkOptions &options)
+{
+    s_options = options;
+    s_active  = true;
+    s_finished.store(false);
+    s_startTicks = 0;
+    s_frameTimes.clear();
+    if (options.Frames)
+        s_frameTimes.reserve(options.Frames);
+}
+
+bool Benchmark_IsActive()
+{
+    return s_active;
+}
+
+bool Benchmark_IsFinished()
+{
+    return s_finished.load(std::memory_order_acquire);
+}
+
+void Benchmark_Vsync()
+{
+    if (!s_active || s_finished.load(std::memory_order_relaxed))
+        return;
+
+    const u64 now = GetCPUTicks();
+    if (!s_startTicks) {
+        s_startTicks = now;
+        s_lastVsync  = now;
+        GetThreadTimes(s_threadStart);
+        s_eeRecStart  = g_eeRecStats;
+        s_iopRecStart = g_iopRecStats;
+        memcpy(s_vuRecStart, g_vuRecStats, sizeof(s_vuRecStart));
+        Threading::WaitSite::ResetAll();
+        return;
+    }
+
+    s_frameTimes.push_back((u32)((now - s_lastVsync) * 1000000 / GetTickFrequency()));
+    s_lastVsync = now;
+
+    const bool framesDone  = s_options.Frames && s_frameTimes.size() >= s_options.Frames;
+    const bool secondsDone = s_options.Seconds && now - s_startTicks >= s_options.Seconds * GetTickFrequency();
+    if (!framesDone && !secondsDone)
+        return;
+
+    WriteReport();
+    s_finished.store(true, std::memory_order_release);
+}
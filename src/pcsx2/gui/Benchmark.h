@@ -0,0 +1,17 @@
+#pragma once
+#include "common/Pcsx2Defs.h"
+#include <wx/string.h>
+
+// Runs the VM for a fixed budget with the frame limiter off, then writes a JSON report of the frame times, the
+// cpu time of the emulation threads and what the recompilers did. The budget is counted from the first vsync.
+struct BenchmarkOptions
+{
+    u32      Frames  = 0;    // stop after this many frames, 0 for no limit
+    u32      Seconds = 0;    // stop after this much wall time, 0 for no limit
+    wxString Report  = L"benchmark.json";
+};
+
+extern void Benchmark_Start(const BenchmarkOptions &options);
+extern bool Benchmark_IsActive();
+extern bool Benchmark_IsFinished();
+extern void Benchmark_Vsync();    // called by the core thread once per frame
@@ -8,15 +8,23 @@
 #include <wx/stdpaths.h>
 #include <memory>
 
+#include "common/Perf.h"
 #include "common/StringUtil.h"
+#include "common/Tracing.h"
 #include "main.h"
+#include "Benchmark.h"
 #include "Host.h"
+#include "Lockstep.h"
 #include "PAD/Linux/PAD.h"
+#include "x86/BlockProfiler.h"
 
 
 Pcsx2App        *ps2app;
 SDL_Window      *sdlwindow = NULL;
 WindowInfo       g_gs_window_info;
+static wxString  s_traceFile;
+static wxString  s_blockProfileFile;
+static wxString  s_waitStatsFile;
 extern wxDirName g_fullBaseDirName;
 wxString         appIniPath;
 
@@ -40,6 +48,8 @@ void Pcsx2App::LogicalVsync()
 {
     if (!CoreThread.HasActiveMachine())
         return;
+    Benchmark_Vsync();
+    Lockstep_Vsync();
     PADupdate(0);
 
     SDL_Event events;
@@ -74,6 +84,7 @@ Pcsx2App::Pcsx2App() : SysExecutorThread(new pxEvtQueue())
 Pcsx2App::~Pcsx2App()
 {
     try {
+        vu0Thread.Cancel();
         vu1Thread.Cancel();
     }
     DESTRUCTOR_CATCHALL
@@ -94,6 +105,28 @@ void Pcsx2App::OpenGsPanel()
 void Pcsx2App::CloseGsPanel()
 {
     CoreThread.Suspend();
+    if (!s_traceFile.IsEmpty()) {
+        Tracing::Stop();
+        if (Tracing::Export(s_traceFile.ToUTF8()))
+            Console.WriteLn(Color_StrongGreen, L"Trace written to '%s'", WX_STR(s_traceFile));
+        else
+            Console.Error(L"Cannot write the trace to '%s'", WX_STR(s_traceFile));
+    }
+    if (!s_blockProfileFile.IsEmpty()) {
+        if (BlockProfiling::Report(s_blockProfileFile.ToUTF8()))
+            Console.WriteLn(Color_StrongGreen, L"Block profile written to '%s'", WX_STR(s_blockProfileFile));
+        else
+            Console.Error(L"Cannot write the block profile to '%s'", WX_STR(s_blockProfileFile));
+    }
+    if (!s_waitStatsFile.IsEmpty()) {
+        if (FILE *fp = fopen(s_waitStatsFile.ToUTF8(), "w")) {
+            Threading::WaitSite::Report(fp);
+            fclose(fp);
+            Console.WriteLn(Color_StrongGreen, L"Wait statistics written to '%s'", WX_STR(s_waitStatsFile));
+        } else
+            Console.Error(L"Cannot write the wait statistics to '%s'", WX_STR(s_waitStatsFile));
+    }
+    Perf::CloseJitDump();
     CoreThread.Cancel();
     SysExecutorThread.ShutdownQueue();
     ps2app->runnning = false;
@@ -111,6 +144,7 @@ void Pcsx2App::CloseGsPanel()
         Console.Indent().Error(ex.FormatDiagnosticMessage());
     }
     Console_SetActiveHandler(ConsoleWriter_Stdout);
+    Console_SetDeferredLog(false);
     exit(0);
 }
 bool Pcsx2App::OnInit()
@@ -120,6 +154,9 @@ bool Pcsx2App::OnInit()
     appIniPath        = appPath;
     g_fullBaseDirName = appPath;
 
+    // logging from the emulation threads shouldn't cost them anything
+    Console_SetDeferredLog(true);
+
     SysExecutorThread.Start();
     x86caps.Identify();
     x86caps.CountCores();
@@ -136,8 +173,32 @@ bool Pcsx2App::OnInit()
     EmuConfig.CurrentIRX.clear();
     g_Conf->EmuOptions.BaseFilenames.Bios = m_biosfile;
     g_Conf->CurrentIso                    = m_gamefile;
+    g_Conf->CurrentELF                    = m_elffile;
+
+    // an ELF is only booted in place of the disc one by fast boot, see eeloadHook()
+    g_Conf->EmuOptions.UseBOOT2Injection = m_fastboot || !m_elffile.IsEmpty();
+    g_Conf->EmuOptions.UseBootSnapshot   = m_bootsnapshot;
+
+    // the IOP block cache stays as configured unless asked for here, see iopBlockCacheEnter()
+    if (m_iopblocks || m_iopprecomp)
+        g_Conf->EmuOptions.Cpu.Recompiler.PersistIOPBlocks = true;
+    if (m_iopprecomp)
+        g_Conf->EmuOptions.Cpu.Recompiler.PrecompileIOPModules = true;
+
+    // the benchmark measures how fast the VM can go, see frameLimit()
+    if (Benchmark_IsActive()) {
+        g_Conf->EmuOptions.GS.FrameLimitEnable = false;
+        g_Conf->EmuOptions.GS.VsyncEnable      = VsyncMode::Off;
+    }
+    // every frame runs twice in lockstep, there is no point waiting for the host display
+    if (Lockstep_IsActive()) {
+        g_Conf->EmuOptions.GS.FrameLimitEnable = false;
+        g_Conf->EmuOptions.GS.VsyncEnable      = VsyncMode::Off;
+    }
 
     CoreThread.ApplySettings(g_Conf->EmuOptions);
+    if (!g_Conf->CurrentELF.IsEmpty())
+        CoreThread.SetElfOverride(g_Conf->CurrentELF);
     const std::string currentIso(StringUtil::wxStringToUTF8String(g_Conf->CurrentIso));
     CDVDsys_SetFile(CDVD_SourceType::Iso, currentIso);
     SysExecutorThread.PostEvent(new SysExecEvent_Execute());
@@ -145,12 +206,76 @@ bool Pcsx2App::OnInit()
 }
 int main(int argc, char **argv)
 {
-    ps2app             = new Pcsx2App();
-    ps2app->m_biosfile = wxString(argv[1]);
-    ps2app->m_gamefile = wxString(argv[2]);
+    ps2app = new Pcsx2App();
+
+    // pcsx2 <bios> [iso] [--fastboot] [--boot-snapshot] [--elf=<file>] [--iop-block-cache] [--iop-precompile]
+    //       [--bench-frames=<n>] [--bench-seconds=<n>] [--bench-report=<file>] [--trace=<file>]
+    //       [--block-profile=<file>] [--block-profile-time] [--wait-stats=<file>] [--jitdump]
+    //       [--lockstep[=<frames>]] [--lockstep-skip=<n>] [--lockstep-report=<file>]
+    BenchmarkOptions bench;
+    LockstepOptions  lockstep;
+    bool             lockstepEnable   = false;
+    bool             blockProfileTime = false;
+    wxString         value;
+    for (int i = 1; i < argc; i++) {
+        const wxString arg(fromUTF8(argv[i]));
+        if (arg.StartsWith(L"--bench-frames=", &value))
+            bench.Frames = wxAtoi(value);
+        else if (arg.StartsWith(L"--bench-seconds=", &value))
+            bench.Seconds = wxAtoi(value);
+        else if (arg.StartsWith(L"--bench-report=", &value))
+            bench.Report = value;
+        else if (arg == L"--lockstep")
+            lockstepEnable = true;
+        else if (arg.StartsWith(L"--lockstep=", &value)) {
+            lockstep.Frames = wxAtoi(value);
+            lockstepEnable  = true;
+        } else if (arg.StartsWith(L"--lockstep-skip=", &value))
+            lockstep.Skip = wxAtoi(value);
+        else if (arg.StartsWith(L"--lockstep-report=", &value))
+            lockstep.Report = value;
+        else if (arg.StartsWith(L"--trace=", &s_traceFile))
+            continue;
+        else if (arg.StartsWith(L"--block-profile=", &s_blockProfileFile))
+            continue;
+        else if (arg == L"--block-profile-time")
+            blockProfileTime = true;
+        else if (arg.StartsWith(L"--wait-stats=", &s_waitStatsFile))
+            continue;
+        else if (arg == L"--jitdump") {
+            if (!Perf::OpenJitDump())
+                Console.Warning(L"Cannot create the perf jitdump file");
+        } else if (arg == L"--fastboot")
+            ps2app->m_fastboot = true;
+        else if (arg == L"--boot-snapshot")
+            ps2app->m_bootsnapshot = true;
+        else if (arg == L"--iop-block-cache")
+            ps2app->m_iopblocks = true;
+        else if (arg == L"--iop-precompile")
+            ps2app->m_iopprecomp = true;
+        else if (arg.StartsWith(L"--elf=", &ps2app->m_elffile))
+            continue;
+        else if (ps2app->m_biosfile.IsEmpty())
+            ps2app->m_biosfile = arg;
+        else if (ps2app->m_gamefile.IsEmpty())
+            ps2app->m_gamefile = arg;
+        else
+            Console.Warning(L"Ignoring unknown argument '%s'", WX_STR(arg));
+    }
+    if (bench.Frames || bench.Seconds)
+        Benchmark_Start(bench);
+    if (lockstepEnable)
+        Lockstep_Start(lockstep);
+    if (!s_traceFile.IsEmpty())
+        Tracing::Start();
+    if (!s_blockProfileFile.IsEmpty())
+        BlockProfiling::Start(blockProfileTime);
+
     ps2app->OnInit();
     while (ps2app->runnning) {
-        SDL_Delay(1000);
+        SDL_Delay(Benchmark_IsActive() || Lockstep_IsActive() ? 10 : 1000);
+        if (Benchmark_IsFinished() || Lockstep_IsFinished())
+            ps2app->CloseGsPanel();
     }
 
     return 0;
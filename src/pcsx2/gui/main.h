@@ -29,7 +29,12 @@ class Pcsx2App {
   public:
     wxString m_gamefile;
     wxString m_biosfile;
-    bool     runnning = true;
+    wxString m_elffile;
+    bool     m_fastboot     = false;
+    bool     m_bootsnapshot = false;
+    bool     m_iopblocks    = false;
+    bool     m_iopprecomp   = false;
+    bool     runnning       = true;
 
     ExecutorThread                      SysExecutorThread;
     std::unique_ptr<SysCpuProviderPack> m_CpuProviders;
@@ -45,5 +50,7 @@ class Pcsx2App {
     void LogicalVsync();
 };
 
+extern Pcsx2App &wxGetApp();
+
 extern __aligned16 AppCoreThread CoreThread;
 extern __aligned16 SysMtgsThread mtgsThread;
@@ -79,3 +79,25 @@ void BaseBlocks::Link(u32 pc, s32 *jumpptr)
         *jumpptr = (s32)(recompiler - (sptr)(jumpptr + 1));
     links.insert(std::pair<u32, uptr>(pc, (uptr)jumpptr));
 }
+
+void BaseBlocks::Evict(uptr start, uptr end, std::vector<BASEBLOCKEX> &evicted)
+{
+    for (linkiter_t i = links.begin(); i != links.end();) {
+        if (i->second >= start && i->second < end)
+            i = links.erase(i);
+        else
+            ++i;
+    }
+
+    blocks.remove_if([&](const BASEBLOCKEX &block) {
+        if (block.fnptr < start || block.fnptr >= end)
+            return false;
+
+        std::pair<linkiter_t, linkiter_t> range = links.equal_range(block.startpc);
+        for (linkiter_t i = range.first; i != range.second; ++i)
+            *(u32 *)i->second = recompiler - (i->second + 4);
+
+        evicted.push_back(block);
+        return true;
+    });
+}
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <map> // used by BaseBlockEx
+#include <vector>
 
 // Every potential jump point in the PS2's addressable memory has a BASEBLOCK
 // associated with it. So that means a BASEBLOCK for every 4 bytes of PS2
@@ -32,6 +33,7 @@ struct BASEBLOCK
 struct BASEBLOCKEX
 {
 	u32 startpc;
+	u32 serial;  // blocks compiled before it, for its age
 	uptr fnptr;
 	u16 size;    // The size in dwords (equivalent to the number of instructions)
 	u16 x86size; // The size in byte of the translated x86 instructions
@@ -134,6 +136,19 @@ public:
 		return _Size;
 	}
 
+	// Removes the blocks pred returns true for, the others keep their order
+	template <typename Pred>
+	void remove_if(Pred pred)
+	{
+		s32 kept = 0;
+		for (s32 i = 0; i < _Size; i++)
+		{
+			if (!pred(blocks[i]))
+				blocks[kept++] = blocks[i];
+		}
+		_Size = kept;
+	}
+
 	__fi void erase(s32 first, s32 last)
 	{
 		int range = last - first;
@@ -228,6 +243,10 @@ public:
 
 	void Link(u32 pc, s32* jumpptr);
 
+	// Drops the blocks whose code is in [start, end) and the links from that code, before it gets reused.
+	// The jumps into them go back to the recompiler, clearing their BASEBLOCKs is up to the caller.
+	void Evict(uptr start, uptr end, std::vector<BASEBLOCKEX>& evicted);
+
 	__fi void Reset()
 	{
 		blocks.clear();
@@ -0,0 +1,176 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Core/PrecompiledHeader.h"
+#include "BlockProfiler.h"
+#include "common/emitter/x86emitter.h"
+
+#include <algorithm>
+#include <map>
+
+using namespace x86Emitter;
+
+bool BlockProfiling::Enabled = false;
+bool BlockProfiling::Timing  = false;
+
+BlockProfiler eeBlockProfiler("EE", Perf::ee);
+BlockProfiler iopBlockProfiler("IOP", Perf::iop);
+
+BlockProfile *g_eeProfiledBlock = nullptr;
+
+// Rows of the report for each cpu, the rest is noise for this kind of work
+static const size_t ReportBlocks = 200;
+
+// Both recompilers run on the EE thread, a single previous block is enough
+static BlockProfile *s_lastBlock = nullptr;
+static u64           s_lastEntry = 0;
+
+static void __fastcall BlockProfilerEnter(BlockProfile *block)
+{
+    const u64 now = __rdtsc();
+    if (s_lastBlock)
+        s_lastBlock->ticks += now - s_lastEntry;
+    s_lastBlock = block;
+    s_lastEntry = now;
+    block->count++;
+}
+
+void BlockProfile_AddOp(BlockProfile *block, eeOpcode op)
+{
+    block->ops.push_back(static_cast<u16>(op));
+}
+
+void BlockProfiling::Start(bool timing)
+{
+    Enabled = true;
+    Timing  = timing;
+}
+
+bool BlockProfiling::Report(const char *filename)
+{
+    FILE *fp = fopen(filename, "w");
+    if (!fp)
+        return false;
+
+    eeBlockProfiler.Report(fp);
+    iopBlockProfiler.Report(fp);
+    fclose(fp);
+    return true;
+}
+
+BlockProfile *BlockProfiler::Begin(u32 startpc)
+{
+    if (!BlockProfiling::Enabled)
+        return nullptr;
+
+    m_blocks.emplace_back();
+    BlockProfile *block = &m_blocks.back();
+    block->startpc      = startpc;
+
+    // nothing is live at the entry of a block
+    if (BlockProfiling::Timing) {
+        xFastCall((void *)BlockProfilerEnter, block);
+    } else {
+        xLoadFarAddr(rax, &block->count);
+        xADD(ptr64[rax], 1);
+    }
+    return block;
+}
+
+void BlockProfiler::End(BlockProfile *block, const BASEBLOCKEX &blockex)
+{
+    if (!block)
+        return;
+    block->size    = blockex.size;
+    block->x86size = blockex.x86size;
+}
+
+// "LW 4, ADDIU 3, SW 2" for the most common opcodes of a block
+static void FormatMix(char *dst, size_t size, const std::vector<u16> &ops)
+{
+    if (ops.empty()) {
+        snprintf(dst, size, "-");
+        return;
+    }
+
+    u16 histogram[static_cast<int>(eeOpcode::LAST)] = {};
+    for (u16 op : ops)
+        histogram[op]++;
+
+    std::vector<std::pair<u16, u16>> sorted;
+    for (int i = 0; i < static_cast<int>(eeOpcode::LAST); i++)
+        if (histogram[i])
+            sorted.push_back(std::make_pair(histogram[i], i));
+    std::sort(sorted.begin(), sorted.end(), [](auto &a, auto &b) { return a.first > b.first; });
+
+    size_t len = 0;
+    dst[0]     = 0;
+    for (size_t i = 0; i < std::min<size_t>(sorted.size(), 6) && len < size; i++)
+        len += snprintf(dst + len, size - len, "%s%s %u", i ? ", " : "", eeOpcodeName[sorted[i].second],
+                        sorted[i].first);
+}
+
+void BlockProfiler::Report(FILE *fp) const
+{
+    // A block recompiled after a reset or an invalidation gets a new record, report it once
+    struct Merged
+    {
+        const BlockProfile *last;
+        u64                 count;
+        u64                 ticks;
+        u32                 compiles;
+    };
+    std::map<u32, Merged> merged;
+    u64                   totalCount = 0;
+    u64                   totalTicks = 0;
+    for (const BlockProfile &block : m_blocks) {
+        Merged &m = merged[block.startpc];
+        m.last    = &block;
+        m.count += block.count;
+        m.ticks += block.ticks;
+        m.compiles++;
+        totalCount += block.count;
+        totalTicks += block.ticks;
+    }
+
+    std::vector<const Merged *> sorted;
+    sorted.reserve(merged.size());
+    for (auto &it : merged)
+        sorted.push_back(&it.second);
+    std::sort(sorted.begin(), sorted.end(), [](const Merged *a, const Merged *b) {
+        return BlockProfiling::Timing ? a->ticks > b->ticks : a->count > b->count;
+    });
+
+    fprintf(fp, "%s: %zu blocks, %zu compiles, %llu block entries\n\n", m_name, merged.size(), m_blocks.size(),
+            (unsigned long long)totalCount);
+    fprintf(fp, "%7s %7s %12s %14s  %-10s %5s %6s %8s  %-20s %s\n", "time%", "count%", "entries", "ticks", "pc",
+            "insts", "host", "compiles", "symbol", "mix");
+
+    for (size_t i = 0; i < std::min(sorted.size(), ReportBlocks); i++) {
+        const Merged &m = *sorted[i];
+        if (!m.count)
+            break;
+
+        char symbol[32];
+        char mix[128];
+        m_perf.symbol(symbol, sizeof(symbol), m.last->startpc);
+        FormatMix(mix, sizeof(mix), m.last->ops);
+        fprintf(fp, "%6.2f%% %6.2f%% %12llu %14llu  0x%08x %5u %6u %8u  %-20s %s\n",
+                totalTicks ? m.ticks * 100.0 / totalTicks : 0.0, m.count * 100.0 / totalCount,
+                (unsigned long long)m.count, (unsigned long long)m.ticks, m.last->startpc, m.last->size,
+                m.last->x86size, m.compiles, symbol, mix);
+    }
+    fprintf(fp, "\n");
+}
@@ -0,0 +1,74 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2021  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <deque>
+#include <vector>
+#include "common/Perf.h"
+#include "BaseblockEx.h"
+#include "R5900_Profiler.h"
+
+// --------------------------------------------------------------------------------------
+//  BlockProfiler
+// --------------------------------------------------------------------------------------
+// Counts how often each recompiled block runs. Every block compiled while the profiler is
+// on gets a counter increment at its entry, or with timing a call that also charges the
+// rdtsc delta since the previous block entry to the previous block. That time includes the
+// dispatcher and whatever event handling ran in between, which is what the block cost us.
+//
+// Blocks compiled before Start() aren't instrumented, start it before the VM boots.
+//
+struct BlockProfile
+{
+	u64 count;
+	u64 ticks;
+	u32 startpc;
+	u16 size;    // guest instructions
+	u16 x86size; // bytes of host code
+	std::vector<u16> ops; // eeOpcode of every instruction the EE recompiler emitted
+};
+
+class BlockProfiler
+{
+	std::deque<BlockProfile> m_blocks; // the emitted code points into it, so no vector
+	Perf::InfoVector& m_perf;
+	const char* m_name;
+
+public:
+	BlockProfiler(const char* name, Perf::InfoVector& perf)
+		: m_perf(perf)
+		, m_name(name)
+	{
+	}
+
+	// Emits the entry code of a block, and returns its record for the instruction mix.
+	BlockProfile* Begin(u32 startpc);
+	void End(BlockProfile* block, const BASEBLOCKEX& blockex);
+
+	void Report(FILE* fp) const;
+};
+
+namespace BlockProfiling
+{
+	extern bool Enabled;
+	extern bool Timing;
+
+	void Start(bool timing);
+	bool Report(const char* filename);
+} // namespace BlockProfiling
+
+extern BlockProfiler eeBlockProfiler;
+extern BlockProfiler iopBlockProfiler;
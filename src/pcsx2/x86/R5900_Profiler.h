@@ -222,6 +222,11 @@ static const char eeOpcodeName[][16] = {
 	"!"
 };
 
+// Block being compiled while the block profiler runs, EmitOp records its instruction mix (see BlockProfiler.h)
+struct BlockProfile;
+extern BlockProfile* g_eeProfiledBlock;
+extern void BlockProfile_AddOp(BlockProfile* block, eeOpcode op);
+
 //#define eeProfileProg
 
 #ifdef eeProfileProg
@@ -254,6 +259,8 @@ struct eeProfiler
 
 	void EmitOp(eeOpcode opcode)
 	{
+		if (g_eeProfiledBlock)
+			BlockProfile_AddOp(g_eeProfiledBlock, opcode);
 		int op = static_cast<int>(opcode);
 		xADD(ptr32[&(((u32*)opStats)[op * 2 + 0])], 1);
 		xADC(ptr32[&(((u32*)opStats)[op * 2 + 1])], 0);
@@ -413,7 +420,11 @@ struct eeProfiler
 struct eeProfiler
 {
 	__fi void Reset() {}
-	__fi void EmitOp(eeOpcode op) {}
+	__fi void EmitOp(eeOpcode op)
+	{
+		if (g_eeProfiledBlock)
+			BlockProfile_AddOp(g_eeProfiledBlock, op);
+	}
 	__fi void Print() {}
 	__fi void EmitMem() {}
 	__fi void EmitConstMem(u32 add) {}
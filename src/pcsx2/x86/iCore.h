@@ -131,6 +131,12 @@ void _flushCachedRegs();
 void _flushConstRegs();
 void _flushConstReg(int reg);
 
+// EE GPRs cached in x86 registers across the instructions of a block, see iCore-32.cpp
+extern bool g_cacheGPRtoX86;
+int _allocGPRtoX86reg(int gpr, int mode);
+void _flushGPRtoX86regs();
+void _freeGPRtoX86regs();
+
 ////////////////////////////////////////////////////////////////////////////////
 //   XMM (128-bit) Register Allocation Tools
 
@@ -161,6 +167,7 @@ struct _xmmregs
 
 void _cop2BackupRegs();
 void _cop2RestoreRegs();
+void COP2_SyncVU0(int kickstartCycles);
 void _initXMMregs();
 int _getFreeXMMreg();
 int _allocTempXMMreg(XMMSSEType type, int xmmreg);
@@ -618,7 +618,9 @@ void recPCGTB()
     EE::Profiler.EmitOp(eeOpcode::PCGTB);
 
     int info = eeRecompileCodeXMM(XMMINFO_READS | XMMINFO_READT | XMMINFO_WRITED);
-    if (EEREC_D != EEREC_T) {
+    if (x86caps.hasAVX) {
+        xVPCMP.GTB(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S), xRegisterSSE(EEREC_T));
+    } else if (EEREC_D != EEREC_T) {
         xMOVDQA(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
         xPCMP.GTB(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
     } else {
@@ -640,7 +642,9 @@ void recPCGTH()
     EE::Profiler.EmitOp(eeOpcode::PCGTH);
 
     int info = eeRecompileCodeXMM(XMMINFO_READS | XMMINFO_READT | XMMINFO_WRITED);
-    if (EEREC_D != EEREC_T) {
+    if (x86caps.hasAVX) {
+        xVPCMP.GTW(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S), xRegisterSSE(EEREC_T));
+    } else if (EEREC_D != EEREC_T) {
         xMOVDQA(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
         xPCMP.GTW(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
     } else {
@@ -663,7 +667,9 @@ void recPCGTW()
     EE::Profiler.EmitOp(eeOpcode::PCGTW);
 
     int info = eeRecompileCodeXMM(XMMINFO_READS | XMMINFO_READT | XMMINFO_WRITED);
-    if (EEREC_D != EEREC_T) {
+    if (x86caps.hasAVX) {
+        xVPCMP.GTD(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S), xRegisterSSE(EEREC_T));
+    } else if (EEREC_D != EEREC_T) {
         xMOVDQA(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
         xPCMP.GTD(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
     } else {
@@ -893,6 +899,8 @@ void recPADDB()
         xPADD.B(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
     else if (EEREC_D == EEREC_T)
         xPADD.B(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
+    else if (x86caps.hasAVX)
+        xVPADD.B(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S), xRegisterSSE(EEREC_T));
     else {
         xMOVDQA(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
         xPADD.B(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
@@ -921,6 +929,8 @@ void recPADDH()
             xPADD.W(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
         else if (EEREC_D == EEREC_T)
             xPADD.W(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
+        else if (x86caps.hasAVX)
+            xVPADD.W(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S), xRegisterSSE(EEREC_T));
         else {
             xMOVDQA(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
             xPADD.W(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
@@ -950,6 +960,8 @@ void recPADDW()
             xPADD.D(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
         else if (EEREC_D == EEREC_T)
             xPADD.D(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
+        else if (x86caps.hasAVX)
+            xVPADD.D(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S), xRegisterSSE(EEREC_T));
         else {
             xMOVDQA(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
             xPADD.D(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
@@ -969,6 +981,8 @@ void recPSUBB()
     int info = eeRecompileCodeXMM(XMMINFO_READS | XMMINFO_READT | XMMINFO_WRITED);
     if (EEREC_D == EEREC_S)
         xPSUB.B(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
+    else if (x86caps.hasAVX)
+        xVPSUB.B(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S), xRegisterSSE(EEREC_T));
     else if (EEREC_D == EEREC_T) {
         int t0reg = _allocTempXMMreg(XMMT_INT, -1);
         xMOVDQA(xRegisterSSE(t0reg), xRegisterSSE(EEREC_T));
@@ -993,6 +1007,8 @@ void recPSUBH()
     int info = eeRecompileCodeXMM(XMMINFO_READS | XMMINFO_READT | XMMINFO_WRITED);
     if (EEREC_D == EEREC_S)
         xPSUB.W(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
+    else if (x86caps.hasAVX)
+        xVPSUB.W(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S), xRegisterSSE(EEREC_T));
     else if (EEREC_D == EEREC_T) {
         int t0reg = _allocTempXMMreg(XMMT_INT, -1);
         xMOVDQA(xRegisterSSE(t0reg), xRegisterSSE(EEREC_T));
@@ -1017,6 +1033,8 @@ void recPSUBW()
     int info = eeRecompileCodeXMM(XMMINFO_READS | XMMINFO_READT | XMMINFO_WRITED);
     if (EEREC_D == EEREC_S)
         xPSUB.D(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
+    else if (x86caps.hasAVX)
+        xVPSUB.D(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S), xRegisterSSE(EEREC_T));
     else if (EEREC_D == EEREC_T) {
         int t0reg = _allocTempXMMreg(XMMT_INT, -1);
         xMOVDQA(xRegisterSSE(t0reg), xRegisterSSE(EEREC_T));
@@ -1547,6 +1565,8 @@ void recPCEQB()
         xPCMP.EQB(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
     else if (EEREC_D == EEREC_T)
         xPCMP.EQB(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
+    else if (x86caps.hasAVX)
+        xVPCMP.EQB(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S), xRegisterSSE(EEREC_T));
     else {
         xMOVDQA(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
         xPCMP.EQB(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
@@ -1567,6 +1587,8 @@ void recPCEQH()
         xPCMP.EQW(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
     else if (EEREC_D == EEREC_T)
         xPCMP.EQW(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
+    else if (x86caps.hasAVX)
+        xVPCMP.EQW(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S), xRegisterSSE(EEREC_T));
     else {
         xMOVDQA(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
         xPCMP.EQW(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
@@ -1587,6 +1609,8 @@ void recPCEQW()
         xPCMP.EQD(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
     else if (EEREC_D == EEREC_T)
         xPCMP.EQD(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
+    else if (x86caps.hasAVX)
+        xVPCMP.EQD(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S), xRegisterSSE(EEREC_T));
     else {
         xMOVDQA(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
         xPCMP.EQD(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
@@ -2222,6 +2246,8 @@ void recPAND()
         xPAND(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
     } else if (EEREC_D == EEREC_S) {
         xPAND(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
+    } else if (x86caps.hasAVX) {
+        xVPAND(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S), xRegisterSSE(EEREC_T));
     } else {
         xMOVDQA(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
         xPAND(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
@@ -2242,6 +2268,8 @@ void recPXOR()
         xPXOR(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
     } else if (EEREC_D == EEREC_S) {
         xPXOR(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
+    } else if (x86caps.hasAVX) {
+        xVPXOR(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S), xRegisterSSE(EEREC_T));
     } else {
         xMOVDQA(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
         xPXOR(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
@@ -2748,6 +2776,8 @@ void recPOR()
             xPOR(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
         } else if (EEREC_D == EEREC_T) {
             xPOR(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S));
+        } else if (x86caps.hasAVX) {
+            xVPOR(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_S), xRegisterSSE(EEREC_T));
         } else {
             xMOVDQA(xRegisterSSE(EEREC_D), xRegisterSSE(EEREC_T));
             if (EEREC_S != EEREC_T) {
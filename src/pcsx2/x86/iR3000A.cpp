@@ -22,11 +22,15 @@
 
 #include "iR3000A.h"
 #include "BaseblockEx.h"
+#include "BlockProfiler.h"
 #include "System/RecTypes.h"
 #include "System/SysThreads.h"
 #include "R5900OpcodeTables.h"
 
 #include <time.h>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
 
 #ifndef _WIN32
 #include <sys/types.h>
@@ -63,7 +67,9 @@ static BASEBLOCK *recROM  = NULL;    // and here
 static BASEBLOCK *recROM1 = NULL;    // also here
 static BASEBLOCK *recROM2 = NULL;    // also here
 static BaseBlocks recBlocks;
-static u8        *recPtr = NULL;
+static u8        *recPtr     = NULL;
+static int        recYoung   = 0;    // the half of the code cache blocks go to
+static uptr       recOldUsed = 0;    // bytes of code in the other half
 u32               psxpc;        // recompiler psxpc
 int               psxbranch;    // set for branch
 u32               g_iopCyclePenalty;
@@ -658,6 +664,201 @@ void psxRecompileCodeConst3(R3000AFNPTR constcode, R3000AFNPTR_INFO constscode,
     noconstcode(0);
 }
 
+// --------------------------------------------------------------------------------------
+//  Persistent block cache
+// --------------------------------------------------------------------------------------
+// Most IOP code is the same handful of IRX modules, loaded at the same addresses in every run. The pcs blocks get
+// compiled at are remembered for each 4KB page of code, keyed by the address and contents of the page when its
+// first block is compiled, and kept on disk between runs. When a page with the same contents is entered again, all
+// of its blocks are compiled in one go, and with PrecompileIOPModules the pages of the module around it too.
+// The x86 code itself isn't kept, it refers to host addresses that change from one run to the next.
+
+struct IopCodePage
+{
+    u64              key;       // address and contents of the page when its first block was compiled
+    std::vector<u32> blocks;    // start pcs, with the segment they were entered through
+};
+
+static std::unordered_map<u64, std::vector<u32>> s_iopBlockCache;    // every run so far, by page key
+static std::unordered_map<u32, IopCodePage>      s_iopCodePages;     // pages with code in this run, by page number
+static bool                                      s_iopBlockCacheLoaded = false;
+static bool                                      s_iopBlockCacheDirty  = false;
+
+static const u32 IopBlockCacheMagic   = 0x42504f49;    // "IOPB"
+static const u32 IopBlockCacheVersion = 1;
+
+static wxString GetIopBlockCacheFilename()
+{
+    return (EmuFolders::Savestates + wxString(L"iop_blocks.cache")).GetFullPath();
+}
+
+static u64 IopPageKey(u32 page)
+{
+    const u64 *words = iopVirtMemR<u64>(page << 12);
+    if (!words)
+        return 0;
+
+    u64 hash = 0xcbf29ce484222325ull ^ page;
+    for (uint i = 0; i < 0x1000 / 8; i++)
+        hash = (hash ^ words[i]) * 0x100000001b3ull;
+    return hash;
+}
+
+static void iopBlockCacheLoad()
+{
+    s_iopBlockCacheLoaded = true;
+
+    const wxString filename(GetIopBlockCacheFilename());
+    FILE          *fp = wxFopen(filename, L"rb");
+    if (!fp)
+        return;
+
+    u32  header[2];
+    bool ok = fread(header, sizeof(header), 1, fp) == 1 && header[0] == IopBlockCacheMagic &&
+              header[1] == IopBlockCacheVersion;
+
+    u64 key;
+    u32 count;
+    while (ok && fread(&key, sizeof(key), 1, fp) == 1) {
+        ok = fread(&count, sizeof(count), 1, fp) == 1 && count <= 0x1000 / 4;
+        if (ok) {
+            std::vector<u32> &blocks = s_iopBlockCache[key];
+            blocks.resize(count);
+            ok = fread(blocks.data(), sizeof(u32), count, fp) == count;
+        }
+    }
+    fclose(fp);
+
+    if (!ok) {
+        Console.Warning(L"IOP block cache '%s' is unusable, starting over.", WX_STR(filename));
+        s_iopBlockCache.clear();
+        return;
+    }
+    DevCon.WriteLn("IOP block cache: %zu pages of code known", s_iopBlockCache.size());
+}
+
+static void iopBlockCacheSave()
+{
+    if (!s_iopBlockCacheDirty)
+        return;
+    s_iopBlockCacheDirty = false;
+
+    const wxString filename(GetIopBlockCacheFilename());
+    EmuFolders::Savestates.Mkdir();
+    FILE *fp = wxFopen(filename, L"wb");
+    if (!fp) {
+        Console.Error(L"Cannot write the IOP block cache to '%s'", WX_STR(filename));
+        return;
+    }
+
+    const u32 header[2] = {IopBlockCacheMagic, IopBlockCacheVersion};
+    fwrite(header, sizeof(header), 1, fp);
+    for (const auto &page : s_iopBlockCache) {
+        const u32 count = page.second.size();
+        fwrite(&page.first, sizeof(page.first), 1, fp);
+        fwrite(&count, sizeof(count), 1, fp);
+        fwrite(page.second.data(), sizeof(u32), count, fp);
+    }
+    fclose(fp);
+}
+
+static void iopBlockCacheCommit(const IopCodePage &page)
+{
+    if (page.blocks.empty())
+        return;
+
+    std::vector<u32> &blocks = s_iopBlockCache[page.key];
+    const size_t      known  = blocks.size();
+    blocks.insert(blocks.end(), page.blocks.begin(), page.blocks.end());
+    std::sort(blocks.begin(), blocks.end());
+    blocks.erase(std::unique(blocks.begin(), blocks.end()), blocks.end());
+    if (blocks.size() != known)
+        s_iopBlockCacheDirty = true;
+}
+
+// The recompiler dropped all of its blocks
+static void iopBlockCacheFlush()
+{
+    for (const auto &page : s_iopCodePages)
+        iopBlockCacheCommit(page.second);
+    s_iopCodePages.clear();
+    iopBlockCacheSave();
+}
+
+// The blocks in [start, end) were cleared, their pages get a new key the next time code is compiled in them
+static void iopBlockCacheForget(u32 start, u32 end)
+{
+    if (s_iopCodePages.empty())
+        return;
+
+    for (u32 page = start >> 12; page <= (end - 1) >> 12; page++) {
+        const auto it = s_iopCodePages.find(page);
+        if (it != s_iopCodePages.end()) {
+            iopBlockCacheCommit(it->second);
+            s_iopCodePages.erase(it);
+        }
+    }
+}
+
+// Starts tracking a page and compiles the blocks remembered for its contents, except the one at skippc which is
+// about to be compiled anyway. Pages that aren't known are only tracked if track is set. Returns false if there
+// was nothing to compile, or if the recompiler was reset meanwhile.
+static bool iopBlockCacheOpenPage(u32 page, u32 skippc, bool track)
+{
+    // The kernel vectors below 0x2000 compile differently depending on when they are reached, see iopRecRecompile
+    if (page < 2 || s_iopCodePages.count(page))
+        return false;
+
+    const u64  key   = IopPageKey(page);
+    const auto known = s_iopBlockCache.find(key);
+    if (!key || known == s_iopBlockCache.end()) {
+        if (track && key)
+            s_iopCodePages.emplace(page, IopCodePage{key});
+        return false;
+    }
+
+    s_iopCodePages.emplace(page, IopCodePage{key});
+
+    const std::vector<u32> blocks(known->second);
+    const u64              resets = g_iopRecStats.CacheResets;
+    for (u32 pc : blocks) {
+        if (HWADDR(pc) == HWADDR(skippc) || HWADDR(pc) >> 12 != page)
+            continue;
+
+        const uptr fnptr = PSX_GETBLOCK(pc)->GetFnptr();
+        if (fnptr == (uptr)iopJITCompile || fnptr == (uptr)iopJITCompileInBlock)
+            iopRecRecompile(pc);
+        if (g_iopRecStats.CacheResets != resets)
+            return false;
+    }
+    return true;
+}
+
+// Called by iopRecRecompile for every block, before anything else
+static void iopBlockCacheEnter(u32 startpc)
+{
+    const u32 page = HWADDR(startpc) >> 12;
+    auto      it   = s_iopCodePages.find(page);
+    if (it == s_iopCodePages.end()) {
+        if (!s_iopBlockCacheLoaded)
+            iopBlockCacheLoad();
+
+        // The pages of a module are contiguous, and known ones next to each other most likely belong to it
+        if (iopBlockCacheOpenPage(page, startpc, true) && EmuConfig.Cpu.Recompiler.PrecompileIOPModules) {
+            for (u32 next = page + 1; iopBlockCacheOpenPage(next, 0, false); next++)
+                ;
+            for (u32 prev = page - 1; iopBlockCacheOpenPage(prev, 0, false); prev--)
+                ;
+        }
+
+        // A reset while precompiling forgot about the page
+        it = s_iopCodePages.find(page);
+        if (it == s_iopCodePages.end())
+            return;
+    }
+    it->second.blocks.push_back(startpc);
+}
+
 static uptr m_ConfiguredCacheReserve = 32;
 static u8  *m_recBlockAlloc          = NULL;
 
@@ -728,6 +929,7 @@ static void recAlloc()
 void recResetIOP()
 {
     DevCon.WriteLn("iR3000A Recompiler reset.");
+    g_iopRecStats.CacheResets++;
 
     Perf::iop.reset();
 
@@ -778,12 +980,21 @@ void recResetIOP()
     recBlocks.Reset();
     g_psxMaxRecMem = 0;
 
-    recPtr    = *recMem;
-    psxbranch = 0;
+    recPtr     = *recMem;
+    recYoung   = 0;
+    recOldUsed = 0;
+    psxbranch  = 0;
+
+    g_iopRecStats.CacheUsed = 0;
+    g_iopRecStats.CacheSize = recMem->GetPtrEnd() - (u8 *)*recMem;
+
+    iopBlockCacheFlush();
 }
 
 static void recShutdown()
 {
+    iopBlockCacheFlush();
+
     safe_delete(recMem);
 
     safe_aligned_free(m_recBlockAlloc);
@@ -887,6 +1098,7 @@ static __fi u32 psxRecClearMem(u32 pc)
     }
 
     iopClearRecLUT(PSX_GETBLOCK(lowerextent), (upperextent - lowerextent) / 4);
+    iopBlockCacheForget(lowerextent, upperextent);
 
     return upperextent - pc;
 }
@@ -1264,6 +1476,43 @@ static void __fastcall PreBlockCheck(u32 blockpc)
 #endif
 }
 
+// The code cache is split in two generations like the EE one, see recFlushGeneration() in iR5900-32.cpp
+
+static u8 *recHalf(int half)
+{
+    const uptr size = ((recMem->GetPtrEnd() - (u8 *)*recMem) / 2) & ~(uptr)(__pagesize - 1);
+    return (u8 *)*recMem + half * size;
+}
+
+static void recFlushGeneration()
+{
+    const int  old      = recYoung ^ 1;
+    const uptr oldStart = (uptr)recHalf(old);
+    const uptr oldEnd   = (uptr)recHalf(old + 1);
+
+    std::vector<BASEBLOCKEX> evicted;
+    recBlocks.Evict(oldStart, oldEnd, evicted);
+    for (const BASEBLOCKEX &block : evicted) {
+        BASEBLOCK *pblock = PSX_GETBLOCK(block.startpc);
+        for (u32 i = 0; i < std::max<u32>(block.size, 1); i++) {
+            if (pblock[i].GetFnptr() >= oldStart && pblock[i].GetFnptr() < oldEnd)
+                pblock[i].SetFnptr((uptr)iopJITCompile);
+        }
+        g_iopRecStats.EvictedAge += (u32)g_iopRecStats.BlocksCompiled - block.serial;
+    }
+
+    if (IsDevBuild)
+        memset((void *)oldStart, 0xcc, oldEnd - oldStart);
+
+    DevCon.WriteLn("IOP recompiler: old generation flushed, %zu blocks dropped", evicted.size());
+    g_iopRecStats.CacheFlushes++;
+    g_iopRecStats.BlocksEvicted += evicted.size();
+
+    recOldUsed = recPtr - recHalf(recYoung);
+    recYoung   = old;
+    recPtr     = recHalf(recYoung);
+}
+
 static void __fastcall iopRecRecompile(const u32 startpc)
 {
     u32 i;
@@ -1284,10 +1533,12 @@ static void __fastcall iopRecRecompile(const u32 startpc)
 
     pxAssert(startpc);
 
-    // if recPtr reached the mem limit reset whole mem
-    if (recPtr >= (recMem->GetPtrEnd() - _64kb)) {
-        recResetIOP();
-    }
+    if (EmuConfig.Cpu.Recompiler.PersistIOPBlocks)
+        iopBlockCacheEnter(startpc);
+
+    // if the young generation is full, drop the old one and compile there
+    if (recPtr >= recHalf(recYoung + 1) - _64kb)
+        recFlushGeneration();
 
     x86SetPtr(recPtr);
     x86Align(16);
@@ -1302,6 +1553,8 @@ static void __fastcall iopRecRecompile(const u32 startpc)
     if (!s_pCurBlockEx || s_pCurBlockEx->startpc != HWADDR(startpc))
         s_pCurBlockEx = recBlocks.New(HWADDR(startpc), (uptr)recPtr);
 
+    s_pCurBlockEx->serial = (u32)g_iopRecStats.BlocksCompiled++;
+
     psxbranch = 0;
 
     s_pCurBlock->SetFnptr((uptr)x86Ptr);
@@ -1313,6 +1566,8 @@ static void __fastcall iopRecRecompile(const u32 startpc)
 
     _initX86regs();
 
+    BlockProfile *profile = iopBlockProfiler.Begin(HWADDR(startpc));
+
     if ((psxHu32(HW_ICFG) & 8) && (HWADDR(startpc) == 0xa0 || HWADDR(startpc) == 0xb0 || HWADDR(startpc) == 0xc0)) {
         xFastCall((void *)psxBiosCall);
         xTEST(al, al);
@@ -1475,14 +1730,16 @@ StartRecomp:
         }
     }
 
-    pxAssert(xGetPtr() < recMem->GetPtrEnd());
+    pxAssert(xGetPtr() < recHalf(recYoung + 1));
 
     pxAssert(xGetPtr() - recPtr < _64kb);
     s_pCurBlockEx->x86size = xGetPtr() - recPtr;
 
     Perf::iop.map(s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc);
+    iopBlockProfiler.End(profile, *s_pCurBlockEx);
 
-    recPtr = xGetPtr();
+    recPtr                  = xGetPtr();
+    g_iopRecStats.CacheUsed = recOldUsed + (recPtr - recHalf(recYoung));
 
     pxAssert((g_psxHasConstReg & g_psxFlushedConstReg) == g_psxHasConstReg);
 
@@ -72,6 +72,7 @@ void LoadBranchState();
 void recompileNextInstruction(int delayslot);
 void SetBranchReg(u32 reg);
 void SetBranchImm(u32 imm);
+void recPushReturnAddress(u32 retpc);
 
 void iFlushCall(int flushtype);
 void recBranchCall(void (*func)());
@@ -115,6 +116,9 @@ u32* _eeGetConstReg(int reg);
 
 // finds where the GPR is stored and moves lower 32 bits to EAX
 void _eeMoveGPRtoR(const x86Emitter::xRegister32& to, int fromgpr);
+// lower 64 bits, from and to the x86 register caching the GPR when there is one
+void _eeMoveGPRtoR(const x86Emitter::xRegister64& to, int fromgpr);
+void _eeMoveRtoGPR(int togpr, const x86Emitter::xRegister64& from);
 void _eeMoveGPRtoM(uptr to, int fromgpr);
 void _eeMoveGPRtoRm(x86IntRegType to, int fromgpr);
 void _signExtendToMem(void* mem);
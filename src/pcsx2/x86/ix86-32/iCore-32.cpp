@@ -31,6 +31,14 @@ extern u32 g_psxConstRegs[32];
 // X86 caching
 static int g_x86checknext;
 
+bool g_cacheGPRtoX86 = false;
+
+// EE GPRs only go to registers that are callee-saved in both ABIs and that no recompiler
+// code uses by name while they hold something, so they survive the vtlb handlers untouched.
+#ifdef __M_X86_64
+static const int s_gprX86regs[] = {12, 14, 15};    // r12, r14, r15
+#endif
+
 // use special x86 register allocation for ia32
 
 void _initX86regs()
@@ -38,6 +46,7 @@ void _initX86regs()
     memzero(x86regs);
     g_x86AllocCounter = 0;
     g_x86checknext    = 0;
+    g_cacheGPRtoX86   = false;
 }
 
 uptr _x86GetAddr(int type, int reg)
@@ -435,7 +444,9 @@ void _deleteX86reg(int type, int reg, int flush)
                 case 1:
                     if (x86regs[i].mode & MODE_WRITE) {
 
-                        if (X86_ISVI(type) && x86regs[i].reg < 16)
+                        if (type == X86TYPE_GPR)
+                            xMOV(ptr64[(void *)(_x86GetAddr(type, x86regs[i].reg))], xRegister64(i));
+                        else if (X86_ISVI(type) && x86regs[i].reg < 16)
                             xMOV(ptr[(void *)(_x86GetAddr(type, x86regs[i].reg))], xRegister16(i));
                         else
                             xMOV(ptr[(void *)(_x86GetAddr(type, x86regs[i].reg))], xRegister32(i));
@@ -467,7 +478,9 @@ void _freeX86reg(int x86reg)
     if (x86regs[x86reg].inuse && (x86regs[x86reg].mode & MODE_WRITE)) {
         x86regs[x86reg].mode &= ~MODE_WRITE;
 
-        if (X86_ISVI(x86regs[x86reg].type) && x86regs[x86reg].reg < 16) {
+        if (x86regs[x86reg].type == X86TYPE_GPR) {
+            xMOV(ptr64[(void *)(_x86GetAddr(X86TYPE_GPR, x86regs[x86reg].reg))], xRegister64(x86reg));
+        } else if (X86_ISVI(x86regs[x86reg].type) && x86regs[x86reg].reg < 16) {
             xMOV(ptr[(void *)(_x86GetAddr(x86regs[x86reg].type, x86regs[x86reg].reg))], xRegister16(x86reg));
         } else
             xMOV(ptr[(void *)(_x86GetAddr(x86regs[x86reg].type, x86regs[x86reg].reg))], xRegister32(x86reg));
@@ -482,6 +495,87 @@ void _freeX86regs()
         _freeX86reg(i);
 }
 
+// Returns the x86 register holding the lower 64 bits of an EE GPR, allocating one when
+// g_cacheGPRtoX86 is set. -1 means the GPR lives in cpuRegs for this access.
+// MODE_READ loads the current value, MODE_WRITE marks it dirty: the caller must fill it.
+int _allocGPRtoX86reg(int gpr, int mode)
+{
+#ifdef __M_X86_64
+    if (gpr <= 0 || gpr >= 32)
+        return -1;
+
+    for (int i : s_gprX86regs) {
+        if (x86regs[i].inuse && x86regs[i].type == X86TYPE_GPR && x86regs[i].reg == gpr) {
+            x86regs[i].mode |= mode & MODE_WRITE;
+            x86regs[i].counter = g_x86AllocCounter++;
+            x86regs[i].needed  = 1;
+            return i;
+        }
+    }
+
+    if (!g_cacheGPRtoX86)
+        return -1;
+
+    // a free register, or the least recently used GPR the current instruction doesn't need
+    int x86reg    = -1;
+    u32 bestcount = 0x10000;
+    for (int i : s_gprX86regs) {
+        if (!x86regs[i].inuse) {
+            x86reg = i;
+            break;
+        }
+        if (x86regs[i].type == X86TYPE_GPR && !x86regs[i].needed && x86regs[i].counter < bestcount) {
+            x86reg    = i;
+            bestcount = x86regs[i].counter;
+        }
+    }
+    if (x86reg < 0)
+        return -1;
+    _freeX86reg(x86reg);
+
+    // the xmm copy holds the upper half too, it has to be in memory before the lower half moves
+    _deleteGPRtoXMMreg(gpr, 2);
+    if (mode & MODE_READ) {
+        _flushConstReg(gpr);
+        xMOV(xRegister64(x86reg), ptr64[&cpuRegs.GPR.r[gpr].UD[0]]);
+    }
+
+    x86regs[x86reg].type    = X86TYPE_GPR;
+    x86regs[x86reg].reg     = gpr;
+    x86regs[x86reg].mode    = MODE_READ | (mode & MODE_WRITE);
+    x86regs[x86reg].needed  = 1;
+    x86regs[x86reg].inuse   = 1;
+    x86regs[x86reg].counter = g_x86AllocCounter++;
+    return x86reg;
+#else
+    return -1;
+#endif
+}
+
+// Writes the dirty GPRs back to cpuRegs, they stay cached.
+void _flushGPRtoX86regs()
+{
+#ifdef __M_X86_64
+    for (int i : s_gprX86regs) {
+        if (x86regs[i].inuse && x86regs[i].type == X86TYPE_GPR && (x86regs[i].mode & MODE_WRITE)) {
+            xMOV(ptr64[&cpuRegs.GPR.r[x86regs[i].reg].UD[0]], xRegister64(i));
+            x86regs[i].mode &= ~MODE_WRITE;
+        }
+    }
+#endif
+}
+
+// Writes the dirty GPRs back to cpuRegs and forgets all of them.
+void _freeGPRtoX86regs()
+{
+#ifdef __M_X86_64
+    for (int i : s_gprX86regs) {
+        if (x86regs[i].inuse && x86regs[i].type == X86TYPE_GPR)
+            _freeX86reg(i);
+    }
+#endif
+}
+
 // Misc
 
 void _signExtendSFtoM(uptr mem)
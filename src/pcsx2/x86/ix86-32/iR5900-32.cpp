@@ -22,6 +22,7 @@
 #include "R5900OpcodeTables.h"
 #include "iR5900.h"
 #include "BaseblockEx.h"
+#include "BlockProfiler.h"
 #include "System/RecTypes.h"
 
 #include "vtlb.h"
@@ -76,6 +77,7 @@ static const int RECCONSTBUF_SIZE = 16384 * 2;    // 64 bit consts in 32 bit uni
 
 static RecompiledCodeReserve *recMem            = NULL;
 static u8                    *recRAMCopy        = NULL;
+static u8                    *recRAMEntries     = NULL;    // times each RAM block was entered uncompiled
 static u8                    *recLutReserve_RAM = NULL;
 static const size_t           recLutSize =
     (Ps2MemSize::MainRam + Ps2MemSize::Rom + Ps2MemSize::Rom1 + Ps2MemSize::Rom2) * wordsize / 4;
@@ -91,6 +93,9 @@ static BASEBLOCK *recROM2 = NULL;                        // also here
 static BaseBlocks recBlocks;
 static u8        *recPtr           = NULL;
 static u32       *recConstBufPtr   = NULL;
+static u32       *recImm64Cache[509];    // recently allocated constants, all in the young generation
+static int        recYoung   = 0;        // the half of the code cache and constant buffer blocks go to
+static uptr       recOldUsed = 0;        // bytes of code in the other half
 EEINST           *s_pInstCache     = NULL;
 static u32        s_nInstCacheSize = 0;
 
@@ -113,10 +118,12 @@ static u32 dumplog = 0;
 #define dumplog 0
 #endif
 
-static void iBranchTest(u32 newpc = 0xffffffff);
+static void iBranchTest(u32 newpc = 0xffffffff, bool predict = false, bool isReturn = false);
 static void ClearRecLUT(BASEBLOCK *base, int count);
 static u32  scaleblockcycles();
 static void recExitExecution();
+static void recDumpIndirectStats();
+static void recResetIndirectSites();
 
 void _eeFlushAllUnused()
 {
@@ -163,9 +170,12 @@ void _eeMoveGPRtoR(const xRegister32 &to, int fromgpr)
     else if (GPR_IS_CONST1(fromgpr))
         xMOV(to, g_cpuConstRegs[fromgpr].UL[0]);
     else {
-        int mmreg;
+        int mmreg, x86reg;
 
-        if ((mmreg = _checkXMMreg(XMMTYPE_GPRREG, fromgpr, MODE_READ)) >= 0 && (xmmregs[mmreg].mode & MODE_WRITE)) {
+        if ((x86reg = _allocGPRtoX86reg(fromgpr, MODE_READ)) >= 0) {
+            xMOV(to, xRegister32(x86reg));
+        } else if ((mmreg = _checkXMMreg(XMMTYPE_GPRREG, fromgpr, MODE_READ)) >= 0 &&
+                   (xmmregs[mmreg].mode & MODE_WRITE)) {
             xMOVD(to, xRegisterSSE(mmreg));
         } else {
             xMOV(to, ptr[&cpuRegs.GPR.r[fromgpr].UL[0]]);
@@ -173,14 +183,44 @@ void _eeMoveGPRtoR(const xRegister32 &to, int fromgpr)
     }
 }
 
+void _eeMoveGPRtoR(const xRegister64 &to, int fromgpr)
+{
+    if (fromgpr == 0)
+        xXOR(xRegister32(to), xRegister32(to));
+    else if (GPR_IS_CONST1(fromgpr))
+        xMOV64(to, g_cpuConstRegs[fromgpr].SD[0]);
+    else {
+        int x86reg;
+
+        if ((x86reg = _allocGPRtoX86reg(fromgpr, MODE_READ)) >= 0) {
+            xMOV(to, xRegister64(x86reg));
+        } else {
+            _deleteGPRtoXMMreg(fromgpr, 1);
+            xMOV(to, ptr64[&cpuRegs.GPR.r[fromgpr].UD[0]]);
+        }
+    }
+}
+
+void _eeMoveRtoGPR(int togpr, const xRegister64 &from)
+{
+    int x86reg;
+
+    if ((x86reg = _allocGPRtoX86reg(togpr, MODE_WRITE)) >= 0)
+        xMOV(xRegister64(x86reg), from);
+    else
+        xMOV(ptr64[&cpuRegs.GPR.r[togpr].UD[0]], from);
+}
+
 void _eeMoveGPRtoM(uptr to, int fromgpr)
 {
     if (GPR_IS_CONST1(fromgpr))
         xMOV(ptr32[(u32 *)(to)], g_cpuConstRegs[fromgpr].UL[0]);
     else {
-        int mmreg;
+        int mmreg, x86reg;
 
-        if ((mmreg = _checkXMMreg(XMMTYPE_GPRREG, fromgpr, MODE_READ)) >= 0) {
+        if ((x86reg = _allocGPRtoX86reg(fromgpr, MODE_READ)) >= 0) {
+            xMOV(ptr[(void *)(to)], xRegister32(x86reg));
+        } else if ((mmreg = _checkXMMreg(XMMTYPE_GPRREG, fromgpr, MODE_READ)) >= 0) {
             xMOVSS(ptr[(void *)(to)], xRegisterSSE(mmreg));
         } else {
             xMOV(eax, ptr[&cpuRegs.GPR.r[fromgpr].UL[0]]);
@@ -194,9 +234,11 @@ void _eeMoveGPRtoRm(x86IntRegType to, int fromgpr)
     if (GPR_IS_CONST1(fromgpr))
         xMOV(ptr32[xAddressReg(to)], g_cpuConstRegs[fromgpr].UL[0]);
     else {
-        int mmreg;
+        int mmreg, x86reg;
 
-        if ((mmreg = _checkXMMreg(XMMTYPE_GPRREG, fromgpr, MODE_READ)) >= 0) {
+        if ((x86reg = _allocGPRtoX86reg(fromgpr, MODE_READ)) >= 0) {
+            xMOV(ptr[xAddressReg(to)], xRegister32(x86reg));
+        } else if ((mmreg = _checkXMMreg(XMMTYPE_GPRREG, fromgpr, MODE_READ)) >= 0) {
             xMOVSS(ptr[xAddressReg(to)], xRegisterSSE(mmreg));
         } else {
             xMOV(eax, ptr[&cpuRegs.GPR.r[fromgpr].UL[0]]);
@@ -219,7 +261,12 @@ void _signExtendToMem(void *mem)
 
 void eeSignExtendTo(int gpr, bool onlyupper)
 {
-    if (onlyupper) {
+    int x86reg;
+
+    // a cached GPR always takes the whole value, eax still has the lower half
+    if ((x86reg = _allocGPRtoX86reg(gpr, MODE_WRITE)) >= 0) {
+        xMOVSX(xRegister64(x86reg), eax);
+    } else if (onlyupper) {
         xCDQ();
         xMOV(ptr32[&cpuRegs.GPR.r[gpr].UL[1]], edx);
     } else {
@@ -270,15 +317,14 @@ int _flushUnusedConstReg()
 // MMX register allocation for the EE.
 u32 *recGetImm64(u32 hi, u32 lo)
 {
-    u32        *imm64;    // returned pointer
-    static u32 *imm64_cache[509];
-    int         cacheidx = lo % (sizeof imm64_cache / sizeof *imm64_cache);
+    u32 *imm64;    // returned pointer
+    int  cacheidx = lo % (sizeof recImm64Cache / sizeof *recImm64Cache);
 
-    imm64 = imm64_cache[cacheidx];
+    imm64 = recImm64Cache[cacheidx];
     if (imm64 && imm64[0] == lo && imm64[1] == hi)
         return imm64;
 
-    if (recConstBufPtr >= recConstBuf + RECCONSTBUF_SIZE) {
+    if (recConstBufPtr >= recConstBuf + (recYoung + 1) * (RECCONSTBUF_SIZE / 2)) {
         Console.WriteLn("EErec const buffer filled; Resetting...");
         throw Exception::ExitCpuExecute();
 
@@ -295,7 +341,7 @@ u32 *recGetImm64(u32 hi, u32 lo)
 
     imm64 = recConstBufPtr;
     recConstBufPtr += 2;
-    imm64_cache[cacheidx] = imm64;
+    recImm64Cache[cacheidx] = imm64;
 
     imm64[0] = lo;
     imm64[1] = hi;
@@ -330,6 +376,7 @@ void recCall(void (*func)())
 // =====================================================================================================
 
 static void __fastcall recRecompile(const u32 startpc);
+static void __fastcall recJITCompile(const u32 startpc);
 static void __fastcall dyna_block_discard(u32 start, u32 sz);
 static void __fastcall dyna_page_reset(u32 start, u32 sz);
 
@@ -357,15 +404,15 @@ static void recEventTest()
     }
 }
 
-// The address for all cleared blocks.  It recompiles the current pc and then
-// dispatches to the recompiled block address.
+// The address for all cleared blocks.  It recompiles the current pc (or interprets it,
+// see recJITCompile) and then dispatches to the block address of the new pc.
 static DynGenFunc *_DynGen_JITCompile()
 {
     pxAssertMsg(DispatcherReg != NULL, "Please compile the DispatcherReg subroutine *before* JITComple.  Thanks.");
 
     u8 *retval = xGetAlignedCallTarget();
 
-    xFastCall((void *)recRecompile, ptr32[&cpuRegs.pc]);
+    xFastCall((void *)recJITCompile, ptr32[&cpuRegs.pc]);
 
     // C equivalent:
     // u32 addr = cpuRegs.pc;
@@ -538,6 +585,10 @@ static void recAlloc()
         recRAMCopy = (u8 *)_aligned_malloc(Ps2MemSize::MainRam, 4096);
     }
 
+    if (!recRAMEntries) {
+        recRAMEntries = (u8 *)_aligned_malloc(Ps2MemSize::MainRam / 4, 4096);
+    }
+
     if (!recRAM) {
         recLutReserve_RAM = (u8 *)_aligned_malloc(recLutSize, 4096);
     }
@@ -620,25 +671,35 @@ static void recResetRaw()
     eeRecNeedsReset = false;
 
     Console.WriteLn(Color_StrongBlack, "EE/iR5900-32 Recompiler Reset");
+    g_eeRecStats.CacheResets++;
 
     recMem->Reset();
     ClearRecLUT((BASEBLOCK *)recLutReserve_RAM, recLutSize);
     memset(recRAMCopy, 0, Ps2MemSize::MainRam);
+    memset(recRAMEntries, 0, Ps2MemSize::MainRam / 4);
 
     maxrecmem = 0;
 
     memset(recConstBuf, 0, RECCONSTBUF_SIZE * sizeof(*recConstBuf));
+    memzero(recImm64Cache);
 
     if (s_pInstCache)
         memset(s_pInstCache, 0, sizeof(EEINST) * s_nInstCacheSize);
 
     recBlocks.Reset();
     mmap_ResetBlockTracking();
+    recDumpIndirectStats();
+    recResetIndirectSites();
 
     x86SetPtr(*recMem);
 
     recPtr         = *recMem;
     recConstBufPtr = recConstBuf;
+    recYoung       = 0;
+    recOldUsed     = 0;
+
+    g_eeRecStats.CacheUsed = 0;
+    g_eeRecStats.CacheSize = recMem->GetPtrEnd() - (u8 *)*recMem;
 
     g_branch              = 0;
     g_resetEeScalingStats = true;
@@ -649,6 +710,7 @@ static void recShutdown()
 {
     safe_delete(recMem);
     safe_aligned_free(recRAMCopy);
+    safe_aligned_free(recRAMEntries);
     safe_aligned_free(recLutReserve_RAM);
 
     recBlocks.Reset();
@@ -658,6 +720,9 @@ static void recShutdown()
     safe_free(s_pInstCache);
     s_nInstCacheSize = 0;
 
+    recDumpIndirectStats();
+    recResetIndirectSites();
+
     // FIXME Warning thread unsafe
     Perf::dump();
 }
@@ -863,6 +928,168 @@ void recClear(u32 addr, u32 size)
         ClearRecLUT(PC_GETBLOCK(lowerextent), upperextent - lowerextent);
 }
 
+// --------------------------------------------------------------------------------------
+//  Indirect branch prediction
+// --------------------------------------------------------------------------------------
+// Every block ending on a register jump gets a small inline cache: the last targets seen
+// there are compared inline and jumped to directly, the jumps being linked through
+// recBlocks like static branches. JR ra additionally checks a return stack filled by
+// JAL/JALR ra, which holds the BASEBLOCK of the return address. Everything else falls
+// back to DispatcherReg.
+
+static const int EE_INDIRECT_SLOTS   = 2;
+static const int EE_INDIRECT_SITES   = 16384;
+static const int EE_RETURN_STACK     = 32;            // power of 2
+static const u32 EE_INDIRECT_NOMATCH = 0x7fff0001;    // never a valid pc, and too large for an imm8
+
+struct EEIndirectSite
+{
+    u32  pc;    // address of the jump
+    u32  used;
+    u32 *slot_pc[EE_INDIRECT_SLOTS];
+    s32 *slot_jump[EE_INDIRECT_SLOTS];
+
+    // hit counters, updated by the recompiled code
+    u32 hits;
+    u32 ras_hits;
+    u32 misses;
+};
+
+static EEIndirectSite   s_indirectSites[EE_INDIRECT_SITES];
+static int              s_indirectSiteCount = 0;
+static __aligned16 u32  s_returnPC[EE_RETURN_STACK];
+static __aligned16 uptr s_returnBlock[EE_RETURN_STACK];
+static u32              s_returnTop = 0;
+static std::vector<int> s_indirectFree;    // sites whose code was evicted, slot_pc[0] is NULL
+
+static void recDumpIndirectStats()
+{
+    if (!s_indirectSiteCount)
+        return;
+
+    std::vector<const EEIndirectSite *> sites;
+    u64 hits = 0, ras_hits = 0, misses = 0;
+    for (int i = 0; i < s_indirectSiteCount; i++) {
+        const EEIndirectSite &site = s_indirectSites[i];
+        hits += site.hits;
+        ras_hits += site.ras_hits;
+        misses += site.misses;
+        sites.push_back(&site);
+    }
+
+    const u64 total = hits + ras_hits + misses;
+    if (!total)
+        return;
+
+    DevCon.WriteLn("EE indirect branches: %d sites, %llu jumps, %.1f%% inline, %.1f%% return stack, %.1f%% dispatcher",
+                   s_indirectSiteCount, (unsigned long long)total, hits * 100.0 / total, ras_hits * 100.0 / total,
+                   misses * 100.0 / total);
+
+    std::sort(sites.begin(), sites.end(),
+              [](const EEIndirectSite *a, const EEIndirectSite *b) { return a->misses > b->misses; });
+    for (size_t i = 0; i < std::min<size_t>(sites.size(), 10) && sites[i]->misses; i++) {
+        const EEIndirectSite &site = *sites[i];
+        DevCon.WriteLn("  @0x%08x: %u inline, %u return stack, %u dispatcher", site.pc, site.hits, site.ras_hits,
+                       site.misses);
+    }
+}
+
+static void recResetIndirectSites()
+{
+    s_indirectSiteCount = 0;
+    s_indirectFree.clear();
+    s_returnTop = 0;
+    for (int i = 0; i < EE_RETURN_STACK; i++)
+        s_returnPC[i] = EE_INDIRECT_NOMATCH;
+}
+
+// The code of the sites in [start, end) is about to be reused
+static void recFreeIndirectSites(uptr start, uptr end)
+{
+    for (int i = 0; i < s_indirectSiteCount; i++) {
+        EEIndirectSite &site = s_indirectSites[i];
+        if ((uptr)site.slot_pc[0] >= start && (uptr)site.slot_pc[0] < end) {
+            site.slot_pc[0] = NULL;
+            s_indirectFree.push_back(i);
+        }
+    }
+}
+
+// Called when a register jump missed every prediction, the slots fill up with the first targets seen
+static void __fastcall recIndirectMiss(u32 index)
+{
+    EEIndirectSite &site   = s_indirectSites[index];
+    const u32       target = cpuRegs.pc;
+
+    site.misses++;
+    if (site.used == EE_INDIRECT_SLOTS || !recLUT[target >> 16])
+        return;
+
+    *site.slot_pc[site.used] = target;
+    recBlocks.Link(HWADDR(target), site.slot_jump[site.used]);
+    site.used++;
+}
+
+// Pushes the return address of a JAL/JALR ra, the registers must be flushed.
+void recPushReturnAddress(u32 retpc)
+{
+    if (!recLUT[retpc >> 16])
+        return;
+
+    xMOV(eax, ptr32[&s_returnTop]);
+    xADD(eax, 1);
+    xAND(eax, EE_RETURN_STACK - 1);
+    xMOV(ptr32[&s_returnTop], eax);
+    xMOV(ptr32[xComplexAddress(rdx, s_returnPC, rax * 4)], retpc);
+    xMOV64(rcx, (uptr)PC_GETBLOCK(retpc));
+    xMOV(ptrNative[xComplexAddress(rdx, s_returnBlock, rax * wordsize)], rcx);
+}
+
+// Replaces the jump to DispatcherReg at the end of a block, cpuRegs.pc holds the target.
+static void recIndirectDispatch(bool isReturn)
+{
+    if (s_indirectFree.empty() && s_indirectSiteCount == EE_INDIRECT_SITES) {
+        xJMP((void *)DispatcherReg);
+        return;
+    }
+
+    int index;
+    if (!s_indirectFree.empty()) {
+        index = s_indirectFree.back();
+        s_indirectFree.pop_back();
+    } else
+        index = s_indirectSiteCount++;
+    EEIndirectSite &site = s_indirectSites[index];
+    memzero(site);
+    site.pc = pc - 8;
+
+    xMOV(eax, ptr32[&cpuRegs.pc]);
+
+    if (isReturn) {
+        xMOV(ecx, ptr32[&s_returnTop]);
+        xCMP(eax, ptr32[xComplexAddress(rdx, s_returnPC, rcx * 4)]);
+        xForwardJNE8 mispredict;
+        xMOV(rdx, ptrNative[xComplexAddress(rdx, s_returnBlock, rcx * wordsize)]);
+        xSUB(ecx, 1);
+        xAND(ecx, EE_RETURN_STACK - 1);
+        xMOV(ptr32[&s_returnTop], ecx);
+        xADD(ptr32[&site.ras_hits], 1);
+        xJMP(ptrNative[rdx]);
+        mispredict.SetTarget();
+    }
+
+    for (int i = 0; i < EE_INDIRECT_SLOTS; i++) {
+        xCMP(eax, EE_INDIRECT_NOMATCH);
+        site.slot_pc[i] = (u32 *)xGetPtr() - 1;
+        xForwardJNE8 next;
+        xADD(ptr32[&site.hits], 1);
+        site.slot_jump[i] = xJcc32();
+        next.SetTarget();
+    }
+
+    xFastCall((void *)recIndirectMiss, index);
+    xJMP((void *)DispatcherReg);
+}
 
 static int *s_pCode;
 
@@ -915,7 +1142,7 @@ void SetBranchReg(u32 reg)
 
     iFlushCall(FLUSH_EVERYTHING);
 
-    iBranchTest();
+    iBranchTest(0xffffffff, true, reg == 31);
 }
 
 void SetBranchImm(u32 imm)
@@ -960,6 +1187,13 @@ void iFlushCall(int flushtype)
     _freeX86reg(ecx);
     _freeX86reg(edx);
 
+    // Cached GPRs are in callee-saved registers, the callee only needs cpuRegs to be current.
+    // Nothing survives the end of the block or a call into the interpreter.
+    if (flushtype & FLUSH_FREE_ALLX86)
+        _freeGPRtoX86regs();
+    else if (flushtype & (FLUSH_CACHED_REGS | FLUSH_FREE_XMM | FLUSH_FLUSH_XMM | FLUSH_FLUSH_ALLX86 | FLUSH_FREE_TEMPX86))
+        _flushGPRtoX86regs();
+
     if ((flushtype & FLUSH_PC) && !g_cpuFlushedPC) {
         xMOV(ptr32[&cpuRegs.pc], pc);
         g_cpuFlushedPC = true;
@@ -1080,10 +1314,14 @@ u32 scaleblockcycles_clear()
 //   jump is assumed to be static, in which case the block will be "hardlinked" after
 //   the first time it's dispatched.
 //
+//   predict - Only for register jumps (JR/JALR): the block exits through an inline
+//   prediction site (see recIndirectDispatch) instead of DispatcherReg.  isReturn
+//   checks the return address stack first.
+//
 //   noDispatch - When set true, then jump to Dispatcher.  Used by the recs
 //   for blocks which perform exception checks without branching (it's enabled by
 //   setting "g_branch = 2";
-static void iBranchTest(u32 newpc)
+static void iBranchTest(u32 newpc, bool predict, bool isReturn)
 {
     // Check the Event scheduler if our "cycle target" has been reached.
     // Equiv code to:
@@ -1104,12 +1342,16 @@ static void iBranchTest(u32 newpc)
         xMOV(ptr[&cpuRegs.cycle], eax);    // update cycles
         xSUB(eax, ptr[&g_nextEventCycle]);
 
-        if (newpc == 0xffffffff)
+        if (newpc == 0xffffffff && predict) {
+            xJNS((void *)DispatcherEvent);
+            recIndirectDispatch(isReturn);
+        } else if (newpc == 0xffffffff) {
             xJS(DispatcherReg);
-        else
+            xJMP((void *)DispatcherEvent);
+        } else {
             recBlocks.Link(HWADDR(newpc), xJcc32(Jcc_Signed));
-
-        xJMP((void *)DispatcherEvent);
+            xJMP((void *)DispatcherEvent);
+        }
     }
 }
 
@@ -1362,6 +1604,57 @@ void encodeMemcheck()
     }
 }
 
+// Instructions that only touch GPRs through _eeMoveGPRtoR, _eeMoveRtoGPR and eeSignExtendTo,
+// so they can leave them in x86 registers. Anything else expects cpuRegs to be current.
+static bool recCanCacheGPRtoX86()
+{
+    switch (_Opcode_) {
+        case 0x00:    // SPECIAL
+            switch (_Funct_) {
+                case 0x00:    // SLL
+                case 0x02:    // SRL
+                case 0x03:    // SRA
+                case 0x20:    // ADD
+                case 0x21:    // ADDU
+                case 0x22:    // SUB
+                case 0x23:    // SUBU
+                case 0x24:    // AND
+                case 0x25:    // OR
+                case 0x26:    // XOR
+                case 0x27:    // NOR
+                case 0x2a:    // SLT
+                case 0x2b:    // SLTU
+                case 0x2c:    // DADD
+                case 0x2d:    // DADDU
+                    return true;
+            }
+            return false;
+
+        case 0x08:    // ADDI
+        case 0x09:    // ADDIU
+        case 0x0a:    // SLTI
+        case 0x0b:    // SLTIU
+        case 0x0c:    // ANDI
+        case 0x0d:    // ORI
+        case 0x0e:    // XORI
+        case 0x18:    // DADDI
+        case 0x19:    // DADDIU
+        case 0x20:    // LB
+        case 0x21:    // LH
+        case 0x23:    // LW
+        case 0x24:    // LBU
+        case 0x25:    // LHU
+        case 0x27:    // LWU
+        case 0x37:    // LD
+        case 0x28:    // SB
+        case 0x29:    // SH
+        case 0x2b:    // SW
+        case 0x3f:    // SD
+            return true;
+    }
+    return false;
+}
+
 void recompileNextInstruction(int delayslot)
 {
     u32 i;
@@ -1407,6 +1700,10 @@ void recompileNextInstruction(int delayslot)
 
     const OPCODE &opcode = GetCurrentInstruction();
 
+    g_cacheGPRtoX86 = recCanCacheGPRtoX86();
+    if (!g_cacheGPRtoX86)
+        _freeGPRtoX86regs();
+
     // pxAssert( !(g_pCurInstInfo->info & EEINSTINFO_NOREC) );
     // Console.Warning("opcode name = %s, it's cycles = %d\n",opcode.Name,opcode.cycles);
     //  if this instruction is a jump or a branch, exit right away
@@ -1483,6 +1780,11 @@ void recompileNextInstruction(int delayslot)
     _clearNeededX86regs();
     _clearNeededXMMregs();
 
+    // The branch code around a delay slot doesn't know about cached GPRs
+    g_cacheGPRtoX86 = false;
+    if (delayslot)
+        _freeGPRtoX86regs();
+
     //	_freeXMMregs();
     //	_flushCachedRegs();
     //	g_cpuHasConstReg = 1;
@@ -1632,7 +1934,7 @@ void __fastcall dyna_page_reset(u32 start, u32 sz)
 {
     recClear(start & ~0xfffUL, 0x400);
     manual_counter[start >> 12]++;
-    mmap_MarkCountedRamPage(start);
+    mmap_MarkCountedRamPage(start, sz * 4);
 }
 
 static void memory_protect_recompiled_code(u32 startpc, u32 size)
@@ -1653,7 +1955,7 @@ static void memory_protect_recompiled_code(u32 startpc, u32 size)
 
         case ProtMode_None:
         case ProtMode_Write:
-            mmap_MarkCountedRamPage(inpage_ptr);
+            mmap_MarkCountedRamPage(inpage_ptr, inpage_sz);
             manual_page[inpage_ptr >> 12] = 0;
             break;
 
@@ -1665,6 +1967,33 @@ static void memory_protect_recompiled_code(u32 startpc, u32 size)
             u32 lpc = inpage_ptr;
             u32 stg = inpage_sz;
 
+            if (stg >= 16) {
+                // The code is checked 64 bytes at a time against a copy stored in the block itself
+                const u32 vsz = stg & ~15;
+
+                xForwardJump32 skipcopy;
+                xAlignPtr(16);
+                u8 *copy = xGetPtr();
+                xAdvancePtr(vsz);
+                memcpy(copy, PSM(lpc), vsz);
+                skipcopy.SetTarget();
+
+                for (u32 offs = 0; offs < vsz; offs += 64) {
+                    xMOVDQU(xmm0, ptr[PSM(lpc + offs)]);
+                    xPXOR(xmm0, ptr[copy + offs]);
+                    for (u32 i = offs + 16; i < std::min(offs + 64, vsz); i += 16) {
+                        xMOVDQU(xmm1, ptr[PSM(lpc + i)]);
+                        xPXOR(xmm1, ptr[copy + i]);
+                        xPOR(xmm0, xmm1);
+                    }
+                    xPTEST(xmm0, xmm0);
+                    xJNZ(DispatchBlockDiscard);
+                }
+
+                stg -= vsz;
+                lpc += vsz;
+            }
+
             while (stg > 0) {
                 xCMP(ptr32[PSM(lpc)], *(u32 *)PSM(lpc));
                 xJNE(DispatchBlockDiscard);
@@ -1681,7 +2010,8 @@ static void memory_protect_recompiled_code(u32 startpc, u32 size)
 
             // (ideally, perhaps, manual_counter should be reset to 0 every few minutes?)
 
-            if (!contains_thread_stack && manual_counter[inpage_ptr >> 12] <= 3) {
+            if (!contains_thread_stack && manual_counter[inpage_ptr >> 12] <= 3 &&
+                !mmap_IsMixedRamPage(inpage_ptr)) {
                 // Counted blocks add a weighted (by block size) value into manual_page each time they're
                 // run.  If the block gets run a lot, it resets and re-protects itself in the hope
                 // that whatever forced it to be manually-checked before was a 1-time deal.
@@ -1745,6 +2075,54 @@ bool skipMPEG_By_Pattern(u32 sPC)
     return 0;
 }
 
+// --------------------------------------------------------------------------------------
+//  Generations
+// --------------------------------------------------------------------------------------
+// The code cache and the constant buffer are split in two halves. Blocks are compiled into the young
+// half, and when it fills up only the blocks of the other, older half are dropped before it becomes
+// the young one. The blocks compiled last survive the flush, and an older block that is still hot
+// gets compiled again into the young half the next time it runs. Moving the x86 code over instead
+// isn't possible, it is full of relative calls and jumps.
+
+static u8 *recHalf(int half)
+{
+    const uptr size = ((recMem->GetPtrEnd() - (u8 *)*recMem) / 2) & ~(uptr)(__pagesize - 1);
+    return (u8 *)*recMem + half * size;
+}
+
+static void recFlushGeneration()
+{
+    const int  old      = recYoung ^ 1;
+    const uptr oldStart = (uptr)recHalf(old);
+    const uptr oldEnd   = (uptr)recHalf(old + 1);
+
+    std::vector<BASEBLOCKEX> evicted;
+    recBlocks.Evict(oldStart, oldEnd, evicted);
+    for (const BASEBLOCKEX &block : evicted) {
+        // The BASEBLOCKs inside may have been taken by surviving blocks since
+        BASEBLOCK *pblock = PC_GETBLOCK(block.startpc);
+        for (u32 i = 0; i < std::max<u32>(block.size, 1); i++) {
+            if (pblock[i].GetFnptr() >= oldStart && pblock[i].GetFnptr() < oldEnd)
+                pblock[i].SetFnptr((uptr)JITCompile);
+        }
+        g_eeRecStats.EvictedAge += (u32)g_eeRecStats.BlocksCompiled - block.serial;
+    }
+    recFreeIndirectSites(oldStart, oldEnd);
+
+    if (IsDevBuild)
+        memset((void *)oldStart, 0xcc, oldEnd - oldStart);
+
+    DevCon.WriteLn("EE recompiler: old generation flushed, %zu blocks dropped", evicted.size());
+    g_eeRecStats.CacheFlushes++;
+    g_eeRecStats.BlocksEvicted += evicted.size();
+
+    recOldUsed     = recPtr - recHalf(recYoung);
+    recYoung       = old;
+    recPtr         = recHalf(recYoung);
+    recConstBufPtr = recConstBuf + recYoung * (RECCONSTBUF_SIZE / 2);
+    memzero(recImm64Cache);
+}
+
 static void __fastcall recRecompile(const u32 startpc)
 {
     u32 i           = 0;
@@ -1758,13 +2136,10 @@ static void __fastcall recRecompile(const u32 startpc)
 
     pxAssert(startpc);
 
-    // if recPtr reached the mem limit reset whole mem
-    if (recPtr >= (recMem->GetPtrEnd() - _64kb)) {
-        eeRecNeedsReset = true;
-    } else if ((recConstBufPtr - recConstBuf) >= RECCONSTBUF_SIZE - 64) {
-        Console.WriteLn("EE recompiler stack reset");
-        eeRecNeedsReset = true;
-    }
+    // if the young generation is full, drop the old one and compile there
+    if (!eeRecNeedsReset && (recPtr >= recHalf(recYoung + 1) - _64kb ||
+                             recConstBufPtr >= recConstBuf + (recYoung + 1) * (RECCONSTBUF_SIZE / 2) - 64))
+        recFlushGeneration();
 
     if (eeRecNeedsReset)
         recResetRaw();
@@ -1785,8 +2160,12 @@ static void __fastcall recRecompile(const u32 startpc)
     s_pCurBlockEx = recBlocks.New(HWADDR(startpc), (uptr)recPtr);
 
     pxAssert(s_pCurBlockEx);
+    s_pCurBlockEx->serial = (u32)g_eeRecStats.BlocksCompiled++;
 
     if (HWADDR(startpc) == EELOAD_START) {
+        if (EmuConfig.UseBootSnapshot)
+            xFastCall((void *)eeloadStartHook);
+
         // The EELOAD _start function is the same across all BIOS versions
         u32 mainjump = memRead32(EELOAD_START + 0x9c);
         if (mainjump >> 26 == 3)    // JAL
@@ -1837,6 +2216,8 @@ static void __fastcall recRecompile(const u32 startpc)
     _initX86regs();
     _initXMMregs();
 
+    g_eeProfiledBlock = eeBlockProfiler.Begin(HWADDR(startpc));
+
     if (EmuConfig.Cpu.Recompiler.PreBlockCheckEE) {
         // per-block dump checks, for debugging purposes.
         // [TODO] : These must be enabled from the GUI or INI to be used, otherwise the
@@ -2213,8 +2594,8 @@ StartRecomp:
         }
     }
 
-    pxAssert(xGetPtr() < recMem->GetPtrEnd());
-    pxAssert(recConstBufPtr < recConstBuf + RECCONSTBUF_SIZE);
+    pxAssert(xGetPtr() < recHalf(recYoung + 1));
+    pxAssert(recConstBufPtr <= recConstBuf + (recYoung + 1) * (RECCONSTBUF_SIZE / 2));
 
     pxAssert(xGetPtr() - recPtr < _64kb);
     s_pCurBlockEx->x86size = xGetPtr() - recPtr;
@@ -2226,8 +2607,11 @@ StartRecomp:
 	}
 #endif
     Perf::ee.map(s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc);
+    eeBlockProfiler.End(g_eeProfiledBlock, *s_pCurBlockEx);
+    g_eeProfiledBlock = nullptr;
 
-    recPtr = xGetPtr();
+    recPtr                 = xGetPtr();
+    g_eeRecStats.CacheUsed = recOldUsed + (recPtr - recHalf(recYoung));
 
     pxAssert((g_cpuHasConstReg & g_cpuFlushedConstReg) == g_cpuHasConstReg);
 
@@ -2235,6 +2619,37 @@ StartRecomp:
     s_pCurBlockEx = NULL;
 }
 
+// Number of times a RAM block is interpreted before it gets compiled (DeferEECompile).
+static const u8 EE_DEFERRED_COMPILE_ENTRIES = 2;
+
+// Called by JITCompile for every block that has no code. With DeferEECompile the first few entries
+// of a RAM block are interpreted, so code that only runs once (loaders, decompressors, init) never
+// pays for a compile. Compilation itself stays on the EE thread: the emitter, the register cache
+// and the block tables are shared with the running code, recClear and the page protection.
+static void __fastcall recJITCompile(const u32 startpc)
+{
+    const u32 addr = HWADDR(startpc);
+
+    // Patches, the eeload hooks and the Goemon/MPEG hacks are all keyed on a block being compiled
+    if (!EmuConfig.Cpu.Recompiler.DeferEECompile || !g_GameStarted || addr >= Ps2MemSize::MainRam ||
+        EmuConfig.Gamefixes.GoemonTlbHack || CHECK_SKIPMPEGHACK ||
+        recRAMEntries[addr / 4] >= EE_DEFERRED_COMPILE_ENTRIES) {
+        recRecompile(startpc);
+        return;
+    }
+
+    recRAMEntries[addr / 4]++;
+    intExecuteBlock();
+
+    // taken branches run the event test themselves, ERET and exceptions only schedule one
+    if ((int)(cpuRegs.cycle - g_nextEventCycle) >= 0) {
+        recEventTest();
+    } else if (iopBreakpoint) {
+        iopBreakpoint = false;
+        recExitExecution();
+    }
+}
+
 // The only *safe* way to throw exceptions from the context of recompiled code.
 // The exception is cached and the recompiler is exited safely using either an
 // SEH unwind (MSW) or setjmp/longjmp (GCC).
@@ -66,7 +66,7 @@ void recADD_constv(int info, int creg, u32 vreg)
 
     s32 cval = g_cpuConstRegs[creg].SL[0];
 
-    xMOV(eax, ptr32[&cpuRegs.GPR.r[vreg].SL[0]]);
+    _eeMoveGPRtoR(eax, vreg);
     if (cval)
         xADD(eax, cval);
     eeSignExtendTo(_Rd_, _Rd_ == vreg && !cval);
@@ -89,11 +89,13 @@ void recADD_(int info)
 {
     pxAssert(!(info & PROCESS_EE_XMM));
 
-    xMOV(eax, ptr32[&cpuRegs.GPR.r[_Rs_].SL[0]]);
-    if (_Rs_ == _Rt_)
+    _eeMoveGPRtoR(eax, _Rs_);
+    if (_Rs_ == _Rt_) {
         xADD(eax, eax);
-    else
-        xADD(eax, ptr32[&cpuRegs.GPR.r[_Rt_].SL[0]]);
+    } else {
+        _eeMoveGPRtoR(ecx, _Rt_);
+        xADD(eax, ecx);
+    }
     eeSignExtendTo(_Rd_);
 }
 
@@ -118,19 +120,13 @@ void recDADD_constv(int info, int creg, u32 vreg)
     GPR_reg64 cval = g_cpuConstRegs[creg];
 
 #ifdef __M_X86_64
-    if (_Rd_ == vreg) {
-        if (!cval.SD[0])
-            return;    // no-op
-        xImm64Op(xADD, ptr64[&cpuRegs.GPR.r[_Rd_].SD[0]], rax, cval.SD[0]);
-    } else {
-        if (cval.SD[0]) {
-            xMOV64(rax, cval.SD[0]);
-            xADD(rax, ptr64[&cpuRegs.GPR.r[vreg].SD[0]]);
-        } else {
-            xMOV(rax, ptr64[&cpuRegs.GPR.r[vreg].SD[0]]);
-        }
-        xMOV(ptr64[&cpuRegs.GPR.r[_Rd_].SD[0]], rax);
-    }
+    if (_Rd_ == vreg && !cval.SD[0])
+        return;    // no-op
+
+    _eeMoveGPRtoR(rax, vreg);
+    if (cval.SD[0])
+        xImm64Op(xADD, rax, rdx, cval.SD[0]);
+    _eeMoveRtoGPR(_Rd_, rax);
 #else
     if (_Rd_ == vreg) {
         if (!cval.SD[0])
@@ -169,23 +165,14 @@ void recDADD_(int info)
         rs = _Rt_, rt = _Rs_;
 
 #ifdef __M_X86_64
-    if (_Rd_ == _Rs_ && _Rs_ == _Rt_) {
-        xSHL(ptr64[&cpuRegs.GPR.r[_Rd_].SD[0]], 1);
-        return;
-    }
-
-    xMOV(rax, ptr64[&cpuRegs.GPR.r[rt].SD[0]]);
-
-    if (_Rd_ == rs) {
-        xADD(ptr64[&cpuRegs.GPR.r[_Rd_].SD[0]], rax);
-        return;
-    } else if (rs == rt) {
+    _eeMoveGPRtoR(rax, rt);
+    if (rs == rt) {
         xADD(rax, rax);
     } else {
-        xADD(rax, ptr32[&cpuRegs.GPR.r[rs].SD[0]]);
+        _eeMoveGPRtoR(rcx, rs);
+        xADD(rax, rcx);
     }
-
-    xMOV(ptr64[&cpuRegs.GPR.r[_Rd_].SD[0]], rax);
+    _eeMoveRtoGPR(_Rd_, rax);
 #else
     xMOV(eax, ptr32[&cpuRegs.GPR.r[rt].SL[0]]);
 
@@ -235,8 +222,9 @@ void recSUB_consts(int info)
 
     s32 sval = g_cpuConstRegs[_Rs_].SL[0];
 
+    _eeMoveGPRtoR(ecx, _Rt_);
     xMOV(eax, sval);
-    xSUB(eax, ptr32[&cpuRegs.GPR.r[_Rt_].SL[0]]);
+    xSUB(eax, ecx);
     eeSignExtendTo(_Rd_);
 }
 
@@ -246,7 +234,7 @@ void recSUB_constt(int info)
 
     s32 tval = g_cpuConstRegs[_Rt_].SL[0];
 
-    xMOV(eax, ptr32[&cpuRegs.GPR.r[_Rs_].SL[0]]);
+    _eeMoveGPRtoR(eax, _Rs_);
     if (tval)
         xSUB(eax, tval);
     eeSignExtendTo(_Rd_, _Rd_ == _Rs_ && !tval);
@@ -257,17 +245,14 @@ void recSUB_(int info)
     pxAssert(!(info & PROCESS_EE_XMM));
 
     if (_Rs_ == _Rt_) {
-#ifdef __M_X86_64
-        xMOV(ptr64[&cpuRegs.GPR.r[_Rd_].SD[0]], 0);
-#else
-        xMOV(ptr32[&cpuRegs.GPR.r[_Rd_].SL[0]], 0);
-        xMOV(ptr32[&cpuRegs.GPR.r[_Rd_].SL[1]], 0);
-#endif
+        xXOR(eax, eax);
+        eeSignExtendTo(_Rd_);
         return;
     }
 
-    xMOV(eax, ptr32[&cpuRegs.GPR.r[_Rs_].SL[0]]);
-    xSUB(eax, ptr32[&cpuRegs.GPR.r[_Rt_].SL[0]]);
+    _eeMoveGPRtoR(eax, _Rs_);
+    _eeMoveGPRtoR(ecx, _Rt_);
+    xSUB(eax, ecx);
     eeSignExtendTo(_Rd_);
 }
 
@@ -450,23 +435,17 @@ static void recLogicalOp_constv(LogicalOp op, int info, int creg, u32 vreg)
     GPR_reg64 cval = g_cpuConstRegs[creg];
 #ifdef __M_X86_64
     if (hasFixed && cval.SD[0] == fixedInput) {
-        xMOV(ptr64[&cpuRegs.GPR.r[_Rd_].UD[0]], fixedOutput);
-    } else if (_Rd_ == vreg) {
-        if (cval.SD[0] != identityInput)
-            xImm64Op(xOP, ptr64[&cpuRegs.GPR.r[_Rd_].UD[0]], rax, cval.UD[0]);
-        if (op == LogicalOp::NOR)
-            xNOT(ptr64[&cpuRegs.GPR.r[_Rd_].UD[0]]);
+        xMOV64(rax, fixedOutput);
     } else {
-        if (cval.SD[0] != identityInput) {
-            xMOV64(rax, cval.SD[0]);
-            xOP(rax, ptr32[&cpuRegs.GPR.r[vreg].UD[0]]);
-        } else {
-            xMOV(rax, ptr32[&cpuRegs.GPR.r[vreg].UD[0]]);
-        }
+        if (_Rd_ == vreg && cval.SD[0] == identityInput && op != LogicalOp::NOR)
+            return;    // no-op
+        _eeMoveGPRtoR(rax, vreg);
+        if (cval.SD[0] != identityInput)
+            xImm64Op(xOP, rax, rdx, cval.UD[0]);
         if (op == LogicalOp::NOR)
             xNOT(rax);
-        xMOV(ptr64[&cpuRegs.GPR.r[_Rd_].UD[0]], rax);
     }
+    _eeMoveRtoGPR(_Rd_, rax);
 #else
     for (int i = 0; i < 2; i++) {
         if (hasFixed && cval.SL[i] == (s32)fixedInput) {
@@ -506,22 +485,19 @@ static void recLogicalOp(LogicalOp op, int info)
 
 #ifdef __M_X86_64
     if (op == LogicalOp::XOR && rs == rt) {
-        xMOV(ptr64[&cpuRegs.GPR.r[_Rd_].UD[0]], 0);
-    } else if (_Rd_ == rs) {
+        xXOR(eax, eax);
+    } else {
+        if (_Rd_ == rs && rs == rt && op != LogicalOp::NOR)
+            return;    // no-op
+        _eeMoveGPRtoR(rax, rs);
         if (rs != rt) {
-            xMOV(rax, ptr64[&cpuRegs.GPR.r[rt].UD[0]]);
-            xOP(ptr64[&cpuRegs.GPR.r[_Rd_].UD[0]], rax);
+            _eeMoveGPRtoR(rcx, rt);
+            xOP(rax, rcx);
         }
-        if (op == LogicalOp::NOR)
-            xNOT(ptr64[&cpuRegs.GPR.r[_Rd_].UD[0]]);
-    } else {
-        xMOV(rax, ptr64[&cpuRegs.GPR.r[rs].UD[0]]);
-        if (rs != rt)
-            xOP(rax, ptr64[&cpuRegs.GPR.r[rt].UD[0]]);
         if (op == LogicalOp::NOR)
             xNOT(rax);
-        xMOV(ptr64[&cpuRegs.GPR.r[_Rd_].UD[0]], rax);
     }
+    _eeMoveRtoGPR(_Rd_, rax);
 #else
     for (int i = 0; i < 2; i++) {
         if (op == LogicalOp::XOR && rs == rt) {
@@ -652,10 +628,11 @@ void recSLTs_const(int info, int sign, int st)
 #ifdef __M_X86_64
     const xImpl_Set &SET  = st ? (sign ? xSETL : xSETB) : (sign ? xSETG : xSETA);
 
+    _eeMoveGPRtoR(rcx, st ? _Rs_ : _Rt_);
     xXOR(eax, eax);
-    xImm64Op(xCMP, ptr64[&cpuRegs.GPR.r[st ? _Rs_ : _Rt_].UD[0]], rdx, cval.UD[0]);
+    xImm64Op(xCMP, rcx, rdx, cval.UD[0]);
     SET(al);
-    xMOV(ptr64[&cpuRegs.GPR.r[_Rd_].UD[0]], rax);
+    _eeMoveRtoGPR(_Rd_, rax);
 #else
     xMOV(eax, 1);
 
@@ -683,11 +660,12 @@ void recSLTs_(int info, int sign)
 #ifdef __M_X86_64
     const xImpl_Set &SET = sign ? xSETL : xSETB;
 
+    _eeMoveGPRtoR(rdx, _Rs_);
+    _eeMoveGPRtoR(rcx, _Rt_);
     xXOR(eax, eax);
-    xMOV(rdx, ptr64[&cpuRegs.GPR.r[_Rs_].UD[0]]);
-    xCMP(rdx, ptr64[&cpuRegs.GPR.r[_Rt_].UD[0]]);
+    xCMP(rdx, rcx);
     SET(al);
-    xMOV(ptr64[&cpuRegs.GPR.r[_Rd_].UD[0]], rax);
+    _eeMoveRtoGPR(_Rd_, rax);
 #else
     xMOV(eax, 1);
 
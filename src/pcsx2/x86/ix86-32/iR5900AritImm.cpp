@@ -58,18 +58,12 @@ void recADDI_(int info)
 {
     pxAssert(!(info & PROCESS_EE_XMM));
 
-    if (_Rt_ == _Rs_) {
-        // must perform the ADD unconditionally, to maintain flags status:
-        xADD(ptr32[&cpuRegs.GPR.r[_Rt_].UL[0]], _Imm_);
-        _signExtendSFtoM((uptr)&cpuRegs.GPR.r[_Rt_].UL[1]);
-    } else {
-        xMOV(eax, ptr[&cpuRegs.GPR.r[_Rs_].UL[0]]);
+    _eeMoveGPRtoR(eax, _Rs_);
 
-        if (_Imm_ != 0)
-            xADD(eax, _Imm_);
+    if (_Imm_ != 0)
+        xADD(eax, _Imm_);
 
-        eeSignExtendTo(_Rt_);
-    }
+    eeSignExtendTo(_Rt_, _Rt_ == _Rs_ && _Imm_ == 0);
 }
 
 EERECOMPILE_CODEX(eeRecompileCode1, ADDI);
@@ -91,17 +85,16 @@ void recDADDI_(int info)
     pxAssert(!(info & PROCESS_EE_XMM));
 
 #ifdef __M_X86_64
-    if (_Rt_ == _Rs_) {
-        xADD(ptr64[&cpuRegs.GPR.r[_Rt_].UD[0]], _Imm_);
-    } else {
-        xMOV(rax, ptr[&cpuRegs.GPR.r[_Rs_].UD[0]]);
+    if (_Rt_ == _Rs_ && _Imm_ == 0)
+        return;    // no-op
 
-        if (_Imm_ != 0) {
-            xADD(rax, _Imm_);
-        }
+    _eeMoveGPRtoR(rax, _Rs_);
 
-        xMOV(ptr[&cpuRegs.GPR.r[_Rt_].UD[0]], rax);
+    if (_Imm_ != 0) {
+        xADD(rax, _Imm_);
     }
+
+    _eeMoveRtoGPR(_Rt_, rax);
 #else
     if (_Rt_ == _Rs_) {
         xADD(ptr32[&cpuRegs.GPR.r[_Rt_].UL[0]], _Imm_);
@@ -143,10 +136,11 @@ extern u32  s_sltone;
 void recSLTIU_(int info)
 {
 #ifdef __M_X86_64
+    _eeMoveGPRtoR(rcx, _Rs_);
     xXOR(eax, eax);
-    xCMP(ptr64[&cpuRegs.GPR.r[_Rs_].UD[0]], _Imm_);
+    xCMP(rcx, _Imm_);
     xSETB(al);
-    xMOV(ptr64[&cpuRegs.GPR.r[_Rt_].UD[0]], rax);
+    _eeMoveRtoGPR(_Rt_, rax);
 #else
     xMOV(eax, 1);
 
@@ -180,10 +174,11 @@ void recSLTI_(int info)
 {
     // test silent hill if modding
 #ifdef __M_X86_64
+    _eeMoveGPRtoR(rcx, _Rs_);
     xXOR(eax, eax);
-    xCMP(ptr64[&cpuRegs.GPR.r[_Rs_].UD[0]], _Imm_);
+    xCMP(rcx, _Imm_);
     xSETL(al);
-    xMOV(ptr64[&cpuRegs.GPR.r[_Rt_].UD[0]], rax);
+    _eeMoveRtoGPR(_Rt_, rax);
 #else
     xMOV(eax, 1);
 
@@ -232,27 +227,16 @@ static void recLogicalOpI(int info, LogicalOp op)
     pxAssert(&xOP != &bad);
 
 #ifdef __M_X86_64
-    if (_ImmU_ != 0) {
-        if (_Rt_ == _Rs_) {
-            if (op == LogicalOp::AND)
-                xOP(ptr64[&cpuRegs.GPR.r[_Rt_].UD[0]], _ImmU_);
-            else
-                xOP(ptr32[&cpuRegs.GPR.r[_Rt_].UL[0]], _ImmU_);
-        } else {
-            xMOV(rax, ptr[&cpuRegs.GPR.r[_Rs_].UD[0]]);
-            xOP(rax, _ImmU_);
-            xMOV(ptr[&cpuRegs.GPR.r[_Rt_].UD[0]], rax);
-        }
+    if (_ImmU_ == 0 && op == LogicalOp::AND) {
+        xXOR(eax, eax);
     } else {
-        if (op == LogicalOp::AND) {
-            xMOV(ptr64[&cpuRegs.GPR.r[_Rt_].UD[0]], 0);
-        } else {
-            if (_Rt_ != _Rs_) {
-                xMOV(rax, ptr[&cpuRegs.GPR.r[_Rs_].UD[0]]);
-                xMOV(ptr[&cpuRegs.GPR.r[_Rt_].UD[0]], rax);
-            }
-        }
+        if (_ImmU_ == 0 && _Rt_ == _Rs_)
+            return;    // no-op
+        _eeMoveGPRtoR(rax, _Rs_);
+        if (_ImmU_ != 0)
+            xOP(rax, _ImmU_);
     }
+    _eeMoveRtoGPR(_Rt_, rax);
 #else
     if (_ImmU_ != 0) {
         if (_Rt_ == _Rs_) {
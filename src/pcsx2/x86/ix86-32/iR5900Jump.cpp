@@ -74,6 +74,8 @@ void recJAL()
     }
 
     recompileNextInstruction(1);
+    iFlushCall(FLUSH_EVERYTHING);
+    recPushReturnAddress(pc);
     if (EmuConfig.Gamefixes.GoemonTlbHack)
         SetBranchImm(vtlb_V2P(newpc));
     else
@@ -150,6 +152,11 @@ void recJALR()
         xMOV(ptr[&cpuRegs.pc], eax);
     }
 
+    if (_Rd_ == 31) {
+        iFlushCall(FLUSH_EVERYTHING);
+        recPushReturnAddress(pc);
+    }
+
     SetBranchReg(0xffffffff);
 }
 
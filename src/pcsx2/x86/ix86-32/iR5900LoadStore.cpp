@@ -172,7 +172,7 @@ void recLoad32(u32 bits, bool sign)
         if (sign)
             xCDQE();
 
-        xMOV(ptr64[&cpuRegs.GPR.r[_Rt_].UD[0]], rax);
+        _eeMoveRtoGPR(_Rt_, rax);
 #else
         // EAX holds the loaded value, so sign extend as needed:
         if (sign)
@@ -959,18 +959,7 @@ void recLQC2()
     xADD(eax, scaleblockcycles_clear());
     xMOV(ptr32[&cpuRegs.cycle], eax);    // update cycles
 
-    xTEST(ptr32[&VU0.VI[REG_VPU_STAT].UL], 0x1);
-    xForwardJZ32 skipvuidle;
-    xSUB(eax, ptr32[&VU0.cycle]);
-    xSUB(eax, ptr32[&VU0.nextBlockCycles]);
-    xCMP(eax, EmuConfig.Gamefixes.VUKickstartHack ? 4 : 0);
-    xForwardJL32 skip;
-    _cop2BackupRegs();
-    xLoadFarAddr(arg1reg, CpuVU0);
-    xFastCall((void *)BaseVUmicroCPU::ExecuteBlockJIT, arg1reg);
-    _cop2RestoreRegs();
-    skip.SetTarget();
-    skipvuidle.SetTarget();
+    COP2_SyncVU0(4);
 
     int gpr;
 
@@ -1005,18 +994,7 @@ void recSQC2()
     xADD(eax, scaleblockcycles_clear());
     xMOV(ptr32[&cpuRegs.cycle], eax);    // update cycles
 
-    xTEST(ptr32[&VU0.VI[REG_VPU_STAT].UL], 0x1);
-    xForwardJZ32 skipvuidle;
-    xSUB(eax, ptr32[&VU0.cycle]);
-    xSUB(eax, ptr32[&VU0.nextBlockCycles]);
-    xCMP(eax, EmuConfig.Gamefixes.VUKickstartHack ? 4 : 0);
-    xForwardJL32 skip;
-    _cop2BackupRegs();
-    xLoadFarAddr(arg1reg, CpuVU0);
-    xFastCall((void *)BaseVUmicroCPU::ExecuteBlockJIT, arg1reg);
-    _cop2RestoreRegs();
-    skip.SetTarget();
-    skipvuidle.SetTarget();
+    COP2_SyncVU0(4);
 
     xLEA(arg2reg, ptr[&VU0.VF[_Ft_].UD[0]]);
 
@@ -63,7 +63,7 @@ void recSLLs_(int info, int sa)
 {
     pxAssert(!(info & PROCESS_EE_XMM));
 
-    xMOV(eax, ptr[&cpuRegs.GPR.r[_Rt_].UL[0]]);
+    _eeMoveGPRtoR(eax, _Rt_);
     if (sa != 0) {
         xSHL(eax, sa);
     }
@@ -88,7 +88,7 @@ void recSRLs_(int info, int sa)
 {
     pxAssert(!(info & PROCESS_EE_XMM));
 
-    xMOV(eax, ptr[&cpuRegs.GPR.r[_Rt_].UL[0]]);
+    _eeMoveGPRtoR(eax, _Rt_);
     if (sa != 0)
         xSHR(eax, sa);
 
@@ -112,7 +112,7 @@ void recSRAs_(int info, int sa)
 {
     pxAssert(!(info & PROCESS_EE_XMM));
 
-    xMOV(eax, ptr[&cpuRegs.GPR.r[_Rt_].UL[0]]);
+    _eeMoveGPRtoR(eax, _Rt_);
     if (sa != 0)
         xSAR(eax, sa);
 
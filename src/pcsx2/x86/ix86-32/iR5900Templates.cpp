@@ -46,6 +46,7 @@ void _deleteEEreg(int reg, int flush)
         _flushConstReg(reg);
     }
     GPR_DEL_CONST(reg);
+    _deleteX86reg(X86TYPE_GPR, reg, flush ? 0 : 2);
     _deleteGPRtoXMMreg(reg, flush ? 0 : 2);
 }
 
@@ -57,6 +58,7 @@ void _flushEEreg(int reg, bool clear)
         _flushConstReg(reg);
         return;
     }
+    _deleteX86reg(X86TYPE_GPR, reg, clear ? 0 : 1);
     _deleteGPRtoXMMreg(reg, clear ? 2 : 1);
 }
 
@@ -85,6 +87,7 @@ void eeRecompileCode0(R5900FNPTR constcode, R5900FNPTR_INFO constscode, R5900FNP
 
     if (GPR_IS_CONST2(_Rs_, _Rt_)) {
         if (xmminfo & XMMINFO_WRITED) {
+            _deleteX86reg(X86TYPE_GPR, _Rd_, 2);
             _deleteGPRtoXMMreg(_Rd_, 2);
         }
         if (xmminfo & XMMINFO_WRITED)
@@ -289,6 +292,7 @@ void eeRecompileCode1(R5900FNPTR constcode, R5900FNPTR_INFO noconstcode)
         return;
 
     if (GPR_IS_CONST1(_Rs_)) {
+        _deleteX86reg(X86TYPE_GPR, _Rt_, 2);
         _deleteGPRtoXMMreg(_Rt_, 2);
         GPR_SET_CONST(_Rt_);
         constcode();
@@ -346,6 +350,7 @@ void eeRecompileCode2(R5900FNPTR constcode, R5900FNPTR_INFO noconstcode)
         return;
 
     if (GPR_IS_CONST1(_Rt_)) {
+        _deleteX86reg(X86TYPE_GPR, _Rd_, 2);
         _deleteGPRtoXMMreg(_Rd_, 2);
         GPR_SET_CONST(_Rd_);
         constcode();
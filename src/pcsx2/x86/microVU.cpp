@@ -83,7 +83,7 @@ void mVUinit(microVU &mVU, uint vuIndex)
 void mVUreset(microVU &mVU, bool resetReserve)
 {
 
-    if (THREAD_VU1) {
+    if (mVU.index && THREAD_VU1) {
         DevCon.Warning("mVU Reset");
         // If MTVU is toggled on during gameplay we need to flush the running VU1 program, else it gets in a mess
         if (VU0.VI[REG_VPU_STAT].UL & 0x100) {
@@ -120,6 +120,11 @@ void mVUreset(microVU &mVU, bool resetReserve)
     mVU.prog.x86ptr   = z;
     mVU.prog.x86end   = z + ((mVU.cacheSize - mVUcacheSafeZone) * _1mb);
 
+    RecompilerStats &stats = g_vuRecStats[mVU.index];
+    stats.CacheResets++;
+    stats.CacheUsed = 0;
+    stats.CacheSize = mVU.prog.x86end - mVU.prog.x86start;
+
     for (u32 i = 0; i < (mVU.progSize / 2); i++) {
         if (!mVU.prog.prog[i]) {
             mVU.prog.prog[i] = new std::deque<microProgram *>();
@@ -137,9 +142,9 @@ void mVUreset(microVU &mVU, bool resetReserve)
     HostSys::MemProtect(mVU.dispCache, mVUdispCacheSize, PageAccess_ExecOnly());
 
     if (mVU.index)
-        Perf::any.map((uptr)&mVU.dispCache, mVUdispCacheSize, "mVU1 Dispatcher");
+        Perf::any.map((uptr)mVU.dispCache, mVUdispCacheSize, "mVU1 Dispatcher");
     else
-        Perf::any.map((uptr)&mVU.dispCache, mVUdispCacheSize, "mVU0 Dispatcher");
+        Perf::any.map((uptr)mVU.dispCache, mVUdispCacheSize, "mVU0 Dispatcher");
 }
 
 // Free Allocated Resources
@@ -365,8 +370,10 @@ void recMicroVU1::Vsync() noexcept
 
 void recMicroVU0::Reserve()
 {
-    if (m_Reserved.exchange(1) == 0)
+    if (m_Reserved.exchange(1) == 0) {
         mVUinit(microVU0, 0);
+        vu0Thread.Start();
+    }
 }
 void recMicroVU1::Reserve()
 {
@@ -378,8 +385,10 @@ void recMicroVU1::Reserve()
 
 void recMicroVU0::Shutdown() noexcept
 {
-    if (m_Reserved.exchange(0) == 1)
+    if (m_Reserved.exchange(0) == 1) {
+        vu0Thread.WaitVU();
         mVUclose(microVU0);
+    }
 }
 void recMicroVU1::Shutdown() noexcept
 {
@@ -393,6 +402,8 @@ void recMicroVU0::Reset()
 {
     if (!pxAssertDev(m_Reserved, "MicroVU0 CPU Provider has not been reserved prior to reset!"))
         return;
+    vu0Thread.WaitVU();
+    vu0Thread.Get_MTVUChanges();
     mVUreset(microVU0, true);
 }
 void recMicroVU1::Reset()
@@ -424,7 +435,7 @@ void recMicroVU0::Execute(u32 cycles)
     // Edit: Need to test this again, if anyone ever has a "Woody" game :p
     ((mVUrecCall)microVU0.startFunct)(VU0.VI[REG_TPC].UL, cycles);
     VU0.VI[REG_TPC].UL >>= 3;
-    if (microVU0.regs().flags & 0x4) {
+    if (microVU0.regs().flags & 0x4 && !THREAD_VU0) {
         microVU0.regs().flags &= ~0x4;
         hwIntcIrq(6);
     }
@@ -498,8 +509,10 @@ void recMicroVU1::ResumeXGkick()
 
 void SaveStateBase::vuJITFreeze()
 {
-    if (IsSaving())
+    if (IsSaving()) {
+        vu0Thread.WaitVU();
         vu1Thread.WaitVU();
+    }
 
     Freeze(microVU0.prog.lpState);
     Freeze(microVU1.prog.lpState);
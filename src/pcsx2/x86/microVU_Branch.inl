@@ -130,12 +130,12 @@ void mVUDTendProgram(mV, microFlagCycles* mFC, int isEbit)
 
 	if (isEbit) // Clear 'is busy' Flags
 	{
-		if (!mVU.index || !THREAD_VU1)
+		if (!isVUThread)
 		{
 			xAND(ptr32[&VU0.VI[REG_VPU_STAT].UL], (isVU1 ? ~0x100 : ~0x001)); // VBS0/VBS1 flag
 		}
 		else
-			xFastCall((void*)mVUTBit);
+			xFastCall((void*)(isVU1 ? mVUTBit<1> : mVUTBit<0>));
 	}
 
 	if (isEbit != 2) // Save PC, and Jump to Exit Point
@@ -249,12 +249,12 @@ void mVUendProgram(mV, microFlagCycles* mFC, int isEbit)
 	if ((isEbit && isEbit != 3)) // Clear 'is busy' Flags
 	{
 		xMOV(ptr32[&mVU.regs().nextBlockCycles], 0);
-		if (!mVU.index || !THREAD_VU1)
+		if (!isVUThread)
 		{
 			xAND(ptr32[&VU0.VI[REG_VPU_STAT].UL], (isVU1 ? ~0x100 : ~0x001)); // VBS0/VBS1 flag
 		}
 		else
-			xFastCall((void*)mVUEBit);
+			xFastCall((void*)(isVU1 ? mVUEBit<1> : mVUEBit<0>));
 	}
 	else if(isEbit)
 	{
@@ -339,7 +339,7 @@ void normBranch(mV, microFlagCycles& mFC)
 		u32 tempPC = iPC;
 		xTEST(ptr32[&VU0.VI[REG_FBRST].UL], (isVU1 ? 0x400 : 0x4));
 		xForwardJump32 eJMP(Jcc_Zero);
-		if (!mVU.index || !THREAD_VU1)
+		if (!isVUThread)
 		{
 			xOR(ptr32[&VU0.VI[REG_VPU_STAT].UL], (isVU1 ? 0x200 : 0x2));
 			xOR(ptr32[&mVU.regs().flags], VUFLAG_INTCINTERRUPT);
@@ -354,7 +354,7 @@ void normBranch(mV, microFlagCycles& mFC)
 		u32 tempPC = iPC;
 		xTEST(ptr32[&VU0.VI[REG_FBRST].UL], (isVU1 ? 0x800 : 0x8));
 		xForwardJump32 eJMP(Jcc_Zero);
-		if (!mVU.index || !THREAD_VU1)
+		if (!isVUThread)
 		{
 			xOR(ptr32[&VU0.VI[REG_VPU_STAT].UL], (isVU1 ? 0x400 : 0x4));
 			xOR(ptr32[&mVU.regs().flags], VUFLAG_INTCINTERRUPT);
@@ -460,7 +460,7 @@ void condBranch(mV, microFlagCycles& mFC, int JMPcc)
 		u32 tempPC = iPC;
 		xTEST(ptr32[&VU0.VI[REG_FBRST].UL], (isVU1 ? 0x800 : 0x8));
 		xForwardJump32 eJMP(Jcc_Zero);
-		if (!mVU.index || !THREAD_VU1)
+		if (!isVUThread)
 		{
 			xOR(ptr32[&VU0.VI[REG_VPU_STAT].UL], (isVU1 ? 0x400 : 0x4));
 			xOR(ptr32[&mVU.regs().flags], VUFLAG_INTCINTERRUPT);
@@ -484,7 +484,7 @@ void condBranch(mV, microFlagCycles& mFC, int JMPcc)
 		u32 tempPC = iPC;
 		xTEST(ptr32[&VU0.VI[REG_FBRST].UL], (isVU1 ? 0x400 : 0x4));
 		xForwardJump32 eJMP(Jcc_Zero);
-		if (!mVU.index || !THREAD_VU1)
+		if (!isVUThread)
 		{
 			xOR(ptr32[&VU0.VI[REG_VPU_STAT].UL], (isVU1 ? 0x200 : 0x2));
 			xOR(ptr32[&mVU.regs().flags], VUFLAG_INTCINTERRUPT);
@@ -627,7 +627,7 @@ void normJump(mV, microFlagCycles& mFC)
 	{
 		xTEST(ptr32[&VU0.VI[REG_FBRST].UL], (isVU1 ? 0x400 : 0x4));
 		xForwardJump32 eJMP(Jcc_Zero);
-		if (!mVU.index || !THREAD_VU1)
+		if (!isVUThread)
 		{
 			xOR(ptr32[&VU0.VI[REG_VPU_STAT].UL], (isVU1 ? 0x200 : 0x2));
 			xOR(ptr32[&mVU.regs().flags], VUFLAG_INTCINTERRUPT);
@@ -642,7 +642,7 @@ void normJump(mV, microFlagCycles& mFC)
 	{
 		xTEST(ptr32[&VU0.VI[REG_FBRST].UL], (isVU1 ? 0x800 : 0x8));
 		xForwardJump32 eJMP(Jcc_Zero);
-		if (!mVU.index || !THREAD_VU1)
+		if (!isVUThread)
 		{
 			xOR(ptr32[&VU0.VI[REG_VPU_STAT].UL], (isVU1 ? 0x400 : 0x4));
 			xOR(ptr32[&mVU.regs().flags], VUFLAG_INTCINTERRUPT);
@@ -161,10 +161,12 @@ _mVUt void mVUcleanUp()
 		mVUreset(mVU, false);
 	}
 
+	g_vuRecStats[mVU.index].CacheUsed = mVU.prog.x86ptr - mVU.prog.x86start;
+
 	mVU.cycles = mVU.totalCycles - mVU.cycles;
 	mVU.regs().cycle += mVU.cycles;
 
-	if (!vuIndex || !THREAD_VU1)
+	if (vuIndex ? !THREAD_VU1 : !THREAD_VU0)
 	{
 		u32 cycles_passed = std::min(mVU.cycles, 3000u) * EmuConfig.Speedhacks.EECycleSkip;
 		if (cycles_passed > 0)
@@ -176,7 +178,7 @@ _mVUt void mVUcleanUp()
 			// So we need to adjust when VU1 skips cycles also
 			if (!vuIndex)
 				VU0.cycle = cpuRegs.cycle + vu0_offset;
-			else
+			else if (!THREAD_VU0) // The VU0 thread keeps its own count
 				VU0.cycle += cycles_passed;
 		}
 	}
@@ -31,6 +31,10 @@ using namespace R5900::Dynarec;
 
 void setupMacroOp(int mode, const char* opName)
 {
+	// microVU0's compile state is shared with the VU0 thread
+	if (THREAD_VU0)
+		vu0Thread.WaitVU();
+
 	// Set up reg allocation
 	microVU0.regAlloc->reset(true);
 
@@ -311,6 +315,33 @@ void recBC2TL() { _setupBranchTest(JZ32,  true);  }
 // Macro VU - COP2 Transfer Instructions
 //------------------------------------------------------------------
 
+// Lets a running VU0 micro program catch up with the EE before COP2 touches VU0, eax holds
+// cpuRegs.cycle. The VU0 thread owns VU0 until it's paused, so it's synced whatever the cycles.
+void COP2_SyncVU0(int kickstartCycles)
+{
+	xTEST(ptr32[&VU0.VI[REG_VPU_STAT].UL], 0x1);
+	xForwardJZ32 skipvuidle;
+	if (THREAD_VU0)
+	{
+		_cop2BackupRegs();
+		xFastCall((void*)vu0Sync);
+		_cop2RestoreRegs();
+	}
+	else
+	{
+		xSUB(eax, ptr32[&VU0.cycle]);
+		xSUB(eax, ptr32[&VU0.nextBlockCycles]);
+		xCMP(eax, EmuConfig.Gamefixes.VUKickstartHack ? kickstartCycles : 0);
+		xForwardJL32 skip;
+		_cop2BackupRegs();
+		xLoadFarAddr(arg1reg, CpuVU0);
+		xFastCall((void*)BaseVUmicroCPU::ExecuteBlockJIT, arg1reg);
+		_cop2RestoreRegs();
+		skip.SetTarget();
+	}
+	skipvuidle.SetTarget();
+}
+
 void COP2_Interlock(bool mBitSync)
 {
 
@@ -368,18 +399,7 @@ static void recCFC2()
 		xADD(eax, scaleblockcycles_clear());
 		xMOV(ptr32[&cpuRegs.cycle], eax); // update cycles
 
-		xTEST(ptr32[&VU0.VI[REG_VPU_STAT].UL], 0x1);
-		xForwardJZ32 skipvuidle;
-		xSUB(eax, ptr32[&VU0.cycle]);
-		xSUB(eax, ptr32[&VU0.nextBlockCycles]);
-		xCMP(eax, EmuConfig.Gamefixes.VUKickstartHack ? 8 : 0);
-		xForwardJL32 skip;
-		_cop2BackupRegs();
-		xLoadFarAddr(arg1reg, CpuVU0);
-		xFastCall((void*)BaseVUmicroCPU::ExecuteBlockJIT, arg1reg);
-		_cop2RestoreRegs();
-		skip.SetTarget();
-		skipvuidle.SetTarget();
+		COP2_SyncVU0(8);
 	}
 
 	_flushEEreg(_Rt_, true);
@@ -430,18 +450,7 @@ static void recCTC2()
 		xADD(eax, scaleblockcycles_clear());
 		xMOV(ptr32[&cpuRegs.cycle], eax); // update cycles
 
-		xTEST(ptr32[&VU0.VI[REG_VPU_STAT].UL], 0x1);
-		xForwardJZ32 skipvuidle;
-		xSUB(eax, ptr32[&VU0.cycle]);
-		xSUB(eax, ptr32[&VU0.nextBlockCycles]);
-		xCMP(eax, EmuConfig.Gamefixes.VUKickstartHack ? 8 : 0);
-		xForwardJL32 skip;
-		_cop2BackupRegs();
-		xLoadFarAddr(arg1reg, CpuVU0);
-		xFastCall((void*)BaseVUmicroCPU::ExecuteBlockJIT, arg1reg);
-		_cop2RestoreRegs();
-		skip.SetTarget();
-		skipvuidle.SetTarget();
+		COP2_SyncVU0(8);
 	}
 
 	_flushEEreg(_Rt_);
@@ -532,18 +541,7 @@ static void recQMFC2()
 		xADD(eax, scaleblockcycles_clear());
 		xMOV(ptr32[&cpuRegs.cycle], eax); // update cycles
 
-		xTEST(ptr32[&VU0.VI[REG_VPU_STAT].UL], 0x1);
-		xForwardJZ32 skipvuidle;
-		xSUB(eax, ptr32[&VU0.cycle]);
-		xSUB(eax, ptr32[&VU0.nextBlockCycles]);
-		xCMP(eax, EmuConfig.Gamefixes.VUKickstartHack ? 8 : 0);
-		xForwardJL32 skip;
-		_cop2BackupRegs();
-		xLoadFarAddr(arg1reg, CpuVU0);
-		xFastCall((void*)BaseVUmicroCPU::ExecuteBlockJIT, arg1reg);
-		_cop2RestoreRegs();
-		skip.SetTarget();
-		skipvuidle.SetTarget();
+		COP2_SyncVU0(8);
 	}
 
 	int rtreg = _allocGPRtoXMMreg(-1, _Rt_, MODE_WRITE);
@@ -572,18 +570,7 @@ static void recQMTC2()
 		xADD(eax, scaleblockcycles_clear());
 		xMOV(ptr32[&cpuRegs.cycle], eax); // update cycles
 
-		xTEST(ptr32[&VU0.VI[REG_VPU_STAT].UL], 0x1);
-		xForwardJZ32 skipvuidle;
-		xSUB(eax, ptr32[&VU0.cycle]);
-		xSUB(eax, ptr32[&VU0.nextBlockCycles]);
-		xCMP(eax, EmuConfig.Gamefixes.VUKickstartHack ? 8 : 0);
-		xForwardJL32 skip;
-		_cop2BackupRegs();
-		xLoadFarAddr(arg1reg, CpuVU0);
-		xFastCall((void*)BaseVUmicroCPU::ExecuteBlockJIT, arg1reg);
-		_cop2RestoreRegs();
-		skip.SetTarget();
-		skipvuidle.SetTarget();
+		COP2_SyncVU0(8);
 	}
 
 	int rtreg = _allocGPRtoXMMreg(-1, _Rt_, MODE_READ);
@@ -675,4 +662,11 @@ void recCOP2_SPEC1()
 	recCOP2SPECIAL1t[_Funct_]();
 
 }
-void recCOP2_SPEC2() { recCOP2SPECIAL2t[(cpuRegs.code & 3) | ((cpuRegs.code >> 4) & 0x7c)](); }
+void recCOP2_SPEC2()
+{
+	// VU0 doesn't run alongside these on the EE thread, on its own thread it may
+	if (THREAD_VU0)
+		COP2_SyncVU0(0);
+
+	recCOP2SPECIAL2t[(cpuRegs.code & 3) | ((cpuRegs.code >> 4) & 0x7c)]();
+}
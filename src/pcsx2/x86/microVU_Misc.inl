@@ -217,16 +217,20 @@ static void __fc mVUwarningRegAccess(u32 prog, u32 pc)
 	Console.Error("microVU0 Warning: Accessing VU1 Regs! [%04x] [%x]", pc, prog);
 }
 
+template <int vuIndex>
 static void __fc mVUTBit()
 {
-	u32 old = vu1Thread.mtvuInterrupts.fetch_or(VU_Thread::InterruptFlagVUTBit, std::memory_order_release);
+	VU_Thread& vuThread = vuIndex ? vu1Thread : vu0Thread;
+	u32 old = vuThread.mtvuInterrupts.fetch_or(VU_Thread::InterruptFlagVUTBit, std::memory_order_release);
 	if (old & VU_Thread::InterruptFlagVUTBit)
 		DevCon.Warning("Old TBit not registered");
 }
 
+template <int vuIndex>
 static void __fc mVUEBit()
 {
-	vu1Thread.mtvuInterrupts.fetch_or(VU_Thread::InterruptFlagVUEBit, std::memory_order_release);
+	VU_Thread& vuThread = vuIndex ? vu1Thread : vu0Thread;
+	vuThread.mtvuInterrupts.fetch_or(VU_Thread::InterruptFlagVUEBit, std::memory_order_release);
 }
 
 static inline u32 branchAddrN(const mV)
@@ -337,13 +341,20 @@ void MIN_MAX_PS(microVU& mVU, const xmm& to, const xmm& from, const xmm& t1in, c
 		const xmm& c1 = min ? t2 : t1;
 		const xmm& c2 = min ? t1 : t2;
 
-		xMOVAPS  (t1, to);
-		xPSRA.D  (t1, 31);
+		if (x86caps.hasAVX)
+		{
+			xVPSRAD  (t1, to, 31);
+			xVPSRAD  (t2, from, 31);
+		}
+		else
+		{
+			xMOVAPS  (t1, to);
+			xPSRA.D  (t1, 31);
+			xMOVAPS  (t2, from);
+			xPSRA.D  (t2, 31);
+		}
 		xPSRL.D  (t1,  1);
 		xPXOR    (t1, to);
-
-		xMOVAPS  (t2, from);
-		xPSRA.D  (t2, 31);
 		xPSRL.D  (t2,  1);
 		xPXOR    (t2, from);
 
@@ -530,6 +541,19 @@ void SSE_DIVSS(mV, const xmm& to, const xmm& from, const xmm& t1 = xEmptyReg, co
 	clampOp(xDIV.SS, false);
 }
 
+// to = from with its lower vector multiplied by a constant, AVX does it without the copy
+static __fi void mVUmulSSconst(const xmm& to, const xmm& from, const xIndirectVoid& mem)
+{
+	if (x86caps.hasAVX)
+		xVMUL.SS(to, from, mem);
+	else
+	{
+		if (to != from)
+			xMOVAPS(to, from);
+		xMUL.SS(to, mem);
+	}
+}
+
 //------------------------------------------------------------------
 // Micro VU - Custom Quick Search
 //------------------------------------------------------------------
@@ -92,8 +92,13 @@ static void mVUupdateFlags(mV, const xmm& reg, const xmm& regT1in = xEmptyReg, c
 	if (sFLAG.doFlag && CHECK_VUOVERFLOWHACK)
 	{
 		//Calculate overflow
-		xMOVAPS(regT1, regT2);
-		xAND.PS(regT1, ptr128[&sse4_compvals[1][0]]); // Remove sign flags (we don't care)
+		if (x86caps.hasAVX)
+			xVAND.PS(regT1, regT2, ptr128[&sse4_compvals[1][0]]); // Remove sign flags (we don't care)
+		else
+		{
+			xMOVAPS(regT1, regT2);
+			xAND.PS(regT1, ptr128[&sse4_compvals[1][0]]); // Remove sign flags (we don't care)
+		}
 		xCMPNLT.PS(regT1, ptr128[&sse4_compvals[0][0]]); // Compare if T1 == FLT_MAX
 		xMOVMSKPS(gprT2, regT1); // Grab sign bits  for equal results
 		xAND(gprT2, AND_XYZW); // Grab "Is FLT_MAX" bits from the previous calculation
@@ -499,14 +504,24 @@ static void mVU_FTOIx(mP, const float* addr, microOpcode opEnum)
 		const xmm& t2 = mVU.regAlloc->allocReg();
 
 		// Note: For help understanding this algorithm see recVUMI_FTOI_Saturate()
-		xMOVAPS(t1, Fs);
+		if (x86caps.hasAVX)
+			xVPXOR(t1, Fs, ptr128[mVUglob.signbit]);
+		else
+		{
+			xMOVAPS(t1, Fs);
+			xPXOR(t1, ptr128[mVUglob.signbit]);
+		}
 		if (addr)
 			xMUL.PS(Fs, ptr128[addr]);
 		xCVTTPS2DQ(Fs, Fs);
-		xPXOR(t1, ptr128[mVUglob.signbit]);
 		xPSRA.D(t1, 31);
-		xMOVAPS(t2, Fs);
-		xPCMP.EQD(t2, ptr128[mVUglob.signbit]);
+		if (x86caps.hasAVX)
+			xVPCMP.EQD(t2, Fs, ptr128[mVUglob.signbit]);
+		else
+		{
+			xMOVAPS(t2, Fs);
+			xPCMP.EQD(t2, ptr128[mVUglob.signbit]);
+		}
 		xAND.PS(t1, t2);
 		xPADD.D(Fs, t1);
 
@@ -128,6 +128,8 @@ _vifT int nVifUnpack(const u8 *data)
         }
 
         if (!idx || !THREAD_VU1) {
+            if (!idx)    // VIF0 may unpack under a running VU0 program
+                vu0Sync();
             if (newVifDynaRec)
                 dVifUnpack<idx>(data, isFill);
             else